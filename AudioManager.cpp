@@ -1,10 +1,41 @@
 #include "AudioManager.h"
-#include <mmsystem.h>
+#include "MemoryStats.h"
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <thread>
+#include <chrono>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
 #pragma comment(lib, "winmm.lib")
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    // һMCIɹtruereplyǿʱдصı
+    // Windowsƽֻ̨޽ģͻ׼ûMCIһʧܣ൱ھ
+    bool sendCommand(const std::string& command, char* reply = nullptr, unsigned int replySize = 0) {
+#ifdef _WIN32
+        return mciSendStringA(command.c_str(), reply, replySize, nullptr) == 0;
+#else
+        (void)command;
+        if (reply && replySize > 0) reply[0] = '\0';
+        return false;
+#endif
+    }
+
+    // ϵͳʾƵļ򲻿ʱĺ󱸣
+    void playSystemSound(const wchar_t* alias) {
+#ifdef _WIN32
+        PlaySoundW(alias, NULL, SND_ALIAS | SND_ASYNC);
+#else
+        (void)alias;
+#endif
+    }
+}
 
 AudioManager* AudioManager::instance = nullptr;
 
@@ -38,9 +69,14 @@ std::string AudioManager::getAudioType(const std::string& filepath) {
 }
 
 bool AudioManager::fileExists(const std::string& filepath) {
+#ifdef _WIN32
     DWORD attributes = GetFileAttributesA(filepath.c_str());
     return (attributes != INVALID_FILE_ATTRIBUTES &&
         !(attributes & FILE_ATTRIBUTE_DIRECTORY));
+#else
+    struct stat info;
+    return stat(filepath.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+#endif
 }
 
 std::string AudioManager::findAudioFile(const std::string& basePath) {
@@ -96,6 +132,7 @@ std::string AudioManager::getSoundAlias(SoundType type) {
 }
 
 void AudioManager::initialize() {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
     cleanup();
     // ʼ
@@ -109,7 +146,7 @@ void AudioManager::cleanup() {
     // Ƶ
     for (auto& pair : soundAliases) {
         std::string command = "close " + pair.second;
-        mciSendStringA(command.c_str(), nullptr, 0, nullptr);
+        sendCommand(command);
     }
 
     soundAliases.clear();
@@ -129,6 +166,7 @@ void AudioManager::setSFXVolume(float volume) {
 }
 
 void AudioManager::playSound(SoundType type, bool loop) {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
 
     auto it = soundPaths.find(type);
@@ -136,40 +174,40 @@ void AudioManager::playSound(SoundType type, bool loop) {
         // ʹϵͳЧΪ
         switch (type) {
         case SoundType::JUMP:
-            PlaySound(TEXT("SystemHand"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemHand");
             break;
         case SoundType::LAND:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::COIN_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::ITEM_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::OBSTACLE_HIT:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::DAMAGE_SOUND:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::BUTTON_CLICK:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::GAME_OVER:
-            PlaySound(TEXT("SystemCriticalStop"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemCriticalStop");
             break;
         case SoundType::COMBO_SOUND:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::INVINCIBILITY:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::SHIELD_ACTIVATE:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::BUTTON_HOVER:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         default:
             break;
@@ -185,40 +223,40 @@ void AudioManager::playSound(SoundType type, bool loop) {
         // ļڣʹϵͳЧ
         switch (type) {
         case SoundType::JUMP:
-            PlaySound(TEXT("SystemHand"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemHand");
             break;
         case SoundType::LAND:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::COIN_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::ITEM_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::OBSTACLE_HIT:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::DAMAGE_SOUND:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::BUTTON_CLICK:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::GAME_OVER:
-            PlaySound(TEXT("SystemCriticalStop"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemCriticalStop");
             break;
         case SoundType::COMBO_SOUND:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::INVINCIBILITY:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::SHIELD_ACTIVATE:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::BUTTON_HOVER:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         default:
             break;
@@ -234,15 +272,13 @@ void AudioManager::playSound(SoundType type, bool loop) {
     // ޸ֶ֧Ƶʽ
     std::string audioType = getAudioType(filepath);
     std::string openCommand = "open \"" + filepath + "\" type " + audioType + " alias " + alias;
-    MCIERROR result = mciSendStringA(openCommand.c_str(), nullptr, 0, nullptr);
-
-    if (result == 0) {
+    if (sendCommand(openCommand)) {
         soundAliases[type] = alias;
 
         // 
         int volume = static_cast<int>(masterVolume * sfxVolume * 1000);
         std::string volumeCommand = "setaudio " + alias + " volume to " + std::to_string(volume);
-        mciSendStringA(volumeCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(volumeCommand);
 
         // Ƶ
         std::string playCommand = "play " + alias;
@@ -250,8 +286,7 @@ void AudioManager::playSound(SoundType type, bool loop) {
             playCommand += " repeat";
         }
 
-        result = mciSendStringA(playCommand.c_str(), nullptr, 0, nullptr);
-        if (result == 0) {
+        if (sendCommand(playCommand)) {
             activeSounds.push_back(alias);
         }
     }
@@ -259,40 +294,40 @@ void AudioManager::playSound(SoundType type, bool loop) {
         // MCIʧܣ˵ϵͳЧ
         switch (type) {
         case SoundType::JUMP:
-            PlaySound(TEXT("SystemHand"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemHand");
             break;
         case SoundType::LAND:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::COIN_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::ITEM_COLLECT:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::OBSTACLE_HIT:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::DAMAGE_SOUND:
-            PlaySound(TEXT("SystemExclamation"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemExclamation");
             break;
         case SoundType::BUTTON_CLICK:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         case SoundType::GAME_OVER:
-            PlaySound(TEXT("SystemCriticalStop"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemCriticalStop");
             break;
         case SoundType::COMBO_SOUND:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::INVINCIBILITY:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::SHIELD_ACTIVATE:
-            PlaySound(TEXT("SystemNotification"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemNotification");
             break;
         case SoundType::BUTTON_HOVER:
-            PlaySound(TEXT("SystemDefault"), NULL, SND_ALIAS | SND_ASYNC);
+            playSystemSound(L"SystemDefault");
             break;
         default:
             break;
@@ -301,6 +336,7 @@ void AudioManager::playSound(SoundType type, bool loop) {
 }
 
 void AudioManager::playBackgroundMusic(SoundType type, bool loop) {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
 
     // ֹͣǰ
@@ -312,6 +348,7 @@ void AudioManager::playBackgroundMusic(SoundType type, bool loop) {
 }
 
 void AudioManager::stopSound(SoundType type) {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
 
     auto it = soundAliases.find(type);
@@ -319,10 +356,10 @@ void AudioManager::stopSound(SoundType type) {
         std::string alias = it->second;
 
         std::string stopCommand = "stop " + alias;
-        mciSendStringA(stopCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(stopCommand);
 
         std::string closeCommand = "close " + alias;
-        mciSendStringA(closeCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(closeCommand);
 
         auto activeIt = std::find(activeSounds.begin(), activeSounds.end(), alias);
         if (activeIt != activeSounds.end()) {
@@ -338,6 +375,7 @@ void AudioManager::stopSound(SoundType type) {
 }
 
 void AudioManager::stopBackgroundMusic() {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
 
     if (backgroundMusicPlaying) {
@@ -347,15 +385,16 @@ void AudioManager::stopBackgroundMusic() {
 }
 
 void AudioManager::stopAllSounds() {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return;
 
     for (auto& pair : soundAliases) {
         std::string alias = pair.second;
         std::string stopCommand = "stop " + alias;
-        mciSendStringA(stopCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(stopCommand);
 
         std::string closeCommand = "close " + alias;
-        mciSendStringA(closeCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(closeCommand);
     }
 
     soundAliases.clear();
@@ -364,6 +403,7 @@ void AudioManager::stopAllSounds() {
 }
 
 bool AudioManager::isPlaying(SoundType type) {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled) return false;
 
     auto it = soundAliases.find(type);
@@ -371,9 +411,7 @@ bool AudioManager::isPlaying(SoundType type) {
         std::string alias = it->second;
         char buffer[256];
         std::string statusCommand = "status " + alias + " mode";
-        MCIERROR result = mciSendStringA(statusCommand.c_str(), buffer, sizeof(buffer), nullptr);
-
-        if (result == 0) {
+        if (sendCommand(statusCommand, buffer, sizeof(buffer))) {
             std::string status(buffer);
             return status.find("playing") != std::string::npos;
         }
@@ -382,22 +420,24 @@ bool AudioManager::isPlaying(SoundType type) {
 }
 
 void AudioManager::pauseBackgroundMusic() {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled || !backgroundMusicPlaying) return;
 
     auto it = soundAliases.find(currentBackgroundMusic);
     if (it != soundAliases.end()) {
         std::string pauseCommand = "pause " + it->second;
-        mciSendStringA(pauseCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(pauseCommand);
     }
 }
 
 void AudioManager::resumeBackgroundMusic() {
+    MemoryScope memoryScope(MEM_AUDIO);
     if (!audioEnabled || !backgroundMusicPlaying) return;
 
     auto it = soundAliases.find(currentBackgroundMusic);
     if (it != soundAliases.end()) {
         std::string resumeCommand = "resume " + it->second;
-        mciSendStringA(resumeCommand.c_str(), nullptr, 0, nullptr);
+        sendCommand(resumeCommand);
     }
 }
 
@@ -416,11 +456,9 @@ void AudioManager::cleanupFinishedSounds() {
     for (auto it = activeSounds.begin(); it != activeSounds.end();) {
         char buffer[256];
         std::string statusCommand = "status " + *it + " mode";
-        MCIERROR result = mciSendStringA(statusCommand.c_str(), buffer, sizeof(buffer), nullptr);
-
-        if (result != 0 || std::string(buffer).find("stopped") != std::string::npos) {
+        if (!sendCommand(statusCommand, buffer, sizeof(buffer)) || std::string(buffer).find("stopped") != std::string::npos) {
             std::string closeCommand = "close " + *it;
-            mciSendStringA(closeCommand.c_str(), nullptr, 0, nullptr);
+            sendCommand(closeCommand);
             it = activeSounds.erase(it);
         }
         else {
@@ -437,7 +475,7 @@ void AudioManager::onGameStart() {
 void AudioManager::onGameOver() {
     if (!audioEnabled) return;
     playSound(SoundType::GAME_OVER, false);
-    Sleep(1000);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
     stopBackgroundMusic();
 }
 
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string>
+
+// 二进制文件读写的公共工具：整数一律按小端序，与机器字节序无关
+namespace BinaryIO {
+
+    inline void putU8(std::vector<std::uint8_t>& out, std::uint8_t value) {
+        out.push_back(value);
+    }
+
+    inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out.push_back((std::uint8_t)(value >> (i * 8)));
+        }
+    }
+
+    inline void putU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        putU32(out, (std::uint32_t)(value & 0xFFFFFFFFu));
+        putU32(out, (std::uint32_t)(value >> 32));
+    }
+
+    inline void putF32(std::vector<std::uint8_t>& out, float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(out, bits);
+    }
+
+    // 定长字符串字段，超长截断，不足补零
+    inline void putFixedString(std::vector<std::uint8_t>& out, const std::string& value, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            out.push_back(i < value.size() ? (std::uint8_t)value[i] : 0);
+        }
+    }
+
+    inline std::uint32_t getU32(const std::uint8_t* in) {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= (std::uint32_t)in[i] << (i * 8);
+        }
+        return value;
+    }
+
+    // 带边界检查的顺序读取；越界后所有读取返回0，good()变为false
+    class Reader {
+    private:
+        const std::uint8_t* cursor;
+        const std::uint8_t* end;
+        bool ok;
+
+        bool require(size_t size) {
+            if (!ok || (size_t)(end - cursor) < size) {
+                ok = false;
+                return false;
+            }
+            return true;
+        }
+
+    public:
+        Reader(const std::uint8_t* data, size_t size) : cursor(data), end(data + size), ok(true) {}
+
+        std::uint8_t u8() {
+            if (!require(1)) return 0;
+            return *cursor++;
+        }
+
+        std::uint32_t u32() {
+            if (!require(4)) return 0;
+            std::uint32_t value = getU32(cursor);
+            cursor += 4;
+            return value;
+        }
+
+        std::uint64_t u64() {
+            std::uint64_t low = u32();
+            std::uint64_t high = u32();
+            return low | (high << 32);
+        }
+
+        float f32() {
+            std::uint32_t bits = u32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        std::string fixedString(size_t length) {
+            if (!require(length)) return std::string();
+            std::string value((const char*)cursor, length);
+            cursor += length;
+            return value.substr(0, value.find('\0'));
+        }
+
+        bool good() const { return ok; }
+        size_t remaining() const { return ok ? (size_t)(end - cursor) : 0; }
+    };
+
+    // CRC-32（IEEE 802.3多项式），用于检测写到一半的记录和损坏的文件
+    inline std::uint32_t crc32(const std::uint8_t* data, size_t size) {
+        static const struct Table {
+            std::uint32_t entries[256];
+            Table() {
+                for (std::uint32_t i = 0; i < 256; i++) {
+                    std::uint32_t crc = i;
+                    for (int bit = 0; bit < 8; bit++) {
+                        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                    }
+                    entries[i] = crc;
+                }
+            }
+        } table;
+
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; i++) {
+            crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+}
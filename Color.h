@@ -0,0 +1,16 @@
+#pragma once
+
+// 颜色类型：Windows上直接使用Win32的COLORREF和RGB宏；
+// 其他平台只编译无界面的模拟和基准，按相同的0x00BBGGRR布局给出定义，颜色计算结果一致
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+typedef std::uint32_t COLORREF;
+
+#define RGB(r, g, b) ((COLORREF)(((std::uint8_t)(r)) | ((COLORREF)((std::uint8_t)(g)) << 8) | ((COLORREF)((std::uint8_t)(b)) << 16)))
+#define GetRValue(rgb) ((std::uint8_t)(rgb))
+#define GetGValue(rgb) ((std::uint8_t)((rgb) >> 8))
+#define GetBValue(rgb) ((std::uint8_t)((rgb) >> 16))
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+#include "Ecs.h"
+#include "Platform.h"
+#include "GameClock.h"
+
+// 世界实体（平台、障碍物、金币、道具）的组件，全部为POD，由World中的系统读写。
+// 往返、旋转、浮动等固定的运动只记录出发时的世界时间（World::getTime），用到时再按经过的时间求值，
+// 不逐帧积分：屏幕外的实体每帧没有开销，回滚快照中这些组件也不会变化
+
+// 位置：平台和障碍物为左上角，金币和道具为中心点；移动平台的x为出发位置，当前位置用World::getPosition求值
+struct Transform {
+    float x, y;
+};
+
+// 碰撞/绘制尺寸
+struct Bounds {
+    float width, height;
+};
+
+// 水平往返（移动平台）：从startX出发先向maxX移动，在[minX, maxX]间以speed往返，x为经过时间的三角波
+struct PingPong {
+    float minX, maxX;
+    float startX;
+    float speed;
+    double startTime;
+};
+
+// 标记：随世界上升一起下移
+struct Scroll {
+};
+
+// 动画：动画时间为当前世界时间减startTime
+struct Animation {
+    double startTime;
+    float bobAmplitude;     // 上下浮动幅度（金币），0表示不浮动
+};
+
+// 可被磁场吸引（金币）
+struct Magnet {
+    float speed;
+    bool attracted;
+};
+
+// 平台状态
+struct PlatformState {
+    PlatformType type;
+    bool broken;
+    TimerHandle respawnTimer;   // 破碎后登记的重生定时
+    int hitCount;
+    float springCompression;
+    bool springTriggered;
+    Entity item;            // 平台上的道具实体，没有时为NULL_ENTITY
+};
+
+// 障碍物：每种类型一个组件池，组件只保存生成时的状态，
+// 尺寸、伤害、速度等固定参数和运动规则在World.cpp的ObstacleTraits中按类型特化。
+// 障碍物实体只有这一个组件，不进入Transform、Scroll等通用池，各系统按类型分别遍历
+template <ObstacleType Type>
+struct Obstacle {
+    float x, y;             // 生成时的左上角，y随世界下移；当前位置由此按经过的时间求值
+    double startTime;       // 生成时的世界时间
+    TimerHandle expiry;     // 寿命到期的定时
+};
+
+// 落石：初速度随机，加速下落
+template <>
+struct Obstacle<FALLING_ROCK> {
+    float x, y;
+    double startTime;
+    float vy;               // 初速度
+    TimerHandle expiry;
+};
+
+// 金币状态
+struct CoinState {
+    int value;
+};
+
+// 道具状态（位置和动画在Transform、Animation中）
+struct ItemState {
+    ItemType type;
+    float effectDuration;
+    float effectStrength;
+    int value;
+};
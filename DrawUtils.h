@@ -0,0 +1,42 @@
+#pragma once
+#include "Theme.h"
+#include <graphics.h>
+
+// 绘制工具类 - 支持圆角和柔和效果
+namespace DrawUtils {
+    // 基础绘制函数
+    void drawRoundedRect(int x, int y, int width, int height, int radius, COLORREF fillColor, COLORREF borderColor = (COLORREF)-1);
+    void drawGradientRoundedRect(int x, int y, int width, int height, int radius, COLORREF startColor, COLORREF endColor);
+    void drawSoftShadowRect(int x, int y, int width, int height, int radius, COLORREF fillColor, int shadowOffset = 2);
+    void drawSoftCircle(int centerX, int centerY, int radius, COLORREF fillColor, COLORREF borderColor = (COLORREF)-1);
+    void drawSoftEllipse(int x, int y, int width, int height, COLORREF fillColor, COLORREF borderColor = (COLORREF)-1);
+
+    // 特效绘制函数
+    void drawGlowCircle(int centerX, int centerY, int radius, COLORREF glowColor, float intensity = 1.0f);
+    void drawGlowRect(int x, int y, int width, int height, COLORREF glowColor, float intensity = 1.0f);
+    void drawPulsingCircle(int centerX, int centerY, int baseRadius, float pulseAmount, float time, COLORREF color);
+
+    // 粒子绘制函数
+    void drawParticle(float x, float y, float size, COLORREF color, float alpha = 1.0f);
+    void drawSparkle(float x, float y, float size, COLORREF color, float rotation = 0.0f);
+
+    // 连击效果绘制
+    void drawComboText(int x, int y, int combo, COLORREF color);
+
+    // 道具效果绘制
+    void drawSpeedEffect(float x, float y, float width, float height, float intensity = 1.0f);
+    void drawShieldEffect(float x, float y, float radius, float intensity = 1.0f);
+    void drawItemGlow(float x, float y, float size, COLORREF glowColor, float time);
+
+    // 平台特效绘制
+    void drawSpringCompression(float x, float y, float width, float height, float compression);
+    void drawBreakEffect(float x, float y, float width, float height, float breakProgress);
+
+    // 预警系统绘制
+    void drawPlatformPreview(float x, float y, float width, float height, COLORREF previewColor, float alpha = 0.3f);
+    void drawDangerZone(float y, float intensity = 1.0f);
+
+    // 透明度绘制函数
+    void drawTransparentRect(int x, int y, int width, int height, COLORREF color, float alpha);
+    void drawPolygonGlow(POINT* points, int count, COLORREF glowColor, float intensity);
+}
@@ -0,0 +1,355 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// 实体句柄：低20位为索引，高12位为版本号
+// 实体销毁后索引会被复用，版本号递增，旧句柄随之失效
+using Entity = std::uint32_t;
+const Entity NULL_ENTITY = 0xFFFFFFFFu;
+
+const std::uint32_t ENTITY_INDEX_BITS = 20;
+const std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+
+inline std::uint32_t entityIndex(Entity entity) { return entity & ENTITY_INDEX_MASK; }
+inline std::uint32_t entityVersion(Entity entity) { return entity >> ENTITY_INDEX_BITS; }
+
+// 组件池sparse数组中表示"该实体没有此组件"
+const std::uint32_t ABSENT_SLOT = 0xFFFFFFFFu;
+
+// 组件池的类型擦除基类，Registry销毁实体时通过它移除各类组件
+// 快照按池做增量：每次可写访问把池标记为已修改，取快照时已修改的池分配新的内容版本号；
+// 版本号全局唯一，版本号相同的两个池内容一定相同，快照之间可以直接共享
+class ComponentPoolBase {
+private:
+    static std::uint64_t nextRevision() {
+        static std::atomic<std::uint64_t> counter(0);
+        return ++counter;
+    }
+
+protected:
+    bool dirty;
+    std::uint64_t revision;
+
+public:
+    ComponentPoolBase() : dirty(true), revision(0) {}
+    virtual ~ComponentPoolBase() = default;
+    virtual void remove(Entity entity) = 0;
+    virtual void clear() = 0;
+
+    // 深拷贝：copyFrom要求other是同一组件类型的池，复用已有容量，复制后内容版本与other相同
+    virtual std::unique_ptr<ComponentPoolBase> clone() const = 0;
+    virtual void copyFrom(const ComponentPoolBase& other) = 0;
+
+    // 当前内容的版本号：上次取版本号之后被修改过时分配新的
+    std::uint64_t commitRevision() {
+        if (dirty) {
+            revision = nextRevision();
+            dirty = false;
+        }
+        return revision;
+    }
+
+    // 未修改且版本号相同时内容一定相同，恢复快照可以跳过
+    bool matches(std::uint64_t snapshotRevision) const { return !dirty && revision == snapshotRevision; }
+};
+
+// 稀疏集合组件池：组件按插入顺序紧密存放，系统遍历的是连续内存
+// sparse按实体索引查找组件在dense数组中的位置，增删查均为O(1)，删除时用末尾元素填补空位
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+    static_assert(std::is_trivially_copyable<T>::value, "components must be POD: snapshots copy pools as raw memory");
+
+private:
+    std::vector<std::uint32_t> sparse;
+    std::vector<Entity> entities;
+    std::vector<T> components;
+
+public:
+    bool has(Entity entity) const {
+        std::uint32_t index = entityIndex(entity);
+        return index < sparse.size() && sparse[index] != ABSENT_SLOT && entities[sparse[index]] == entity;
+    }
+
+    T& get(Entity entity) {
+        dirty = true;
+        return components[sparse[entityIndex(entity)]];
+    }
+    const T& get(Entity entity) const { return components[sparse[entityIndex(entity)]]; }
+
+    T* tryGet(Entity entity) { return has(entity) ? &get(entity) : nullptr; }
+    const T* tryGet(Entity entity) const { return has(entity) ? &get(entity) : nullptr; }
+
+    T& add(Entity entity, const T& component) {
+        dirty = true;
+        if (has(entity)) {
+            return get(entity) = component;
+        }
+
+        std::uint32_t index = entityIndex(entity);
+        if (index >= sparse.size()) {
+            sparse.resize(index + 1, ABSENT_SLOT);
+        }
+        sparse[index] = (std::uint32_t)entities.size();
+        entities.push_back(entity);
+        components.push_back(component);
+        return components.back();
+    }
+
+    void remove(Entity entity) override {
+        if (!has(entity)) return;
+
+        dirty = true;
+        std::uint32_t slot = sparse[entityIndex(entity)];
+        std::uint32_t last = (std::uint32_t)entities.size() - 1;
+        if (slot != last) {
+            entities[slot] = entities[last];
+            components[slot] = std::move(components[last]);
+            sparse[entityIndex(entities[slot])] = slot;
+        }
+        entities.pop_back();
+        components.pop_back();
+        sparse[entityIndex(entity)] = ABSENT_SLOT;
+    }
+
+    // 预留count个组件的容量，实体索引小于count时sparse也不再扩容
+    void reserve(size_t count) {
+        sparse.reserve(count);
+        entities.reserve(count);
+        components.reserve(count);
+    }
+
+    void clear() override {
+        dirty = true;
+        sparse.clear();
+        entities.clear();
+        components.clear();
+    }
+
+    std::unique_ptr<ComponentPoolBase> clone() const override {
+        return std::unique_ptr<ComponentPoolBase>(new ComponentPool<T>(*this));
+    }
+
+    void copyFrom(const ComponentPoolBase& other) override {
+        const ComponentPool<T>& source = static_cast<const ComponentPool<T>&>(other);
+        sparse = source.sparse;
+        entities = source.entities;
+        components = source.components;
+        dirty = source.dirty;
+        revision = source.revision;
+    }
+
+    // 按dense下标遍历：for (size_t i = 0; i < pool.size(); i++) { pool.entityAt(i); pool.at(i); }
+    size_t size() const { return entities.size(); }
+    Entity entityAt(size_t i) const { return entities[i]; }
+    T& at(size_t i) {
+        dirty = true;
+        return components[i];
+    }
+    const T& at(size_t i) const { return components[i]; }
+
+    // 并行系统：分段之前取一次data()标记已修改，各段再按下标直接读写，
+    // 不逐次写dirty（多个线程同时写同一个标志是数据竞争）
+    T* data() {
+        dirty = true;
+        return components.data();
+    }
+    const T* data() const { return components.data(); }
+    // 组件在dense数组中的下标，entity必须拥有此组件
+    std::uint32_t indexOf(Entity entity) const { return sparse[entityIndex(entity)]; }
+};
+
+// 注册表快照：组件池按版本号与其他快照共享，内容未变的池不复制
+struct RegistrySnapshot {
+    std::vector<std::uint32_t> versions;
+    std::vector<std::uint32_t> freeIndices;
+    size_t aliveCount = 0;
+    std::vector<std::shared_ptr<ComponentPoolBase>> pools;     // 取快照后不再修改
+    std::vector<std::uint64_t> revisions;
+};
+
+// 实体注册表：分配实体句柄，按组件类型管理各个组件池
+class Registry {
+private:
+    std::vector<std::uint32_t> versions;        // 按索引记录当前版本
+    std::vector<std::uint32_t> freeIndices;
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools;
+    size_t aliveCount;
+
+    static size_t nextTypeId() {
+        static std::atomic<size_t> counter(0);
+        return counter++;
+    }
+
+    // 每种组件类型分配一个固定编号，用作pools下标
+    template <typename T>
+    static size_t typeId() {
+        static const size_t id = nextTypeId();
+        return id;
+    }
+
+public:
+    Registry() : aliveCount(0) {}
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    Entity create() {
+        std::uint32_t index;
+        if (!freeIndices.empty()) {
+            index = freeIndices.back();
+            freeIndices.pop_back();
+        }
+        else {
+            index = (std::uint32_t)versions.size();
+            versions.push_back(0);
+        }
+        aliveCount++;
+        return (versions[index] << ENTITY_INDEX_BITS) | index;
+    }
+
+    bool valid(Entity entity) const {
+        std::uint32_t index = entityIndex(entity);
+        return entity != NULL_ENTITY && index < versions.size() && versions[index] == entityVersion(entity);
+    }
+
+    void destroy(Entity entity) {
+        if (!valid(entity)) return;
+
+        for (auto& pool : pools) {
+            if (pool) pool->remove(entity);
+        }
+
+        std::uint32_t index = entityIndex(entity);
+        versions[index] = (versions[index] + 1) & (0xFFFFFFFFu >> ENTITY_INDEX_BITS);
+        freeIndices.push_back(index);
+        aliveCount--;
+    }
+
+    void clear() {
+        for (auto& pool : pools) {
+            if (pool) pool->clear();
+        }
+        // 版本号保留，清空前的句柄继续失效
+        freeIndices.clear();
+        for (std::uint32_t i = (std::uint32_t)versions.size(); i > 0; i--) {
+            versions[i - 1] = (versions[i - 1] + 1) & (0xFFFFFFFFu >> ENTITY_INDEX_BITS);
+            freeIndices.push_back(i - 1);
+        }
+        aliveCount = 0;
+    }
+
+    size_t alive() const { return aliveCount; }
+
+    // 预留count个实体句柄的容量；组件池的容量按类型用reserve<T>预留
+    void reserveEntities(size_t count) {
+        versions.reserve(count);
+        freeIndices.reserve(count);
+    }
+
+    // 保存到快照（句柄保持不变）。每个池依次尝试：out中已有的同版本副本、base中的同版本副本（共享）、
+    // 复制到out独占的旧副本（复用容量），最后才新建副本；base通常是上一次保存的快照
+    void save(RegistrySnapshot& out, const RegistrySnapshot* base = nullptr) {
+        out.versions = versions;
+        out.freeIndices = freeIndices;
+        out.aliveCount = aliveCount;
+        out.pools.resize(pools.size());
+        out.revisions.resize(pools.size(), 0);
+
+        for (size_t i = 0; i < pools.size(); i++) {
+            if (!pools[i]) {
+                out.pools[i].reset();
+                out.revisions[i] = 0;
+                continue;
+            }
+
+            std::uint64_t revision = pools[i]->commitRevision();
+            if (out.pools[i] && out.revisions[i] == revision) continue;
+
+            out.revisions[i] = revision;
+            if (base && i < base->pools.size() && base->pools[i] && base->revisions[i] == revision) {
+                out.pools[i] = base->pools[i];
+            }
+            else if (out.pools[i] && out.pools[i].use_count() == 1) {
+                out.pools[i]->copyFrom(*pools[i]);
+            }
+            else {
+                out.pools[i] = std::shared_ptr<ComponentPoolBase>(pools[i]->clone());
+            }
+        }
+    }
+
+    // 从快照恢复，只复制版本与快照不同的池；组件类型编号全局统一，同一下标即同一类型
+    void restore(const RegistrySnapshot& in) {
+        versions = in.versions;
+        freeIndices = in.freeIndices;
+        aliveCount = in.aliveCount;
+
+        if (pools.size() < in.pools.size()) {
+            pools.resize(in.pools.size());
+        }
+        for (size_t i = 0; i < pools.size(); i++) {
+            const ComponentPoolBase* source = i < in.pools.size() ? in.pools[i].get() : nullptr;
+            if (!source) {
+                if (pools[i]) pools[i]->clear();
+            }
+            else if (!pools[i]) {
+                pools[i] = source->clone();
+            }
+            else if (!pools[i]->matches(in.revisions[i])) {
+                pools[i]->copyFrom(*source);
+            }
+        }
+    }
+
+    template <typename T>
+    ComponentPool<T>& pool() {
+        size_t id = typeId<T>();
+        if (id >= pools.size()) {
+            pools.resize(id + 1);
+        }
+        if (!pools[id]) {
+            pools[id].reset(new ComponentPool<T>());
+        }
+        return static_cast<ComponentPool<T>&>(*pools[id]);
+    }
+
+    // 只读访问不创建组件池：尚未有过该类型组件时返回共享的空池，
+    // 并行系统只读时不会改动pools
+    template <typename T>
+    const ComponentPool<T>& pool() const {
+        size_t id = typeId<T>();
+        if (id >= pools.size() || !pools[id]) {
+            static const ComponentPool<T> empty;
+            return empty;
+        }
+        return static_cast<const ComponentPool<T>&>(*pools[id]);
+    }
+
+    template <typename T>
+    void reserve(size_t count) { pool<T>().reserve(count); }
+
+    template <typename T>
+    T& add(Entity entity, const T& component) { return pool<T>().add(entity, component); }
+
+    template <typename T>
+    T& get(Entity entity) { return pool<T>().get(entity); }
+
+    template <typename T>
+    const T& get(Entity entity) const { return pool<T>().get(entity); }
+
+    template <typename T>
+    T* tryGet(Entity entity) { return pool<T>().tryGet(entity); }
+
+    template <typename T>
+    const T* tryGet(Entity entity) const { return pool<T>().tryGet(entity); }
+
+    template <typename T>
+    bool has(Entity entity) const { return pool<T>().has(entity); }
+
+    template <typename T>
+    void remove(Entity entity) { pool<T>().remove(entity); }
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+// 补零的整数，如时间的秒数：text << minutes << L":" << padded(seconds, 2)
+struct PaddedNumber {
+    long long value;
+    int width;
+};
+
+inline PaddedNumber padded(long long value, int width) { return PaddedNumber{ value, width }; }
+
+// 不分配内存的宽字符串拼接：文字写在对象自身的定长缓冲中，超出容量的部分截断。
+// 每帧都要重新拼接的HUD、结算文字用它代替to_wstring和wstring相加
+template <size_t Capacity>
+class FixedText {
+private:
+    wchar_t buffer[Capacity];
+    size_t length;
+
+    void appendNumber(unsigned long long magnitude, bool negative, int width) {
+        wchar_t digits[24];
+        int count = 0;
+        do {
+            digits[count++] = (wchar_t)(L'0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        while (count < width && count < 20) {
+            digits[count++] = L'0';
+        }
+
+        if (negative) append(L'-');
+        while (count > 0) {
+            append(digits[--count]);
+        }
+    }
+
+    template <typename Integer>
+    void appendInteger(Integer value, int width) {
+        bool negative = value < 0;
+        // 先转成无符号再取负：最小的负数取负不会溢出
+        unsigned long long magnitude = (unsigned long long)value;
+        appendNumber(negative ? 0 - magnitude : magnitude, negative, width);
+    }
+
+public:
+    FixedText() : length(0) { buffer[0] = L'\0'; }
+
+    void clear() {
+        length = 0;
+        buffer[0] = L'\0';
+    }
+
+    const wchar_t* c_str() const { return buffer; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    FixedText& append(wchar_t character) {
+        if (length + 1 < Capacity) {
+            buffer[length++] = character;
+            buffer[length] = L'\0';
+        }
+        return *this;
+    }
+
+    FixedText& operator<<(const wchar_t* text) {
+        while (*text) append(*text++);
+        return *this;
+    }
+
+    FixedText& operator<<(wchar_t character) { return append(character); }
+
+    // 单字节文字（玩家名等ASCII字符串）逐字节扩展为宽字符
+    FixedText& operator<<(const char* text) {
+        while (*text) append((wchar_t)(unsigned char)*text++);
+        return *this;
+    }
+
+    template <typename Integer>
+    typename std::enable_if<std::is_integral<Integer>::value, FixedText&>::type operator<<(Integer value) {
+        appendInteger(value, 0);
+        return *this;
+    }
+
+    FixedText& operator<<(const PaddedNumber& number) {
+        appendInteger(number.value, number.width);
+        return *this;
+    }
+};
+
+// HUD和结算界面一行文字的长度
+typedef FixedText<128> HudText;
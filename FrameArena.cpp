@@ -0,0 +1,36 @@
+#include "FrameArena.h"
+#include <cstdint>
+
+FrameArena::FrameArena(size_t capacity)
+    : buffer(new unsigned char[capacity]), capacity(capacity), offset(0), overflowBytes(0), peak(0) {
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    size_t aligned = (size_t)(((base + offset + alignment - 1) & ~(std::uintptr_t)(alignment - 1)) - base);
+    if (aligned + size <= capacity) {
+        offset = aligned + size;
+        return buffer.get() + aligned;
+    }
+
+    // 主块不够：单独申请一块，多留出对齐的余量
+    overflow.emplace_back(new unsigned char[size + alignment]);
+    overflowBytes += size + alignment;
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>((address + alignment - 1) & ~(std::uintptr_t)(alignment - 1));
+}
+
+void FrameArena::reset() {
+    peak = getUsed();
+
+    if (!overflow.empty()) {
+        // 按本帧峰值再留一半余量，下一帧同样的用量不再溢出
+        overflow.clear();
+        capacity = peak + peak / 2;
+        buffer.reset(new unsigned char[capacity]);
+    }
+    offset = 0;
+    overflowBytes = 0;
+}
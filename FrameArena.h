@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// 逐帧线性分配器：帧内的临时数据从一整块内存中顺序切出，帧末reset一次性全部释放，
+// 分配只是移动偏移，释放什么也不做。帧内用量超过主块时临时向堆申请溢出块，
+// reset时按本帧峰值扩大主块，之后的帧不再访问全局堆
+class FrameArena {
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    size_t capacity;
+    size_t offset;
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;    // 本帧主块放不下的分配，帧末释放
+    size_t overflowBytes;
+    size_t peak;                // 最近一帧的用量（含溢出）
+
+public:
+    explicit FrameArena(size_t capacity = 64 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // alignment必须是2的幂
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // 帧末调用：之前分配的内存全部失效
+    void reset();
+
+    size_t getUsed() const { return offset + overflowBytes; }
+    size_t getCapacity() const { return capacity; }
+    size_t getPeak() const { return peak; }
+};
+
+// 从FrameArena分配的STL分配器：容器只能在当前帧内使用，reset之前必须已经销毁或不再访问。
+// deallocate不回收内存，容器扩容时旧的存储留到帧末，已知大小时先reserve
+template <typename T>
+class FrameAllocator {
+private:
+    template <typename U> friend class FrameAllocator;
+    FrameArena* arena;
+
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) : arena(&arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
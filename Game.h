@@ -0,0 +1,2101 @@
+#pragma once
+#include "Player.h"
+#include "Platform.h" 
+#include "Theme.h"
+#include "AudioManager.h"
+#include "JumpEnvelope.h"
+#include "SpscQueue.h"
+#include "World.h"
+#include "Input.h"
+#include "Ghost.h"
+#include "ScoreStore.h"
+#include "Random.h"
+#include "GameClock.h"
+#include "JobSystem.h"
+#include "FrameArena.h"
+#include "FixedText.h"
+#include "MemoryStats.h"
+#include "Smoothing.h"
+#include "RingQueue.h"
+#include <vector>
+#include <string>
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+const int WINDOW_WIDTH = 1200;
+const int WINDOW_HEIGHT = 800;
+
+enum GameState {
+    MENU,
+    HELP,
+    AUDIO_SETTINGS,
+    PLAYING,
+    PAUSED,
+    GAME_OVER
+};
+
+// 死亡原因
+enum DeathCause {
+    DEATH_NONE,
+    DEATH_FELL,         // 掉出死亡线
+    DEATH_OBSTACLE,     // 被障碍物耗尽生命
+    DEATH_TIMEOUT       // 批量模拟达到时长上限（非真实死亡）
+};
+
+// 平衡性参数：默认值即正式游戏使用的数值，批量模拟可逐项覆盖
+struct GameTuning {
+    // 平台类型累计概率阈值（百分比）：NORMAL、MOVING、BREAKABLE，剩余为SPRING
+    // 三档分别对应难度 <0.3、<0.7 和其余
+    int platformTypeThresholds[3][3] = {
+        { 70, 85, 95 },
+        { 50, 75, 90 },
+        { 35, 60, 85 }
+    };
+
+    // 障碍物生成间隔：首个障碍物使用initial，之后从max随难度线性降低drop，不低于min
+    float obstacleInitialSpawnRate = 5.0f;
+    float obstacleMaxSpawnInterval = 4.0f;
+    float obstacleMinSpawnInterval = 1.0f;
+    float obstacleSpawnIntervalDrop = 2.0f;
+
+    // 世界上升速度
+    float baseWorldSpeed = 20.0f;
+    float worldSpeedTimeGrowth = 0.3f;      // 每分钟增长比例
+    float worldSpeedScoreGrowth = 0.1f;     // 每500分增长比例
+    float maxWorldSpeed = 60.0f;
+};
+
+// 单局统计
+struct RunStats {
+    long long score;
+    long long maxHeight;
+    float survivalTime;
+    int coins;
+    int itemsCollected;
+    DeathCause deathCause;
+    ObstacleType killerObstacle;            // 仅当deathCause为DEATH_OBSTACLE时有效
+    int itemUsage[INVINCIBILITY + 1];       // 按ItemType统计的拾取次数
+};
+
+class BackgroundScrolling {
+private:
+    struct BackgroundLayer {
+        float y;
+        float speed;
+        COLORREF color;
+        int height;
+    };
+
+    vector<BackgroundLayer> layers;
+
+public:
+    BackgroundScrolling() {
+        // 添加多层背景
+        layers.push_back({ 0, 0.1f, RGB(220, 235, 245), 100 });
+        layers.push_back({ 100, 0.2f, RGB(210, 225, 240), 120 });
+        layers.push_back({ 220, 0.3f, RGB(200, 215, 235), 140 });
+    }
+
+    void update(float deltaTime, float cameraSpeed) {
+        for (auto& layer : layers) {
+            layer.y += cameraSpeed * layer.speed * deltaTime;
+        }
+    }
+
+    void draw(float cameraY);
+};
+
+// 平台预览：即将从屏幕上方出现的平台画成半透明的虚线框。
+// 只在绘制时按各视口的镜头收集，列表放在帧分配器中随帧释放，模拟和回滚重算不做这项工作
+class PlatformPreview {
+private:
+    struct PreviewPlatform {
+        float x, y;
+        float width;
+        PlatformType type;
+        float alpha;
+    };
+
+    static const size_t RESERVED = 16;     // 屏幕上方150像素内的平台通常在此之内
+
+    static void collect(const World& world, float cameraY, FrameVector<PreviewPlatform>& previews) {
+        const auto& platforms = world.getRegistry().pool<PlatformState>();
+        for (size_t i = 0; i < platforms.size(); i++) {
+            Entity entity = platforms.entityAt(i);
+            const Transform transform = world.getPosition(entity);
+            float screenY = transform.y - cameraY;
+
+            // 为即将出现在屏幕上方的平台添加预览
+            if (screenY < -50 && screenY > -200) {
+                float alpha = 1.0f - (abs(screenY + 50) / 150.0f);
+                previews.push_back({
+                    transform.x, transform.y,
+                    world.getRegistry().get<Bounds>(entity).width, platforms.at(i).type,
+                    alpha * 0.5f
+                    });
+            }
+        }
+    }
+
+public:
+    void draw(const World& world, float cameraY, FrameArena& arena) const;
+};
+
+class PlatformGenerator {
+private:
+    // 玩家基础跳跃能力：道具只会扩大可达范围，按基础能力生成即可保证可达
+    JumpEnvelope envelope;
+
+    // 平台类型概率表（见GameTuning::platformTypeThresholds）
+    int typeThresholds[3][3];
+
+public:
+    PlatformGenerator() {
+        setTypeThresholds(GameTuning().platformTypeThresholds);
+    }
+
+    void setTypeThresholds(const int thresholds[3][3]) {
+        for (int tier = 0; tier < 3; tier++) {
+            for (int i = 0; i < 3; i++) {
+                typeThresholds[tier][i] = thresholds[tier][i];
+            }
+        }
+    }
+
+    PlatformType getRandomType(float difficulty) {
+        int rand_val = Random::next() % 100;
+
+        int tier = difficulty < 0.3f ? 0 : (difficulty < 0.7f ? 1 : 2);
+        const int* thresholds = typeThresholds[tier];
+
+        if (rand_val < thresholds[0]) return NORMAL;
+        else if (rand_val < thresholds[1]) return MOVING;
+        else if (rand_val < thresholds[2]) return BREAKABLE;
+        else return SPRING;
+    }
+
+    const JumpEnvelope& getEnvelope() const { return envelope; }
+
+    // 在高度y附近生成一个从lastPlatform可达的平台：先随机取位置，再按跳跃包络修正，O(1)
+    Platform generateNextPlatform(const Platform& lastPlatform, float y, float difficulty) {
+        y = envelope.clampReachableY(lastPlatform, y);
+
+        float x = 50.0f + Random::next() % (WINDOW_WIDTH - 200);
+        float width = 80.0f + Random::next() % 80;
+        PlatformType type = getRandomType(difficulty);
+
+        x = envelope.clampReachableX(lastPlatform, x, width, y, type);
+        return Platform(x, y, width, 20, type);
+    }
+
+    Platform generateRandomPlatform(float y, float difficulty) {
+        float x = 50.0f + Random::next() % (WINDOW_WIDTH - 200);
+        float width = 80.0f + Random::next() % 80;
+        return Platform(x, y, width, 20, getRandomType(difficulty));
+    }
+};
+
+// 预先随机好的障碍物投放（类型和x），由Game按计时器依次取用
+struct PlannedObstacle {
+    ObstacleType type;
+    float x;
+};
+
+// 排队等待投放的计划上限：分块拼接快于障碍物生成时（玩家爬升很快）不再追加，队列不会无限增长
+const int MAX_PLANNED_OBSTACLES = 64;
+
+// 预先放置的金币
+struct PlannedCoin {
+    float x, y;
+    int value;
+};
+
+// 世界分块：固定高度的一段世界，坐标相对块底部（块内y均为负值）
+// 块来自ChunkPool，容器按上限预留，复用时只清空不释放
+struct WorldChunk {
+    static constexpr float HEIGHT = (float)WINDOW_HEIGHT;
+    static const int PLANNED_OBSTACLES = 8;
+    static const int MAX_PLATFORMS = WINDOW_HEIGHT / 80 + 1;   // 平台间距至少80
+
+    unsigned int epoch;     // 所属的生成轮次，重开一局后旧轮次的块直接丢弃
+    int index;
+    vector<Platform> platforms;
+    vector<PlannedCoin> coins;
+    vector<PlannedObstacle> obstacles;
+
+    std::atomic<int> references;    // SharedChunk的引用数，归零时回到ChunkPool
+
+    WorldChunk() : epoch(0), index(0), references(0) {
+        platforms.reserve(MAX_PLATFORMS);
+        coins.reserve(MAX_PLATFORMS);
+        obstacles.reserve(PLANNED_OBSTACLES);
+    }
+
+    WorldChunk(const WorldChunk&) = delete;
+    WorldChunk& operator=(const WorldChunk&) = delete;
+};
+
+// 块池：用完的块回到池中供下一次生成复用，稳定运行时生成与拼接块不访问堆；池空时新建一块并计数。
+// 全进程共用，游戏线程和生成任务都会取用、归还。不析构：快照等静态对象中的块引用可能在它之后才释放
+class ChunkPool {
+private:
+    static const int INITIAL_CHUNKS = 16;
+
+    std::mutex lock;
+    vector<std::unique_ptr<WorldChunk>> chunks;
+    vector<WorldChunk*> freeChunks;
+    int growCount;
+
+    ChunkPool() : growCount(0) {
+        chunks.reserve(INITIAL_CHUNKS);
+        freeChunks.reserve(INITIAL_CHUNKS);
+        for (int i = 0; i < INITIAL_CHUNKS; i++) {
+            chunks.emplace_back(new WorldChunk());
+            freeChunks.push_back(chunks.back().get());
+        }
+    }
+
+public:
+    static ChunkPool& getInstance() {
+        static ChunkPool* instance = new ChunkPool();
+        return *instance;
+    }
+
+    // 取出一个清空的块
+    WorldChunk* acquire() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (freeChunks.empty()) {
+            chunks.emplace_back(new WorldChunk());
+            freeChunks.reserve(chunks.size());
+            growCount++;
+            return chunks.back().get();
+        }
+
+        WorldChunk* chunk = freeChunks.back();
+        freeChunks.pop_back();
+        chunk->platforms.clear();
+        chunk->coins.clear();
+        chunk->obstacles.clear();
+        return chunk;
+    }
+
+    void release(WorldChunk* chunk) {
+        std::lock_guard<std::mutex> guard(lock);
+        freeChunks.push_back(chunk);
+    }
+
+    // 池中块用尽、新建块的次数
+    int getGrowCount() {
+        std::lock_guard<std::mutex> guard(lock);
+        return growCount;
+    }
+};
+
+// 已生成的块不再修改，游戏线程、工作线程和快照之间共享。引用计数在块内，复制引用不访问堆
+class SharedChunk {
+private:
+    WorldChunk* chunk;
+
+public:
+    SharedChunk() : chunk(nullptr) {}
+    SharedChunk(std::nullptr_t) : chunk(nullptr) {}
+    explicit SharedChunk(WorldChunk* chunk) : chunk(chunk) {
+        if (chunk) chunk->references.fetch_add(1, std::memory_order_relaxed);
+    }
+    SharedChunk(const SharedChunk& other) : SharedChunk(other.chunk) {}
+    SharedChunk(SharedChunk&& other) noexcept : chunk(other.chunk) { other.chunk = nullptr; }
+    ~SharedChunk() { reset(); }
+
+    SharedChunk& operator=(SharedChunk other) noexcept {
+        std::swap(chunk, other.chunk);
+        return *this;
+    }
+
+    void reset() {
+        if (chunk && chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ChunkPool::getInstance().release(chunk);
+        }
+        chunk = nullptr;
+    }
+
+    const WorldChunk* operator->() const { return chunk; }
+    const WorldChunk& operator*() const { return *chunk; }
+    explicit operator bool() const { return chunk != nullptr; }
+};
+
+// 分块生成请求：chainStart非空表示重新开始，携带上一段平台链的末端（相对新块底部）
+struct ChunkRequest {
+    unsigned int epoch = 0;
+    int index = 0;
+    float difficulty = 0.0f;
+    std::unique_ptr<Platform> chainStart;
+    PlatformGenerator generator;
+};
+
+// 分块生成器：按顺序生成平台链，每个块的第一个平台从上一个块的最后一个平台可达
+class ChunkGenerator {
+private:
+    PlatformGenerator generator;
+    Platform chainTail;         // 平台链的末端（相对下一个块的底部），hasChainTail为false时未使用
+    bool hasChainTail;
+
+public:
+    // 占位的链尾用非NORMAL类型构造，不会随机道具、不消耗随机数
+    ChunkGenerator() : chainTail(0.0f, 0.0f, 100, 20, MOVING), hasChainTail(false) {}
+
+    // 在没有道具的普通平台上方预先放置金币
+    static void planCoin(const Platform& platform, vector<PlannedCoin>& coins) {
+        if (platform.getType() == NORMAL && platform.getItem() == nullptr && Random::next() % 100 < 15) {
+            float coinX = platform.getX() + platform.getWidth() / 2;
+            int coinValue = 10 + Random::next() % 15; // 10-25分
+            coins.push_back({ coinX, platform.getY() - 30, coinValue });
+        }
+    }
+
+    SharedChunk generate(ChunkRequest& request) {
+        MemoryScope memoryScope(MEM_PLATFORMS);
+        if (request.chainStart) {
+            chainTail = *request.chainStart;
+            hasChainTail = true;
+            request.chainStart.reset();
+            generator = request.generator;
+        }
+
+        // 池中的块已按上限预留，生成过程中不再扩容
+        WorldChunk* chunk = ChunkPool::getInstance().acquire();
+        chunk->epoch = request.epoch;
+        chunk->index = request.index;
+        if (!hasChainTail) return SharedChunk(chunk);
+
+        Platform tail(chainTail);
+        float y = tail.getY();
+        while (true) {
+            y -= 80 + Random::next() % 80;
+            if (y <= -WorldChunk::HEIGHT) break;
+
+            Platform platform = generator.generateNextPlatform(tail, y, request.difficulty);
+            y = platform.getY();
+
+            planCoin(platform, chunk->coins);
+
+            tail = platform;
+            chunk->platforms.push_back(std::move(platform));
+        }
+
+        for (int i = 0; i < WorldChunk::PLANNED_OBSTACLES; i++) {
+            ObstacleType type = static_cast<ObstacleType>(Random::next() % 6);
+            float x = 50.0f + Random::next() % (WINDOW_WIDTH - 150);
+            chunk->obstacles.push_back({ type, x });
+        }
+
+        // 链尾换算到下一个块的坐标系
+        tail.moveY(WorldChunk::HEIGHT);
+        chainTail = tail;
+        return SharedChunk(chunk);
+    }
+};
+
+// 分块流在非线程模式下的完整状态（回滚快照）
+struct ChunkStreamerState {
+    unsigned int epoch = 0;
+    int nextRequestIndex = 0;
+    ChunkGenerator generator;
+    vector<SharedChunk> ready;      // 已生成、尚未拼接的块
+};
+
+// 分块流：在任务池中提前生成分块，通过两个无锁队列与游戏线程交接
+// 游戏线程只负责投递请求和拼接已生成的块；无窗口模式不用任务池，投递时直接生成（保证同种子可复现）
+class ChunkStreamer {
+private:
+    static const int LOOKAHEAD = 2;     // 提前准备的块数
+
+    bool threaded;
+    unsigned int seed;
+    unsigned int epoch;
+    int nextRequestIndex;
+
+    ChunkGenerator generator;
+    SpscQueue<ChunkRequest, 16> requests;                   // 游戏线程 -> 生成任务
+    SpscQueue<SharedChunk, 16> ready;                        // 生成任务 -> 游戏线程
+
+    // 同一时刻最多一个生成任务在处理请求：两个队列的另一端始终只有一个线程，生成器状态也不会被并发修改
+    std::atomic<bool> running;
+    std::atomic<bool> draining;
+    JobCounter drainJobs;
+    std::uint32_t randomState;          // 生成任务的随机数状态：任务池线程的随机数状态属于其他任务
+
+    void drainRequests() {
+        std::uint32_t callerState = Random::getState();
+        do {
+            Random::setState(randomState);
+            ChunkRequest request;
+            while (running.load(std::memory_order_relaxed) && requests.tryPop(request)) {
+                SharedChunk chunk = generator.generate(request);
+                while (!ready.tryPush(std::move(chunk))) {
+                    if (!running.load(std::memory_order_relaxed)) break;
+                    std::this_thread::yield();
+                }
+            }
+            randomState = Random::getState();
+            draining.store(false, std::memory_order_release);
+            // 释放之后才投递的请求：没有其他任务接手时继续处理
+        } while (running.load(std::memory_order_relaxed) && !requests.empty() &&
+            !draining.exchange(true, std::memory_order_acquire));
+        Random::setState(callerState);
+    }
+
+    void post(ChunkRequest&& request) {
+        if (threaded) {
+            while (!requests.tryPush(std::move(request))) {
+                std::this_thread::yield();
+            }
+            if (!draining.exchange(true, std::memory_order_acquire)) {
+                JobSystem::getInstance().run(drainJobs, [this]() { drainRequests(); });
+            }
+        }
+        else {
+            ready.tryPush(generator.generate(request));
+        }
+    }
+
+    void requestNext(float difficulty) {
+        ChunkRequest request;
+        request.epoch = epoch;
+        request.index = nextRequestIndex++;
+        request.difficulty = difficulty;
+        post(std::move(request));
+    }
+
+public:
+    // 任务池没有工作线程时（单核或--threads 1）退回投递时直接生成
+    ChunkStreamer(bool threaded, unsigned int seed)
+        : threaded(threaded && JobSystem::getInstance().getWorkerCount() > 0), seed(seed), epoch(0), nextRequestIndex(0),
+        running(this->threaded), draining(false),
+        randomState(seed != 0 ? seed : (unsigned int)time(nullptr)) {
+    }
+
+    ~ChunkStreamer() {
+        stopWorker();
+    }
+
+    // 改为投递时直接生成：生成顺序与时机只取决于模拟本身（联机对战要求各端完全一致）
+    // 之后需要restart重新开始生成
+    void stopWorker() {
+        running = false;
+        JobSystem::getInstance().wait(drainJobs);
+        threaded = false;
+    }
+
+    bool isThreaded() const { return threaded; }
+
+    // 保存/恢复生成状态，只在非线程模式下可用（后台线程运行时状态随时在变）
+    void saveState(ChunkStreamerState& state) {
+        state.epoch = epoch;
+        state.nextRequestIndex = nextRequestIndex;
+        state.generator = generator;
+        state.ready.clear();
+
+        // 队列只有本线程访问：逐个取出后按原顺序放回，快照只持有块的引用
+        size_t count = 0;
+        SharedChunk chunk;
+        while (ready.tryPop(chunk)) {
+            state.ready.push_back(std::move(chunk));
+            count++;
+        }
+        for (size_t i = 0; i < count; i++) {
+            SharedChunk item = state.ready[i];
+            ready.tryPush(std::move(item));
+        }
+    }
+
+    void loadState(const ChunkStreamerState& state) {
+        epoch = state.epoch;
+        nextRequestIndex = state.nextRequestIndex;
+        generator = state.generator;
+
+        SharedChunk stale;
+        while (ready.tryPop(stale)) {}
+        for (SharedChunk chunk : state.ready) {
+            ready.tryPush(std::move(chunk));
+        }
+    }
+
+    // 开始新的一轮生成：chainStart为已有平台链的末端（坐标相对第一个块的底部）
+    void restart(const Platform& chainStart, const PlatformGenerator& platformGenerator, float difficulty) {
+        epoch++;
+        nextRequestIndex = 0;
+
+        SharedChunk stale;
+        while (ready.tryPop(stale)) {}
+
+        ChunkRequest request;
+        request.epoch = epoch;
+        request.index = nextRequestIndex++;
+        request.difficulty = difficulty;
+        request.chainStart.reset(new Platform(chainStart));
+        request.generator = platformGenerator;
+        post(std::move(request));
+
+        for (int i = 1; i < LOOKAHEAD; i++) {
+            requestNext(difficulty);
+        }
+    }
+
+    // 取出下一个已生成的块，同时补发一个请求保持预生成数量；尚未生成好时返回nullptr
+    SharedChunk takeReady(float difficulty) {
+        SharedChunk chunk;
+        while (ready.tryPop(chunk)) {
+            if (chunk->epoch == epoch) {
+                requestNext(difficulty);
+                return chunk;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// 分屏中的一名玩家：玩家本身，以及只属于他的镜头、死亡线、复活点、分数和垂直速度统计
+// 平台、障碍物、金币和世界下移由所有玩家共享
+struct PlayerSlot {
+    // 最后接触的平台信息（用于复活）
+    struct LastPlatformInfo {
+        float x, y;
+        float width, height;
+        bool isValid;
+
+        LastPlatformInfo() : x(0), y(0), width(100), height(20), isValid(false) {}
+    };
+
+    Player player;
+    int index;                  // 0起，决定按键和视口位置
+    bool alive;
+
+    float cameraY;
+    float cameraVelocity;       // 镜头临界阻尼跟随的当前速度
+    float cameraTargetY;
+    float smoothCameraSpeed;    // 平滑镜头速度，作为镜头跟随的omega
+    float killZone;
+
+    long long score;
+    long long maxHeight;
+    float survivalTime;         // 出局时的游戏时间
+    int scoreRank;              // 本局在排行榜中的名次，未上榜为0
+    bool personalBest;
+
+    LastPlatformInfo lastSafePlatform;
+
+    // 玩家垂直速度统计：最近50个向上的样本
+    RunningAverage<50> verticalSpeedSamples;
+    float averageVerticalSpeed;
+    float lastY;
+    float speedSampleTime;
+
+    DeathCause deathCause;
+    ObstacleType lastDamageObstacle;
+
+    // 玩家的道具效果和连击计时登记在timers（总时间的时间轮）上，着陆、跳跃等事件追加到events
+    PlayerSlot(int index, TimerWheel& timers, GameEventBuffer& events)
+        : player(100, 400), index(index), alive(true),
+        cameraY(0), cameraVelocity(0), cameraTargetY(0), smoothCameraSpeed(3.0f), killZone(0),
+        score(0), maxHeight(0), survivalTime(0), scoreRank(0), personalBest(false),
+        averageVerticalSpeed(0.0f), lastY(0.0f), speedSampleTime(0.0f),
+        deathCause(DEATH_NONE), lastDamageObstacle(SPIKE) {
+        player.bindTimers(&timers, index);
+        player.bindEvents(&events);
+    }
+
+    void reset() {
+        player.reset();
+        alive = true;
+        cameraY = 0;
+        cameraVelocity = 0;
+        cameraTargetY = 0;
+        smoothCameraSpeed = 3.0f;
+        score = 0;
+        maxHeight = 0;
+        survivalTime = 0;
+        scoreRank = 0;
+        personalBest = false;
+        lastSafePlatform = LastPlatformInfo();
+        verticalSpeedSamples.clear();
+        averageVerticalSpeed = 0.0f;
+        speedSampleTime = 0.0f;
+        deathCause = DEATH_NONE;
+        lastDamageObstacle = SPIKE;
+    }
+
+    void rememberSafePlatform(const Transform& transform, const Bounds& bounds) {
+        lastSafePlatform.x = transform.x;
+        lastSafePlatform.y = transform.y;
+        lastSafePlatform.width = bounds.width;
+        lastSafePlatform.height = bounds.height;
+        lastSafePlatform.isValid = true;
+    }
+
+    PlayerBox getBox() const {
+        return { player.getX(), player.getY(), player.getWidth(), player.getHeight(), player.getPrevX(), player.getPrevY() };
+    }
+};
+
+// 整局模拟状态的快照（联机回滚、存档点）：恢复后用相同输入重新模拟，结果与第一次完全一致
+// 只包含会影响之后模拟的状态；镜头参数、平衡性参数等开局后不变的设置，以及界面、音频和粒子不在其中
+// 世界实体按组件池增量保存，未变化的池与上一个快照共享；已生成的块只持有引用。
+// 反复保存到同一个快照对象时复用其容量，稳定后不再分配内存
+struct GameSnapshot {
+    GameState state = PLAYING;
+    std::vector<PlayerSlot> slots;
+    WorldSnapshot world;
+    ChunkStreamerState streamer;
+    std::uint32_t randomState = 0;
+    BackgroundScrolling background;
+
+    float worldSpeed = 0;
+    float worldSpeedVelocity = 0;
+    float gameTime = 0;
+    float nextChunkBaseY = 0;
+    Entity startPlatformEntity = NULL_ENTITY;
+    GameClock clock;
+    float obstacleSpawnRate = 0;
+    int obstacleSpawnCount = 0;
+    RingQueue<PlannedObstacle> plannedObstacles{ MAX_PLANNED_OBSTACLES };
+    int itemUsage[INVINCIBILITY + 1] = {};
+};
+
+class Game {
+private:
+    GameState currentState;
+    bool headless;          // 无窗口模式（基准测试/批量模拟），不读键盘、不播放音频
+    bool quitRequested;     // 菜单或结算界面按了ESC，由主循环关闭窗口退出
+    World world;            // 平台、障碍物、金币和道具，所有玩家共享
+
+    // 本地玩家（1到MAX_LOCAL_PLAYERS名），多于一名时分屏
+    std::vector<PlayerSlot> slots;
+    int playerCount;                // 下一局的玩家数
+    int localView;                  // 联机时只显示本机玩家的视口，-1表示按玩家数分屏
+
+    // 联机对战：各端用相同种子和相同的逐帧输入同步模拟，见NetSession.h
+    bool netplay;
+    bool replaying;                 // 回滚重算中，已经播放过的音效不再重复
+    float initialPlayerY;   // 记录初始Y位置
+
+    BackgroundScrolling background;
+    PlatformPreview platformPreview;
+
+    // UI相关
+    float fadeAlpha;
+
+    // 相机相关
+    float cameraSpeed;
+    float cameraDeadZone;
+    float maxCameraSpeed; 
+    float cameraSpeedLimit;
+
+    // 游戏状态相关
+    float worldSpeed;
+    float worldSpeedVelocity;       // 世界速度临界阻尼跟随的当前变化率
+    float baseWorldSpeed;
+    float gameTime;
+
+    // 输入：采样线程收集带时间戳的按键事件，每帧汇总为inputFrame
+    InputSystem input;
+    InputFrame inputFrame;
+
+    // 幽灵竞速：录制本局轨迹，同时回放最佳一局（无窗口模式不读写文件）
+    GhostRecorder ghostRecorder;
+    GhostPlayer ghostPlayer;
+
+    // 成绩存储：每局结束为每名玩家追加一条记录，结算界面显示排行榜（无窗口模式不读写文件）
+    ScoreStore scoreStore;
+
+    // 平台生成器
+    PlatformGenerator platformGenerator;
+    ChunkStreamer chunkStreamer;
+
+    // 平衡性参数
+    GameTuning tuning;
+
+    // 单局统计（死亡原因记录在各玩家的PlayerSlot中）
+    int itemUsage[INVINCIBILITY + 1];
+
+    // 平台生成相关
+    float nextChunkBaseY;           // 下一个块底部的世界坐标，随世界一起下移
+    float platformSpawnThreshold;
+    Entity startPlatformEntity;     // 起始平台，开局时把玩家放在上面
+
+    // 活动区在最靠上的玩家或镜头上方留出的距离：预览（镜头上方200）、AI的规划（玩家上方400）、
+    // 磁铁吸附都在此范围内，更高处的平台和金币休眠，见World::setActiveTop
+    static constexpr float ACTIVE_MARGIN = 450.0f;
+
+    // 平滑镜头速度控制：镜头跟随速度按CAMERA_SPEED_BLEND_RATE趋近目标（60帧下相当于每帧混合2%）
+    static constexpr float CAMERA_SPEED_BLEND_RATE = 1.2f;
+    float cameraSpeedAcceleration;
+    float maxSafeCameraSpeed;
+
+    // 世界速度平滑控制：临界阻尼跟随目标速度，worldSpeedSmoothing为omega，约1.6秒跟上阶跃
+    float maxWorldSpeed;
+    float worldSpeedSmoothing;
+
+    // 生成器（金币随分块预先放置，障碍物的类型和位置也由分块预先随机）
+    float obstacleSpawnRate;
+    int obstacleSpawnCount;         // 多人时轮流在各玩家上方生成
+    RingQueue<PlannedObstacle> plannedObstacles;
+
+    // 时间层级和时间轮：道具效果、连击、障碍物寿命、破碎平台重生和障碍物生成都登记在上面
+    GameClock clock;
+    std::vector<TimerEvent> firedTimers;    // 每帧到期的定时，复用容量
+    std::vector<CoinPickup> coinPickups;    // 每帧拾取的金币，复用容量
+
+    // 本帧模拟产生的事件，帧末由drainEvents交给统计、音效和特效
+    GameEventBuffer events;
+
+    // 绘制期间的临时数据，每帧render结束时重置；界面文字用FixedText在栈上拼接
+    FrameArena frameArena;
+
+    struct Button {
+        int x, y, width, height;
+        HudText text;
+        bool isHovered;
+
+        Button(int x, int y, int width, int height, const wchar_t* label)
+            : x(x), y(y), width(width), height(height), isHovered(false) {
+            text << label;
+        }
+
+        bool isPointInside(int px, int py) const {
+            return px >= x && px <= x + width && py >= y && py <= y + height;
+        }
+    };
+
+    // 菜单按钮
+    Button startButton;
+    Button helpButton;
+    Button playersButton;   // 切换本地玩家数
+    Button backButton;  // 帮助页面的返回按钮
+
+    // 鼠标位置
+    int mouseX, mouseY;
+
+    float helpScrollOffset;      // 帮助页面滚动偏移
+    float maxHelpScrollOffset;   // 最大滚动偏移
+    const float HELP_SCROLL_SPEED = 30.0f;  // 滚动速度
+
+    AudioManager& audioManager;
+    // 音频设置相关变量
+    Button audioSettingsButton;
+    Button backFromAudioButton;
+    Button muteButton;
+    Button masterVolumeDownButton;
+    Button masterVolumeUpButton;
+    Button musicVolumeDownButton;
+    Button musicVolumeUpButton;
+    Button sfxVolumeDownButton;
+    Button sfxVolumeUpButton;
+
+public:
+    // seed为0时使用当前时间作为随机种子
+    explicit Game(bool headless = false, unsigned int seed = 0)
+        : currentState(MENU), headless(headless), quitRequested(false), playerCount(1), localView(-1),
+        netplay(false), replaying(false), fadeAlpha(0),
+        cameraSpeed(3.0f), cameraDeadZone(80.0f),
+        maxCameraSpeed(4.5f), cameraSpeedLimit(600.0f),
+        worldSpeed(0), worldSpeedVelocity(0), baseWorldSpeed(20.0f), gameTime(0),
+        input(!headless),
+        chunkStreamer(!headless, seed),
+        nextChunkBaseY(0), platformSpawnThreshold(30.0f), startPlatformEntity(NULL_ENTITY),
+        cameraSpeedAcceleration(0.5f),
+        maxSafeCameraSpeed(8.0f),
+        maxWorldSpeed(60.0f),
+        worldSpeedSmoothing(4.0f),
+        obstacleSpawnRate(5.0f),
+        obstacleSpawnCount(0),
+        plannedObstacles(MAX_PLANNED_OBSTACLES),
+        startButton(WINDOW_WIDTH / 2 - 100, 300, 200, 50, L"Start Game"),
+        helpButton(WINDOW_WIDTH / 2 - 100, 370, 200, 50, L"Help"),
+        playersButton(WINDOW_WIDTH / 2 - 100, 510, 200, 50, L"Players: 1"),
+        backButton(WINDOW_WIDTH / 2 - 100, 650, 200, 50, L"Back to Menu"),
+        mouseX(0), mouseY(0),
+        helpScrollOffset(0.0f), maxHelpScrollOffset(0.0f),
+        audioManager(AudioManager::getInstance()),
+        audioSettingsButton(WINDOW_WIDTH / 2 - 100, 440, 200, 50, L"Audio Settings"),
+        backFromAudioButton(WINDOW_WIDTH / 2 - 100, 650, 200, 50, L"Back to Menu"),
+        muteButton(WINDOW_WIDTH / 2 - 100, 180, 200, 50, L"Toggle Mute"),
+        masterVolumeDownButton(WINDOW_WIDTH / 2 - 250, 260, 100, 35, L"Master -"),
+        masterVolumeUpButton(WINDOW_WIDTH / 2 + 150, 260, 100, 35, L"Master +"),
+        musicVolumeDownButton(WINDOW_WIDTH / 2 - 250, 320, 100, 35, L"Music -"),
+        musicVolumeUpButton(WINDOW_WIDTH / 2 + 150, 320, 100, 35, L"Music +"),
+        sfxVolumeDownButton(WINDOW_WIDTH / 2 - 250, 380, 100, 35, L"SFX -"),
+        sfxVolumeUpButton(WINDOW_WIDTH / 2 + 150, 380, 100, 35, L"SFX +") {
+
+        Random::seed(seed != 0 ? seed : (unsigned int)time(nullptr));
+        world.bindTimers(&clock.getTimers(TIME_GAMEPLAY));
+        world.bindEvents(&events);
+        resetClock();
+        firedTimers.reserve(TimerWheel::CAPACITY);
+        coinPickups.reserve(World::ENTITY_CAPACITY);
+        slots.emplace_back(0, clock.getTimers(TIME_GLOBAL), events);
+        resetRunStats();
+
+        // 初始化音频系统（无窗口模式下关闭音频）
+        // 多个无窗口Game可能在不同线程中同时构造，已关闭时不再写入共享的AudioManager
+        if (headless) {
+            if (audioManager.isAudioEnabled()) {
+                audioManager.setAudioEnabled(false);
+            }
+        }
+        else {
+            audioManager.initialize();
+            audioManager.onMenuEnter();  // 播放菜单音乐
+            scoreStore.open("scores");
+        }
+        initializePlatforms();
+        positionPlayersOnStartPlatform();
+
+        // 使用地面作为基准点
+        initialPlayerY = WINDOW_HEIGHT - 40;  // 地面平台的顶部
+
+        for (auto& slot : slots) {
+            slot.lastY = slot.player.getY();
+            slot.killZone = slot.player.getY() + 300.0f;
+        }
+        events.clear();
+    }
+
+
+    // 访问器（供基准测试和批量模拟使用，玩家相关的取第一名玩家）
+    GameState getState() const { return currentState; }
+    Player& getPlayer(int index = 0) { return slots[index].player; }
+    const Player& getPlayer(int index = 0) const { return slots[index].player; }
+    bool isPlayerAlive(int index) const { return slots[index].alive; }
+    World& getWorld() { return world; }
+    PlatformGenerator& getPlatformGenerator() { return platformGenerator; }
+    long long getScore() const { return slots[0].score; }
+    long long getMaxHeight() const { return slots[0].maxHeight; }
+    float getGameTime() const { return gameTime; }
+    float getCameraY() const { return slots[0].cameraY; }
+    float getWorldSpeed() const { return worldSpeed; }
+    const GameClock& getClock() const { return clock; }
+
+    // 时间减缓作用于整个游戏层；世界由所有玩家共享，取仍在场玩家中最慢的时间缩放
+    float getGameplayTimeScale() const {
+        float scale = 1.0f;
+        for (const auto& slot : slots) {
+            if (slot.alive) scale = std::min(scale, slot.player.getTimeScaleFactor());
+        }
+        return scale;
+    }
+    float getKillZone(int index = 0) const { return slots[index].killZone; }
+
+    // 本地玩家数（在resetGame/startHeadlessRun之前设置）
+    int getPlayerCount() const { return playerCount; }
+    void setPlayerCount(int count) {
+        playerCount = std::max(1, std::min(count, MAX_LOCAL_PLAYERS));
+        playersButton.text.clear();
+        playersButton.text << L"Players: " << playerCount;
+    }
+
+    // 注入一帧输入（自动玩家等非键盘来源），下一次updateGame使用
+    void injectInput(const InputFrame& frame) { inputFrame = frame; }
+    const InputFrame& getInputFrame() const { return inputFrame; }
+
+    // 平衡性参数（在startHeadlessRun/resetGame之前设置）
+    const GameTuning& getTuning() const { return tuning; }
+    void setTuning(const GameTuning& newTuning) {
+        tuning = newTuning;
+        platformGenerator.setTypeThresholds(tuning.platformTypeThresholds);
+        baseWorldSpeed = tuning.baseWorldSpeed;
+        maxWorldSpeed = tuning.maxWorldSpeed;
+    }
+
+    RunStats getRunStats() const {
+        const PlayerSlot& slot = slots[0];
+        RunStats stats;
+        stats.score = slot.score;
+        stats.maxHeight = slot.maxHeight;
+        stats.survivalTime = gameTime;
+        stats.coins = slot.player.getCoins();
+        stats.itemsCollected = slot.player.getItemsCollected();
+        stats.deathCause = slot.deathCause;
+        stats.killerObstacle = slot.lastDamageObstacle;
+        for (int i = 0; i <= INVINCIBILITY; i++) {
+            stats.itemUsage[i] = itemUsage[i];
+        }
+        return stats;
+    }
+
+    // 无窗口模式下直接开始一局
+    void startHeadlessRun() {
+        resetGame();
+        currentState = PLAYING;
+    }
+
+    // 开始一局联机对战：各端使用相同的种子和玩家数，localPlayer为本机控制的玩家
+    // 分块改为在游戏线程中按需生成，保证各端的世界和随机数序列一致；联机局不保存成绩和幽灵
+    void startNetRun(int players, int localPlayer, unsigned int seed) {
+        chunkStreamer.stopWorker();
+        netplay = true;
+        localView = headless ? -1 : localPlayer;
+        Random::seed(seed);
+        setPlayerCount(players);
+        resetGame();
+        currentState = PLAYING;
+        if (!headless) {
+            audioManager.onGameStart();
+        }
+    }
+
+    // 联机对局结束（游戏结束后），之后回到普通的本地对局
+    void endNetRun() {
+        netplay = false;
+        localView = -1;
+    }
+
+    bool isNetplay() const { return netplay; }
+    void setReplaying(bool value) { replaying = value; }
+
+    // 保存/恢复整局模拟状态（联机回滚），只在startNetRun之后使用（后台生成线程运行时状态随时在变）
+    // base为之前保存的快照（通常是上一个），内容未变的组件池直接共享
+    void saveSnapshot(GameSnapshot& snapshot, const GameSnapshot* base = nullptr) {
+        snapshot.state = currentState;
+        snapshot.slots = slots;
+        world.saveState(snapshot.world, base ? &base->world : nullptr);
+        chunkStreamer.saveState(snapshot.streamer);
+        snapshot.randomState = Random::getState();
+        snapshot.background = background;
+
+        snapshot.worldSpeed = worldSpeed;
+        snapshot.worldSpeedVelocity = worldSpeedVelocity;
+        snapshot.gameTime = gameTime;
+        snapshot.nextChunkBaseY = nextChunkBaseY;
+        snapshot.startPlatformEntity = startPlatformEntity;
+        snapshot.clock = clock;
+        snapshot.obstacleSpawnRate = obstacleSpawnRate;
+        snapshot.obstacleSpawnCount = obstacleSpawnCount;
+        snapshot.plannedObstacles = plannedObstacles;
+        for (int i = 0; i <= INVINCIBILITY; i++) {
+            snapshot.itemUsage[i] = itemUsage[i];
+        }
+    }
+
+    void loadSnapshot(const GameSnapshot& snapshot) {
+        currentState = snapshot.state;
+        slots = snapshot.slots;
+        world.restoreState(snapshot.world);
+        chunkStreamer.loadState(snapshot.streamer);
+        Random::setState(snapshot.randomState);
+        background = snapshot.background;
+
+        worldSpeed = snapshot.worldSpeed;
+        worldSpeedVelocity = snapshot.worldSpeedVelocity;
+        gameTime = snapshot.gameTime;
+        nextChunkBaseY = snapshot.nextChunkBaseY;
+        startPlatformEntity = snapshot.startPlatformEntity;
+        clock = snapshot.clock;
+        obstacleSpawnRate = snapshot.obstacleSpawnRate;
+        obstacleSpawnCount = snapshot.obstacleSpawnCount;
+        plannedObstacles = snapshot.plannedObstacles;
+        for (int i = 0; i <= INVINCIBILITY; i++) {
+            itemUsage[i] = snapshot.itemUsage[i];
+        }
+        events.clear();
+    }
+
+    // 模拟状态的摘要（FNV-1a），联机各端比较同一帧的摘要以发现不同步
+    std::uint32_t getChecksum() const {
+        std::uint32_t hash = 2166136261u;
+        auto mix = [&hash](const void* data, size_t size) {
+            const unsigned char* bytes = (const unsigned char*)data;
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ bytes[i]) * 16777619u;
+            }
+        };
+
+        std::uint32_t randomState = Random::getState();
+        mix(&randomState, sizeof(randomState));
+        mix(&currentState, sizeof(currentState));
+        mix(&gameTime, sizeof(gameTime));
+        mix(&worldSpeed, sizeof(worldSpeed));
+        mix(&worldSpeedVelocity, sizeof(worldSpeedVelocity));
+        mix(&nextChunkBaseY, sizeof(nextChunkBaseY));
+        double worldTime = world.getTime();
+        mix(&worldTime, sizeof(worldTime));
+        for (int layer = 0; layer < TIME_LAYER_COUNT; layer++) {
+            std::uint32_t timerTick = clock.getTimers((TimeLayer)layer).getTick();
+            mix(&timerTick, sizeof(timerTick));
+        }
+        for (const auto& slot : slots) {
+            float values[4] = { slot.player.getX(), slot.player.getY(), slot.player.getVX(), slot.player.getVY() };
+            mix(values, sizeof(values));
+            mix(&slot.alive, sizeof(slot.alive));
+            mix(&slot.score, sizeof(slot.score));
+        }
+        size_t counts[4] = { world.getPlatformCount(), world.getObstacleCount(), world.getCoinCount(), world.getDormantCount() };
+        mix(counts, sizeof(counts));
+        return hash;
+    }
+
+    void initializePlatforms() {
+        MemoryScope memoryScope(MEM_PLATFORMS);
+        world.clear();
+
+        // 地面平台
+        Platform ground(0, WINDOW_HEIGHT - 40, WINDOW_WIDTH, 40, NORMAL);
+        world.spawnPlatform(ground);
+
+        // 添加一个固定的起始平台，确保玩家有地方站立
+        float startPlatformY = WINDOW_HEIGHT - 120;
+        float startPlatformX = WINDOW_WIDTH / 2 - 75; // 居中位置
+        Platform lastPlatform(startPlatformX, startPlatformY, 150, 20, NORMAL);
+        startPlatformEntity = world.spawnPlatform(lastPlatform);
+
+        // 随机生成初始平台
+        float currentY = WINDOW_HEIGHT - 100;
+        vector<PlannedCoin> initialCoins;
+
+        for (int i = 0; i < 15; i++) {
+            currentY -= 80 + Random::next() % 60;
+            // 每个平台都从上一个平台可达，保证从起始平台开始存在一条路径
+            Platform newPlatform = platformGenerator.generateNextPlatform(lastPlatform, currentY, 0.2f);
+            currentY = newPlatform.getY();
+            ChunkGenerator::planCoin(newPlatform, initialCoins);
+            world.spawnPlatform(newPlatform);
+            lastPlatform = std::move(newPlatform);
+        }
+
+        for (const auto& coin : initialCoins) {
+            world.spawnCoin(coin.x, coin.y, coin.value);
+        }
+
+        // 之后的世界按块在后台生成，平台链从最后一个初始平台接续
+        nextChunkBaseY = lastPlatform.getY();
+        lastPlatform.moveY(-nextChunkBaseY);
+        plannedObstacles.clear();
+        chunkStreamer.restart(lastPlatform, platformGenerator, 0.2f);
+    }
+
+    // 将玩家定位到起始平台上，多名玩家沿平台等距排开
+    void positionPlayersOnStartPlatform() {
+        for (auto& slot : slots) {
+            positionPlayerOnStartPlatform(slot);
+        }
+    }
+
+    void positionPlayerOnStartPlatform(PlayerSlot& slot) {
+        const Registry& registry = world.getRegistry();
+        if (registry.has<PlatformState>(startPlatformEntity)) {
+            Player& player = slot.player;
+            const Transform& transform = registry.get<Transform>(startPlatformEntity);
+            const Bounds& bounds = registry.get<Bounds>(startPlatformEntity);
+            float platformX = transform.x + bounds.width * (slot.index + 1) / (slots.size() + 1);
+            float platformTop = transform.y - player.getHeight();
+
+            player.setPosition(platformX - player.getWidth() / 2, platformTop);
+            player.setOnGround(true);
+
+            // 记录为安全平台
+            slot.rememberSafePlatform(transform, bounds);
+        }
+    }
+
+    // 最高（最靠前）的镜头：世界生成以领先的玩家为准
+    float getLeadingCameraY() const {
+        const PlayerSlot* leader = nullptr;
+        for (const auto& slot : slots) {
+            if (slot.alive && (!leader || slot.cameraY < leader->cameraY)) leader = &slot;
+        }
+        return leader ? leader->cameraY : slots[0].cameraY;
+    }
+
+    // 最低（最落后）的镜头：剔除实体以落后的玩家为准
+    float getTrailingCameraY() const {
+        const PlayerSlot* trailer = nullptr;
+        for (const auto& slot : slots) {
+            if (slot.alive && (!trailer || slot.cameraY > trailer->cameraY)) trailer = &slot;
+        }
+        return trailer ? trailer->cameraY : slots[0].cameraY;
+    }
+
+    // 活动区上沿：存活玩家的镜头和位置中最靠上的，再往上ACTIVE_MARGIN
+    float getActiveTop() const {
+        float top = getLeadingCameraY();
+        for (const auto& slot : slots) {
+            if (slot.alive) top = std::min(top, std::min(slot.cameraY, slot.player.getY()));
+        }
+        return top - ACTIVE_MARGIN;
+    }
+
+    // 镜头接近下一个块底部时拼接已生成的块：生成在后台完成，游戏线程只做搬运
+    void spliceReadyChunks() {
+        MemoryScope memoryScope(MEM_PLATFORMS);
+        if (getLeadingCameraY() < nextChunkBaseY + platformSpawnThreshold) {
+            float currentDifficulty = std::min(1.0f, gameTime / 60.0f);
+            SharedChunk chunk = chunkStreamer.takeReady(currentDifficulty);
+            if (!chunk) return;  // 后台提前两个块生成，正常不会发生；下一帧再试
+
+            for (const auto& platform : chunk->platforms) {
+                world.spawnPlatform(platform, nextChunkBaseY);
+            }
+            for (const auto& coin : chunk->coins) {
+                world.spawnCoin(coin.x, coin.y + nextChunkBaseY, coin.value);
+            }
+            for (const auto& obstacle : chunk->obstacles) {
+                if (plannedObstacles.size() >= (size_t)MAX_PLANNED_OBSTACLES) break;
+                plannedObstacles.pushBack(obstacle);
+            }
+
+            nextChunkBaseY -= WorldChunk::HEIGHT;
+        }
+    }
+
+    void update(float deltaTime) {
+        updateInputState();
+
+        if (inputFrame.wasPressed(KEY_MEMORY_REPORT)) {
+            writeMemoryReport();
+        }
+
+        switch (currentState) {
+        case MENU:
+            updateMenu();
+            break;
+		case HELP:
+            updateHelp();
+			break;
+        case AUDIO_SETTINGS:
+            updateAudioSettings();
+		    break;
+        case PLAYING:
+            updateGame(deltaTime);
+            break;
+        case PAUSED:
+            updatePause();
+            break;
+        case GAME_OVER:
+            updateGameOver();
+            break;
+        }
+    }
+
+    // 各子系统的内存统计追加到memory_report.txt，长时间运行时用来检查泄漏
+    void writeMemoryReport() const {
+        std::ofstream out("memory_report.txt", std::ios::app);
+        out << "---- game time " << gameTime << "s, particles " << slots[0].player.getParticleCount()
+            << ", entities " << world.getRegistry().alive() << "\n";
+        MemoryStats::writeReport(out);
+    }
+
+    // 在Game类中添加音频设置方法
+    void toggleAudio() {
+        audioManager.setAudioEnabled(!audioManager.isAudioEnabled());
+    }
+
+    void adjustMasterVolume(float delta) {
+        float newVolume = audioManager.getMasterVolume() + delta;
+        audioManager.setMasterVolume(newVolume);
+    }
+
+    void adjustMusicVolume(float delta) {
+        float newVolume = audioManager.getMusicVolume() + delta;
+        audioManager.setMusicVolume(newVolume);
+    }
+
+    void adjustSFXVolume(float delta) {
+        float newVolume = audioManager.getSFXVolume() + delta;
+        audioManager.setSFXVolume(newVolume);
+    }
+
+    // 在main函数中添加音频控制快捷键
+    void handleAudioControls() {
+        if (inputFrame.wasPressed(KEY_MUTE)) {  // 静音/取消静音
+            toggleAudio();
+        }
+        if (inputFrame.wasPressed(KEY_VOLUME_DOWN)) {  // 降低音量
+            adjustMasterVolume(-0.1f);
+        }
+        if (inputFrame.wasPressed(KEY_VOLUME_UP)) {  // 增加音量
+            adjustMasterVolume(0.1f);
+        }
+
+        // V键打开音频设置
+        if (inputFrame.wasPressed(KEY_AUDIO_SETTINGS) && currentState == MENU) {
+            currentState = AUDIO_SETTINGS;
+        }
+    }
+
+    // 更新音频设置状态
+    void updateAudioSettings() {
+
+        // 更新按钮悬停状态
+        backFromAudioButton.isHovered = backFromAudioButton.isPointInside(mouseX, mouseY);
+        muteButton.isHovered = muteButton.isPointInside(mouseX, mouseY);
+        masterVolumeDownButton.isHovered = masterVolumeDownButton.isPointInside(mouseX, mouseY);
+        masterVolumeUpButton.isHovered = masterVolumeUpButton.isPointInside(mouseX, mouseY);
+        musicVolumeDownButton.isHovered = musicVolumeDownButton.isPointInside(mouseX, mouseY);
+        musicVolumeUpButton.isHovered = musicVolumeUpButton.isPointInside(mouseX, mouseY);
+        sfxVolumeDownButton.isHovered = sfxVolumeDownButton.isPointInside(mouseX, mouseY);
+        sfxVolumeUpButton.isHovered = sfxVolumeUpButton.isPointInside(mouseX, mouseY);
+
+        // 按钮点击处理
+        if (inputFrame.wasPressed(KEY_MOUSE_LEFT)) {
+            if (backFromAudioButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                currentState = MENU;
+            }
+            else if (muteButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                toggleAudio();
+            }
+            else if (masterVolumeDownButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustMasterVolume(-0.1f);
+            }
+            else if (masterVolumeUpButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustMasterVolume(0.1f);
+            }
+            else if (musicVolumeDownButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustMusicVolume(-0.1f);
+            }
+            else if (musicVolumeUpButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustMusicVolume(0.1f);
+            }
+            else if (sfxVolumeDownButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustSFXVolume(-0.1f);
+            }
+            else if (sfxVolumeUpButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                adjustSFXVolume(0.1f);
+            }
+        }
+
+        // 返回菜单
+        if (inputFrame.wasPressed(KEY_BACKSPACE)) {
+            audioManager.playSound(SoundType::BUTTON_CLICK, false);
+            currentState = MENU;
+        }
+    }
+
+    // 绘制音频设置界面
+    void drawAudioSettings();
+
+    // 绘制音量条
+    void drawVolumeBar(int x, int y, int width, int height, float volume);
+
+    void updateInputState() {
+        inputFrame = input.poll();
+        mouseX = inputFrame.mouseX;
+        mouseY = inputFrame.mouseY;
+    }
+
+    // 主循环据此退出（F4）
+    bool isQuitRequested() const { return quitRequested || inputFrame.isDown(KEY_QUIT); }
+
+    void updateMenu() {
+        // 更新按钮悬停状态
+        bool wasStartHovered = startButton.isHovered;
+        bool wasHelpHovered = helpButton.isHovered;
+        bool wasPlayersHovered = playersButton.isHovered;
+        bool wasAudioHovered = audioSettingsButton.isHovered;
+
+        startButton.isHovered = startButton.isPointInside(mouseX, mouseY);
+        helpButton.isHovered = helpButton.isPointInside(mouseX, mouseY);
+        playersButton.isHovered = playersButton.isPointInside(mouseX, mouseY);
+        audioSettingsButton.isHovered = audioSettingsButton.isPointInside(mouseX, mouseY); 
+
+        // 播放悬停音效
+        if (!wasStartHovered && startButton.isHovered) {
+            audioManager.playSound(SoundType::BUTTON_HOVER, false);
+        }
+        if (!wasHelpHovered && helpButton.isHovered) {
+            audioManager.playSound(SoundType::BUTTON_HOVER, false);
+        }
+        if (!wasPlayersHovered && playersButton.isHovered) {
+            audioManager.playSound(SoundType::BUTTON_HOVER, false);
+        }
+        if (!wasAudioHovered && audioSettingsButton.isHovered) { 
+            audioManager.playSound(SoundType::BUTTON_HOVER, false);
+        }
+
+        // 按钮点击处理
+        if (inputFrame.wasPressed(KEY_MOUSE_LEFT)) {
+            if (startButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                currentState = PLAYING;
+                audioManager.onGameStart();
+                resetGame();
+            }
+            else if (helpButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                currentState = HELP;
+            }
+            else if (audioSettingsButton.isHovered) {
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                currentState = AUDIO_SETTINGS;
+            }
+            else if (playersButton.isHovered) {
+                // 1~MAX_LOCAL_PLAYERS循环切换
+                audioManager.playSound(SoundType::BUTTON_CLICK, false);
+                setPlayerCount(playerCount % MAX_LOCAL_PLAYERS + 1);
+            }
+        }
+
+        // 键盘快捷键
+        if (inputFrame.wasPressed(KEY_SPACE)) {
+            currentState = PLAYING;
+            audioManager.onGameStart();
+            resetGame();
+        }
+
+        if (inputFrame.wasPressed(KEY_HELP)) {
+            audioManager.playSound(SoundType::BUTTON_CLICK, false);
+            currentState = HELP;
+        }
+
+        if (inputFrame.wasPressed(KEY_AUDIO_SETTINGS)) {
+            audioManager.playSound(SoundType::BUTTON_CLICK, false);
+            currentState = AUDIO_SETTINGS;
+        }
+
+        if (inputFrame.wasPressed(KEY_ESCAPE)) {
+            audioManager.cleanup();
+            quitRequested = true;
+        }
+    }
+
+    void updateHelp() {
+        // 向上滚动
+        if (inputFrame.wasPressed(KEY_UP) || inputFrame.wasPressed(KEY_PAGE_UP)) {
+            float scrollAmount = inputFrame.wasPressed(KEY_UP) ? HELP_SCROLL_SPEED * 0.5f : HELP_SCROLL_SPEED;
+            helpScrollOffset -= scrollAmount;
+            if (helpScrollOffset < 0) helpScrollOffset = 0;
+        }
+
+        // 向下滚动
+        if (inputFrame.wasPressed(KEY_DOWN) || inputFrame.wasPressed(KEY_PAGE_DOWN)) {
+            float scrollAmount = inputFrame.wasPressed(KEY_DOWN) ? HELP_SCROLL_SPEED * 0.5f : HELP_SCROLL_SPEED;
+            helpScrollOffset += scrollAmount;
+            // 重要：确保 maxHelpScrollOffset 在绘制时正确计算
+            if (maxHelpScrollOffset > 0 && helpScrollOffset > maxHelpScrollOffset) {
+                helpScrollOffset = maxHelpScrollOffset;
+            }
+        }
+
+        // 更新返回按钮悬停状态
+        bool wasBackHovered = backButton.isHovered;
+        Button fixedBackButton = backButton;
+        fixedBackButton.y = WINDOW_HEIGHT - 80;
+        backButton.isHovered = fixedBackButton.isPointInside(mouseX, mouseY);
+
+        // 播放悬停音效
+        if (!wasBackHovered && backButton.isHovered) {
+            audioManager.playSound(SoundType::BUTTON_HOVER, false);
+        }
+
+        // 返回菜单
+        if (inputFrame.wasPressed(KEY_BACKSPACE) ||
+            (inputFrame.wasPressed(KEY_MOUSE_LEFT) && backButton.isHovered)) {
+            audioManager.playSound(SoundType::BUTTON_CLICK, false); 
+            currentState = MENU;
+            audioManager.onMenuEnter();
+            helpScrollOffset = 0.0f;
+        }
+    }
+
+    void updateCamera(PlayerSlot& slot, float deltaTime) {
+        const Player& player = slot.player;
+        float& smoothCameraSpeed = slot.smoothCameraSpeed;
+        float playerScreenY = player.getY() - slot.cameraY;
+        float screenCenterY = WINDOW_HEIGHT / 2.0f;
+
+        if (playerScreenY < screenCenterY - cameraDeadZone) {
+            slot.cameraTargetY = player.getY() - screenCenterY;
+
+            // 计算当前高度和难度
+            float currentHeight = initialPlayerY - player.getY();
+            float difficultyFactor = std::min(1.0f, currentHeight / 1000.0f); // 1000像素内达到最大难度
+
+            // 平滑的镜头速度增长
+            float targetCameraSpeed = cameraSpeed + difficultyFactor * cameraSpeedAcceleration;
+            targetCameraSpeed = std::min(targetCameraSpeed, maxSafeCameraSpeed);
+
+            // 使用指数平滑来过渡镜头速度（按步长求混合系数，与帧率无关）
+            smoothCameraSpeed += (targetCameraSpeed - smoothCameraSpeed) *
+                Smoothing::blendFactor(CAMERA_SPEED_BLEND_RATE, deltaTime);
+
+            // 临界阻尼跟随目标：不越过目标，任意帧率下轨迹相同
+            float previousY = slot.cameraY;
+            Smoothing::criticalDamp(slot.cameraY, slot.cameraVelocity, slot.cameraTargetY, smoothCameraSpeed, deltaTime);
+
+            // 应用最大速度限制
+            float maxMovement = maxSafeCameraSpeed * deltaTime;
+            float cameraMovement = slot.cameraY - previousY;
+            if (std::abs(cameraMovement) > maxMovement) {
+                slot.cameraY = previousY + ((cameraMovement > 0) ? maxMovement : -maxMovement);
+            }
+            slot.cameraVelocity = std::max(-maxSafeCameraSpeed, std::min(slot.cameraVelocity, maxSafeCameraSpeed));
+        }
+        else {
+            // 玩家回到死区内时镜头停住
+            slot.cameraVelocity = 0;
+        }
+
+        /*if (camera_y < 0) camera_y = 0;*/
+    }
+
+    // 更新玩家垂直速度统计
+    void updatePlayerVerticalSpeedStats(PlayerSlot& slot, float deltaTime) {
+        slot.speedSampleTime += deltaTime;
+
+        // 每0.1秒采样一次玩家垂直速度
+        if (slot.speedSampleTime >= 0.1f) {
+            float currentPlayerY = slot.player.getY();
+            float verticalSpeed = (slot.lastY - currentPlayerY) / slot.speedSampleTime; // 向上为正
+
+            // 只记录向上的速度（跳跃时）
+            if (verticalSpeed > 0) {
+                slot.verticalSpeedSamples.add(verticalSpeed);
+                slot.averageVerticalSpeed = slot.verticalSpeedSamples.average();
+            }
+
+            slot.lastY = currentPlayerY;
+            slot.speedSampleTime = 0.0f;
+        }
+    }
+
+    void updateGame(float deltaTime) {
+        MemoryScope memoryScope(MEM_WORLD);
+
+        // 由真实时间算出各时间层本帧的步长，下面的游戏逻辑都按游戏层步长推进
+        clock.setScale(TIME_GAMEPLAY, getGameplayTimeScale());
+        clock.tick(deltaTime);
+        const float gameDeltaTime = clock.getDelta(TIME_GAMEPLAY);
+
+        // 无窗口模式下inputFrame始终为空，由模拟策略直接操作玩家
+        // 单人时保留A/D、方向键和空格，多人时每名玩家使用自己的一组按键
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            slot.player.applyInput(slots.size() == 1 ? inputFrame : inputFrame.forPlayer(slot.index));
+            slot.player.update(clock);
+            updateCamera(slot, gameDeltaTime);
+        }
+
+        updateWorldMovement(gameDeltaTime);
+
+        // 世界实体更新：动画、移动，然后移除落出最落后镜头下方的实体（磁场在收集金币时一起处理）
+        world.animate(gameDeltaTime);
+        world.move(gameDeltaTime);
+        world.expire(getTrailingCameraY() + WINDOW_HEIGHT + 200);
+
+        // 唤醒进入活动区的平台和金币，之后拼接的块中活动区以上的部分先休眠
+        world.setActiveTop(getActiveTop());
+
+        // 时间轮：道具效果到期、连击超时、障碍物寿命、破碎平台重生、障碍物生成
+        dispatchTimers();
+
+        // 更新背景滚动
+        background.update(gameDeltaTime, worldSpeed);
+
+        spliceReadyChunks();
+
+        // 添加障碍物和金币碰撞检测
+        checkObstacleCollisions();
+        checkCoinCollection(gameDeltaTime);
+
+        // 碰撞检测
+        checkCollisions();
+
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            slot.player.checkBounds(WINDOW_WIDTH, WINDOW_HEIGHT);
+
+            // 分数计算
+            updateScore(slot);
+        }
+
+        // 幽灵：记录本帧玩家状态，最佳一局推进到同一时刻
+        ghostRecorder.record(gameTime, slots[0].player);
+        ghostPlayer.advance(gameTime);
+
+        // 暂停检查（联机时无法单方面暂停）
+        if (!netplay && inputFrame.wasPressed(KEY_PAUSE)) {
+            audioManager.onGamePause();
+            currentState = PAUSED;
+        }
+
+        // 游戏结束检查：每名玩家单独出局，全部出局时结束
+        bool anyAlive = false;
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            checkPlayerOut(slot);
+            anyAlive = anyAlive || slot.alive;
+        }
+        if (!anyAlive) {
+            triggerGameOver();
+        }
+
+        drainEvents();
+    }
+
+    // 处理本帧的事件：统计属于模拟状态，回滚重算时同样要累计；音效、粒子和震动只在正常推进时播放，
+    // 回滚重算的帧已经播放过，无窗口模式没有观众
+    void drainEvents() {
+        bool present = !headless && !replaying;
+        for (const GameEvent& event : events) {
+            countEvent(event);
+            if (present) {
+                playEventSound(event);
+                showEventEffect(event);
+            }
+        }
+        events.clear();
+
+        if (present) {
+            for (auto& slot : slots) {
+                if (slot.alive) slot.player.updateSpeedTrail();
+            }
+        }
+    }
+
+    void countEvent(const GameEvent& event) {
+        if (event.type == EVENT_ITEM_PICKED) {
+            itemUsage[event.value]++;
+        }
+    }
+
+    void playEventSound(const GameEvent& event) {
+        switch (event.type) {
+        case EVENT_JUMPED:          audioManager.playSound(SoundType::JUMP, false); break;
+        case EVENT_LANDED:          audioManager.playSound(SoundType::LAND, false); break;
+        case EVENT_SPRING_BOUNCE:   audioManager.playSound(SoundType::SPRING_BOUNCE, false); break;
+        case EVENT_PLATFORM_BROKE:  audioManager.playSound(SoundType::PLATFORM_BREAK, false); break;
+        case EVENT_COIN_COLLECTED:  audioManager.playSound(SoundType::COIN_COLLECT, false); break;
+        case EVENT_COMBO:           audioManager.playSound(SoundType::COMBO_SOUND, false); break;
+        case EVENT_DAMAGED:
+            audioManager.playSound(SoundType::OBSTACLE_HIT, false);
+            audioManager.playSound(SoundType::DAMAGE_SOUND, false);
+            break;
+        case EVENT_ITEM_PICKED: {
+            const PowerUpDef& def = getPowerUpDef((ItemType)event.value);
+            if (def.hasSound) audioManager.playSound(def.sound, false);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void showEventEffect(const GameEvent& event) {
+        Player& player = slots[event.player].player;
+        switch (event.type) {
+        case EVENT_JUMPED:
+            player.createJumpParticles();
+            if (event.value > 1) player.createDoubleJumpParticles();
+            player.addScreenShake(1.5f);
+            break;
+        case EVENT_LANDED:
+            player.createLandingParticles();
+            player.addScreenShake(2.0f);
+            break;
+        case EVENT_COIN_COLLECTED:
+            player.createSpeedBoostEffect();    // 重用特效
+            player.addScreenShake(1.0f);
+            break;
+        case EVENT_DAMAGED:
+            player.addScreenShake(4.0f);
+            break;
+        case EVENT_COMBO:
+            player.createComboEffect();
+            break;
+        case EVENT_RESPAWNED:
+            player.createRespawnEffect();
+            player.addScreenShake(3.0f);
+            break;
+        case EVENT_ITEM_PICKED:
+            showItemEffect(player, getPowerUpDef((ItemType)event.value));
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 道具特效按数据表：持续效果的特效，加上一次性效果（治疗、金币）原有的特效
+    void showItemEffect(Player& player, const PowerUpDef& def) {
+        switch (def.visual) {
+        case VISUAL_SPEED:          player.createSpeedBoostEffect(); break;
+        case VISUAL_SHIELD:         player.createShieldActivateEffect(); break;
+        case VISUAL_INVINCIBILITY:  player.createInvincibilityEffect(); break;
+        default: break;
+        }
+        switch (def.instant) {
+        case INSTANT_HEAL:  player.createShieldActivateEffect(); break;
+        case INSTANT_COIN:  player.createSpeedBoostEffect(); break;
+        default: break;
+        }
+    }
+
+    void checkPlayerOut(PlayerSlot& slot) {
+        Player& player = slot.player;
+        if (player.getY() > slot.killZone || player.isDead()) {
+            if (player.canTakeDamage()) {
+                eliminatePlayer(slot, player.isDead() ? DEATH_OBSTACLE : DEATH_FELL);
+            }
+            else if (!player.isDead()) {
+                respawnPlayerToSafePlatform(slot);
+            }
+            else {
+                eliminatePlayer(slot, DEATH_OBSTACLE);
+            }
+        }
+    }
+
+    void eliminatePlayer(PlayerSlot& slot, DeathCause cause) {
+        slot.alive = false;
+        slot.deathCause = cause;
+        slot.survivalTime = gameTime;
+    }
+
+    void triggerGameOver() {
+        // 联机局可能因回滚而撤销结束，不写成绩
+        if (!netplay) {
+            saveGhost();
+            saveScores();
+        }
+        if (!replaying) {
+            audioManager.onGameOver();
+        }
+        currentState = GAME_OVER;
+    }
+
+    // 本局录像写完；比之前的最佳一局更高时替换幽灵文件（只有单人局录像）
+    void saveGhost() {
+        long long maxHeight = slots[0].maxHeight;
+        if (!ghostRecorder.finish(maxHeight)) return;
+
+        if (maxHeight > ghostPlayer.getMaxHeight()) {
+            ghostPlayer.close();    // 回放中的文件不能被替换
+            std::remove(GHOST_BEST_PATH);
+            std::rename(GHOST_RECORDING_PATH, GHOST_BEST_PATH);
+        }
+        else {
+            std::remove(GHOST_RECORDING_PATH);
+        }
+    }
+
+    // 本局各玩家的成绩写入存储，在resetGame清空分数之前调用
+    void saveScores() {
+        for (auto& slot : slots) {
+            slot.scoreRank = 0;
+            slot.personalBest = false;
+            if (!scoreStore.isOpen()) continue;
+
+            const Player& player = slot.player;
+            ScoreEntry entry;
+            entry.timestamp = (std::int64_t)time(nullptr);
+            entry.player = "P" + std::to_string(slot.index + 1);
+            entry.score = slot.score;
+            entry.maxHeight = slot.maxHeight;
+            entry.coins = player.getCoins();
+            entry.itemsCollected = player.getItemsCollected();
+            entry.maxCombo = player.getComboCount();
+            entry.survivalTime = slot.survivalTime;
+            entry.deathCause = (std::uint8_t)slot.deathCause;
+
+            const ScoreEntry* previousBest = scoreStore.getPlayerBest(entry.player);
+            slot.personalBest = previousBest == nullptr || slot.score > previousBest->score;
+            slot.scoreRank = scoreStore.submit(entry);
+        }
+    }
+
+    void resetRunStats() {
+        for (int i = 0; i <= INVINCIBILITY; i++) {
+            itemUsage[i] = 0;
+        }
+    }
+
+    // 重置时钟和时间轮，登记第一次障碍物生成
+    void resetClock() {
+        clock.reset();
+        clock.getTimers(TIME_GAMEPLAY).schedule(obstacleSpawnRate, TimerEvent{ TIMER_OBSTACLE_SPAWN, 0, 0 });
+    }
+
+    // 推进时间轮，把到期的定时分发给玩家、世界或障碍物生成
+    void dispatchTimers() {
+        firedTimers.clear();
+        clock.advanceTimers(firedTimers);
+        for (const TimerEvent& event : firedTimers) {
+            switch (event.kind) {
+            case TIMER_EFFECT_EXPIRED:
+            case TIMER_COMBO_TIMEOUT:
+                if (event.owner < slots.size()) {
+                    slots[event.owner].player.onTimer(event);
+                }
+                break;
+            case TIMER_OBSTACLE_EXPIRED:
+            case TIMER_PLATFORM_RESPAWN:
+                world.onTimer(event);
+                break;
+            case TIMER_OBSTACLE_SPAWN:
+                spawnObstacle();
+                break;
+            }
+        }
+    }
+
+    // 生成一个障碍物，并按当前难度登记下一次生成
+    void spawnObstacle() {
+        float difficulty = std::min(1.0f, gameTime / 60.0f);  // 1分钟内达到最大难度
+
+        // 根据难度调整生成率（更频繁），默认从4秒降到1秒
+        obstacleSpawnRate = std::max(tuning.obstacleMinSpawnInterval,
+            tuning.obstacleMaxSpawnInterval - difficulty * tuning.obstacleSpawnIntervalDrop);
+
+        // 优先使用分块预先随机好的类型和位置，用完时当场随机
+        PlannedObstacle planned;
+        if (!plannedObstacles.empty()) {
+            plannedObstacles.popFront(planned);
+        }
+        else {
+            planned.type = static_cast<ObstacleType>(Random::next() % 6);
+            planned.x = 50.0f + Random::next() % (WINDOW_WIDTH - 150);
+        }
+
+        // 在相机上方200像素处生成；多人时轮流选择仍在场的玩家
+        const PlayerSlot* target = &slots[0];
+        for (size_t i = 0; i < slots.size(); i++) {
+            const PlayerSlot& slot = slots[(obstacleSpawnCount + i) % slots.size()];
+            if (slot.alive) {
+                target = &slot;
+                break;
+            }
+        }
+        obstacleSpawnCount++;
+        float spawnY = target->cameraY - 200;
+
+        world.spawnObstacle(planned.x, spawnY, planned.type);
+        clock.getTimers(TIME_GAMEPLAY).schedule(obstacleSpawnRate, TimerEvent{ TIMER_OBSTACLE_SPAWN, 0, 0 });
+    }
+
+    // 收集仍在场玩家的碰撞框，供批量碰撞查询使用
+    size_t collectPlayerBoxes(PlayerBox* boxes, PlayerSlot** owners) {
+        size_t count = 0;
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            boxes[count] = slot.getBox();
+            owners[count] = &slot;
+            count++;
+        }
+        return count;
+    }
+
+    void checkObstacleCollisions() {
+        PlayerBox boxes[MAX_LOCAL_PLAYERS] = {};
+        PlayerSlot* owners[MAX_LOCAL_PLAYERS];
+        Entity hits[MAX_LOCAL_PLAYERS];
+        size_t count = collectPlayerBoxes(boxes, owners);
+        world.findObstacleHits(boxes, count, hits);
+
+        for (size_t i = 0; i < count; i++) {
+            if (hits[i] == NULL_ENTITY) continue;
+            Player& player = owners[i]->player;
+
+            // 如果障碍物被冻结，跳过伤害
+            if (player.hasObstaclesFrozen()) continue;
+
+            // 只有在可以受伤害时才造成伤害
+            if (player.canTakeDamage()) {
+                ObstacleType type;
+                int damage;
+                world.getObstacleInfo(hits[i], type, damage);
+                player.takeDamage(damage);
+                owners[i]->lastDamageObstacle = type;
+            }
+        }
+    }
+
+    void checkCoinCollection(float deltaTime) {
+        // 磁场吸附和拾取一起完成，本帧碰到的金币全部收集
+        CoinCollector collectors[MAX_LOCAL_PLAYERS];
+        PlayerSlot* owners[MAX_LOCAL_PLAYERS];
+        size_t count = 0;
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            const Player& player = slot.player;
+            collectors[count] = CoinCollector{ player.getX(), player.getY(), player.getWidth(), player.getHeight(),
+                player.hasMagneticFieldActive() ? player.getMagnetRadius() : 0.0f };
+            owners[count] = &slot;
+            count++;
+        }
+        world.collectCoins(collectors, count, deltaTime, coinPickups);
+
+        for (const CoinPickup& pickup : coinPickups) {
+            PlayerSlot& owner = *owners[pickup.collector];
+            int value = world.getRegistry().get<CoinState>(pickup.coin).value;
+            owner.player.collectCoin(value);
+            world.destroy(pickup.coin);
+            events.push(EVENT_COIN_COLLECTED, owner.index, value);
+        }
+    }
+
+    // 更新分数系统
+    void updateScore(PlayerSlot& slot) {
+        const Player& player = slot.player;
+
+        // 使用地面作为基准计算高度
+        float currentHeightFloat = initialPlayerY - player.getY();
+
+        // 确保高度为正值
+        if (currentHeightFloat < 0) currentHeightFloat = 0;
+
+        // 转换为 long long，避免精度损失
+        long long currentHeight = (long long)std::round(currentHeightFloat);
+
+        // 更新最大高度 - 确保没有上限
+        if (currentHeight > slot.maxHeight) {
+            slot.maxHeight = currentHeight;
+        }
+
+        // 总分数计算
+        long long heightScore = slot.maxHeight / 5;
+        long long bonusScore = player.getBonusScore();
+        long long comboBonus = player.getComboCount() * 10;
+
+        slot.score = heightScore + bonusScore + comboBonus;
+    }
+
+    // 护盾复活逻辑
+    void respawnPlayerToSafePlatform(PlayerSlot& slot) {
+        Player& player = slot.player;
+        const PlayerSlot::LastPlatformInfo& lastSafePlatform = slot.lastSafePlatform;
+        if (lastSafePlatform.isValid) {
+            // 将玩家传送到最后的安全平台上
+            float respawnX = lastSafePlatform.x + lastSafePlatform.width / 2 - player.getWidth() / 2;
+            float respawnY = lastSafePlatform.y - player.getHeight();
+
+            player.setPosition(respawnX, respawnY);
+            player.setVY(0); // 停止下降
+            player.setOnGround(true);
+
+            events.push(EVENT_RESPAWNED, slot.index);
+
+            // 护盾消耗：复活后失去护盾
+            player.consumeShield();
+            
+        }
+        else {
+            // 如果没有记录的安全平台，传送到起始位置
+            positionPlayerOnStartPlatform(slot);
+            player.consumeShield();
+        }
+    }
+
+    void updateWorldMovement(float deltaTime) {
+        gameTime += deltaTime;
+
+        // 更新玩家垂直速度统计
+        // 世界只有一个下移速度：分数取领先者，限速取最慢的玩家，保证没有人被世界甩开
+        long long leadingScore = 0;
+        float slowestVerticalSpeed = 0;
+        for (auto& slot : slots) {
+            if (!slot.alive) continue;
+            updatePlayerVerticalSpeedStats(slot, deltaTime);
+            leadingScore = std::max(leadingScore, slot.score);
+            if (slot.averageVerticalSpeed > 0 &&
+                (slowestVerticalSpeed == 0 || slot.averageVerticalSpeed < slowestVerticalSpeed)) {
+                slowestVerticalSpeed = slot.averageVerticalSpeed;
+            }
+        }
+
+        // 基础速度增长（更温和）
+        float timeSpeedMultiplier = 1.0f + (gameTime / 60.0f) * tuning.worldSpeedTimeGrowth;
+        float scoreSpeedMultiplier = 1.0f + (leadingScore / 500.0f) * tuning.worldSpeedScoreGrowth;
+
+        // 计算目标世界速度
+        float targetWorldSpeed = baseWorldSpeed * timeSpeedMultiplier * scoreSpeedMultiplier;
+
+        // 确保世界速度不会过快，避免影响高度计算
+        if (slowestVerticalSpeed > 0) {
+            float maxAllowedWorldSpeed = slowestVerticalSpeed * 0.6f; // 降低到60%
+            targetWorldSpeed = std::min(targetWorldSpeed, maxAllowedWorldSpeed);
+        }
+
+        // 应用绝对上限
+        targetWorldSpeed = std::min(targetWorldSpeed, maxWorldSpeed);
+
+        // 临界阻尼过渡到目标速度：按步长精确求解，高刷新率下与60帧时一致
+        Smoothing::criticalDamp(worldSpeed, worldSpeedVelocity, targetWorldSpeed, worldSpeedSmoothing, deltaTime);
+        worldSpeed = std::max(worldSpeed, 0.0f);
+
+        // 更新死亡区域
+        for (auto& slot : slots) {
+            slot.killZone = slot.cameraY + WINDOW_HEIGHT + 100;
+        }
+
+        // 平台、障碍物和金币随世界下移
+        world.scroll(worldSpeed * deltaTime);
+
+        nextChunkBaseY += worldSpeed * deltaTime;
+    }
+
+    void updatePause() {
+        if (inputFrame.wasPressed(KEY_PAUSE)) {
+            audioManager.onGameResume();
+            currentState = PLAYING;
+        }
+
+        if (inputFrame.wasPressed(KEY_ESCAPE)) {
+            audioManager.onMenuEnter();
+            currentState = MENU;
+        }
+    }
+
+    void updateGameOver() {
+        if (inputFrame.wasPressed(KEY_SPACE)) {
+            currentState = MENU;
+        }
+
+        if (inputFrame.wasPressed(KEY_ESCAPE)) {
+            quitRequested = true;
+        }
+    }
+
+    void checkCollisions() {
+        PlayerBox boxes[MAX_LOCAL_PLAYERS] = {};
+        PlayerSlot* owners[MAX_LOCAL_PLAYERS];
+        Entity hits[MAX_LOCAL_PLAYERS];
+        size_t count = collectPlayerBoxes(boxes, owners);
+        world.findLandingPlatforms(boxes, count, hits);
+
+        for (size_t i = 0; i < count; i++) {
+            landPlayer(*owners[i], hits[i]);
+        }
+    }
+
+    void landPlayer(PlayerSlot& slot, Entity platform) {
+        Player& player = slot.player;
+        if (platform == NULL_ENTITY) {
+            player.setOnGround(false);
+            return;
+        }
+
+        const Transform& transform = world.getRegistry().get<Transform>(platform);
+        const Bounds& bounds = world.getRegistry().get<Bounds>(platform);
+        PlatformType type = world.getRegistry().get<PlatformState>(platform).type;
+        float platformTop = transform.y;
+
+        // 计算碰撞后的位置
+        float newY = platformTop - player.getHeight();
+
+        // 处理平台特殊效果
+        float playerVY = player.getVY();
+        world.landOnPlatform(platform, slot.index, playerVY);
+
+        // 检查是否是弹簧平台触发
+        bool isSpringTriggered = type == SPRING && playerVY < 0;
+
+        player.setPosition(player.getX(), newY);
+        player.setVY(playerVY);
+
+        // 记录最后接触的安全平台（只记录普通平台和弹簧平台）
+        if (type == NORMAL || type == SPRING) {
+            slot.rememberSafePlatform(transform, bounds);
+        }
+
+        // 弹簧触发时给玩家一个短暂的地面状态，然后立即弹起（让Player的update方法处理）
+        if (isSpringTriggered) {
+            player.addBonusScore(25);
+        }
+
+        // 收集道具 - 恢复所有道具类型处理
+        ItemState item;
+        if (world.takePlatformItem(platform, item)) {
+            player.applyItem(item.type, item.value);
+        }
+
+        // 设置地面状态，并更新combo系统
+        player.setOnGround(true);
+        player.updateComboSystem(platformTop);
+    }
+
+    void resetGame() {
+        // 按选定的玩家数重建玩家；分数、镜头、速度统计随PlayerSlot一起重置
+        // 一次预留全部名额：扩容时复制的玩家不带粒子列表的预留容量
+        slots.clear();
+        slots.reserve(MAX_LOCAL_PLAYERS);
+        for (int i = 0; i < playerCount; i++) {
+            slots.emplace_back(i, clock.getTimers(TIME_GLOBAL), events);
+        }
+        for (auto& slot : slots) {
+            slot.reset();
+        }
+        gameTime = 0;
+        worldSpeed = 0;
+        worldSpeedVelocity = 0;
+
+        // 重置障碍物和金币系统（世界实体在initializePlatforms中清空）
+        obstacleSpawnRate = tuning.obstacleInitialSpawnRate;
+        obstacleSpawnCount = 0;
+        resetClock();
+        resetRunStats();
+
+        initializePlatforms();
+        positionPlayersOnStartPlatform();
+
+        // 保持使用地面作为基准
+        initialPlayerY = WINDOW_HEIGHT - 40;  // 地面平台的顶部
+
+        for (auto& slot : slots) {
+            slot.lastY = slot.player.getY();
+            slot.killZone = slot.player.getY() + 300.0f;
+        }
+        events.clear();     // 摆放玩家时的着陆不算作本局的事件
+
+        // 幽灵竞速只在单人局中进行
+        ghostRecorder.discard();
+        ghostPlayer.close();
+        if (!headless && slots.size() == 1) {
+            ghostPlayer.open(GHOST_BEST_PATH);
+            ghostRecorder.start(GHOST_RECORDING_PATH);
+        }
+    }
+
+    // 绘制部分定义在GameDraw.cpp，依赖图形库，无界面的构建不编译
+    void render();
+
+    // 分屏视口：每个视口显示完整的WINDOW_WIDTH×WINDOW_HEIGHT画面并缩小一半，排成2×2；
+    // 两名玩家时左右并排、上下居中
+    void getViewport(int index, int& viewX, int& viewY) const {
+        viewX = (index % 2) * (WINDOW_WIDTH / 2);
+        viewY = slots.size() <= 2 ? WINDOW_HEIGHT / 4 : (index / 2) * (WINDOW_HEIGHT / 2);
+    }
+
+    void drawViews();
+    void drawMenu();
+    void drawHelp();
+    void drawButton(const Button& button, COLORREF normalColor, COLORREF hoverColor, COLORREF textColor);
+    void drawGame(PlayerSlot& slot, float shakeX = 0, float shakeY = 0);
+    void drawGameUI(const PlayerSlot& slot);
+    void drawPause();
+    void drawGameOver();
+
+    // 单人结算：本局的详细统计和评级
+    void drawRunStats(const PlayerSlot& slot, int statCenterX, int statY, int lineHeight);
+
+    // 多人结算：按得分排出名次，每名玩家一行
+    void drawPlayerResults(int statCenterX, int statY, int lineHeight);
+
+    // 排行榜：前LEADERBOARD_ROWS名，本局上榜时高亮
+    void drawLeaderboard(const vector<ScoreEntry>& topScores, int left, int top, int right);
+};
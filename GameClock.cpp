@@ -0,0 +1,189 @@
+#include "GameClock.h"
+#include <cmath>
+#include <stdexcept>
+
+const float TimerWheel::TICK_SECONDS = 1.0f / 60.0f;
+
+TimerWheel::TimerWheel() : nodes(CAPACITY), growCount(0) {
+    for (int i = 0; i < CAPACITY; i++) {
+        nodes[i].version = 0;
+    }
+    clear();
+}
+
+void TimerWheel::clear() {
+    // 所有节点连成空闲链表，版本号递增使旧句柄失效；扩容过的节点池保留现有大小
+    const int count = (int)nodes.size();
+    for (int i = 0; i < count; i++) {
+        nodes[i].next = (std::uint16_t)(i + 1 < count ? i + 1 : NIL);
+        nodes[i].prev = NIL;
+        nodes[i].deadline = 0;
+        nodes[i].pending = false;
+        nodes[i].version = (std::uint16_t)(nodes[i].version + 1 == 0 ? 1 : nodes[i].version + 1);
+    }
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        heads[i] = NIL;
+    }
+    freeHead = 0;
+    pendingCount = 0;
+    currentTick = 0;
+    accumulator = 0.0f;
+}
+
+bool TimerWheel::isLive(TimerHandle handle) const {
+    std::uint32_t index = handle & 0xFFFF;
+    return handle != NULL_TIMER && index < nodes.size() &&
+        nodes[index].version == (handle >> 16) && nodes[index].pending;
+}
+
+void TimerWheel::unlink(std::uint16_t index) {
+    Node& node = nodes[index];
+    if (node.prev == NIL) {
+        heads[node.deadline & (SLOT_COUNT - 1)] = node.next;
+    }
+    else {
+        nodes[node.prev].next = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    }
+}
+
+void TimerWheel::release(std::uint16_t index) {
+    Node& node = nodes[index];
+    node.version = (std::uint16_t)(node.version + 1 == 0 ? 1 : node.version + 1);
+    node.pending = false;
+    node.prev = NIL;
+    node.next = freeHead;
+    freeHead = index;
+    pendingCount--;
+}
+
+void TimerWheel::grow() {
+    // 新节点接成空闲链表；已有节点的下标不变，未到期的句柄继续有效
+    const int oldCount = (int)nodes.size();
+    if (oldCount >= MAX_CAPACITY) {
+        throw std::length_error("TimerWheel: too many pending timers");
+    }
+    const int newCount = oldCount * 2 < MAX_CAPACITY ? oldCount * 2 : MAX_CAPACITY;
+    nodes.resize(newCount);
+    for (int i = oldCount; i < newCount; i++) {
+        nodes[i].next = (std::uint16_t)(i + 1 < newCount ? i + 1 : NIL);
+        nodes[i].prev = NIL;
+        nodes[i].deadline = 0;
+        nodes[i].pending = false;
+        nodes[i].version = 1;
+    }
+    freeHead = (std::uint16_t)oldCount;
+    growCount++;
+}
+
+TimerHandle TimerWheel::schedule(float delaySeconds, const TimerEvent& event) {
+    if (freeHead == NIL) {
+        grow();
+    }
+
+    std::uint16_t index = freeHead;
+    Node& node = nodes[index];
+    freeHead = node.next;
+    pendingCount++;
+
+    // 从当前tick算起，向上取整；-0.001容忍浮点误差，正好整数个tick的延迟不会多等一个tick
+    int ticks = (int)std::ceil(delaySeconds / TICK_SECONDS - 0.001f);
+    if (ticks < 1) ticks = 1;
+
+    node.event = event;
+    node.deadline = currentTick + (std::uint32_t)ticks;
+    node.pending = true;
+
+    std::uint16_t& head = heads[node.deadline & (SLOT_COUNT - 1)];
+    node.next = head;
+    node.prev = NIL;
+    if (head != NIL) {
+        nodes[head].prev = index;
+    }
+    head = index;
+
+    return ((TimerHandle)node.version << 16) | index;
+}
+
+TimerHandle TimerWheel::reschedule(TimerHandle handle, float delaySeconds, const TimerEvent& event) {
+    cancel(handle);
+    return schedule(delaySeconds, event);
+}
+
+void TimerWheel::cancel(TimerHandle handle) {
+    if (!isLive(handle)) return;
+
+    std::uint16_t index = (std::uint16_t)(handle & 0xFFFF);
+    unlink(index);
+    release(index);
+}
+
+float TimerWheel::timeLeft(TimerHandle handle) const {
+    if (!isLive(handle)) return 0.0f;
+
+    const Node& node = nodes[handle & 0xFFFF];
+    float seconds = (node.deadline - currentTick) * TICK_SECONDS - accumulator;
+    return seconds > 0.0f ? seconds : 0.0f;
+}
+
+void TimerWheel::advance(float deltaTime, std::vector<TimerEvent>& fired) {
+    accumulator += deltaTime;
+    while (accumulator >= TICK_SECONDS) {
+        accumulator -= TICK_SECONDS;
+        currentTick++;
+
+        // 只检查当前tick对应的槽，其中尚未转到到期那一圈的定时留到下一圈
+        std::uint16_t index = heads[currentTick & (SLOT_COUNT - 1)];
+        while (index != NIL) {
+            std::uint16_t next = nodes[index].next;
+            if ((std::int32_t)(nodes[index].deadline - currentTick) <= 0) {
+                fired.push_back(nodes[index].event);
+                unlink(index);
+                release(index);
+            }
+            index = next;
+        }
+    }
+}
+
+// ---- GameClock ----
+
+GameClock::GameClock() {
+    reset();
+}
+
+void GameClock::reset() {
+    for (int i = 0; i < TIME_LAYER_COUNT; i++) {
+        scales[i] = 1.0f;
+        deltas[i] = 0.0f;
+        timers[i].clear();
+    }
+}
+
+TimeLayer GameClock::getParent(TimeLayer layer) {
+    static const TimeLayer PARENTS[TIME_LAYER_COUNT] = { TIME_GLOBAL, TIME_GLOBAL, TIME_GLOBAL };
+    return PARENTS[layer];
+}
+
+float GameClock::getEffectiveScale(TimeLayer layer) const {
+    float scale = scales[layer];
+    while (layer != TIME_GLOBAL) {
+        layer = getParent(layer);
+        scale *= scales[layer];
+    }
+    return scale;
+}
+
+void GameClock::tick(float realDeltaTime) {
+    for (int i = 0; i < TIME_LAYER_COUNT; i++) {
+        deltas[i] = realDeltaTime * getEffectiveScale((TimeLayer)i);
+    }
+}
+
+void GameClock::advanceTimers(std::vector<TimerEvent>& fired) {
+    for (int i = 0; i < TIME_LAYER_COUNT; i++) {
+        timers[i].advance(deltas[i], fired);
+    }
+}
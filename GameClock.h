@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// 定时事件的类型，到期后由Game分发给对应的玩家、世界或Game自身
+enum TimerKind : std::uint8_t {
+    TIMER_EFFECT_EXPIRED,       // 道具效果到期：owner为玩家序号，data为ItemType
+    TIMER_COMBO_TIMEOUT,        // 连击超时：owner为玩家序号
+    TIMER_OBSTACLE_EXPIRED,     // 障碍物寿命到期：data为实体
+    TIMER_PLATFORM_RESPAWN,     // 破碎平台重生：data为实体
+    TIMER_OBSTACLE_SPAWN        // 生成下一个障碍物
+};
+
+struct TimerEvent {
+    TimerKind kind;
+    std::uint8_t owner;
+    std::uint32_t data;
+};
+
+// 定时句柄：高16位为版本号，低16位为节点下标；到期或取消后版本号递增，旧句柄随之失效
+typedef std::uint32_t TimerHandle;
+const TimerHandle NULL_TIMER = 0;
+
+// 时间轮：按固定的tick推进，每个tick只检查一个槽，定时到期在O(1)内触发，
+// 不需要每个对象每帧递减自己的计时器。超过一圈的定时留在槽中，转到到期那一圈时才触发。
+// 节点池预留固定容量，同时存在的定时在此之内时不访问堆；用尽时扩容一倍并计数，不会丢弃定时。
+// 快照复制时目标的容量已足够，直接覆盖不再分配
+class TimerWheel {
+public:
+    static const int SLOT_COUNT = 64;           // 2的幂，一圈约1.07秒
+    static const int CAPACITY = 256;            // 预留容量：同时存在的定时数在此之内时节点池不再扩容
+    static const int MAX_CAPACITY = 0xFFFF;     // 句柄的节点下标只有16位，超过时抛出异常
+    static const float TICK_SECONDS;
+
+private:
+    static const std::uint16_t NIL = 0xFFFF;
+
+    struct Node {
+        TimerEvent event;
+        std::uint32_t deadline;         // 到期的tick
+        std::uint16_t next, prev;       // 所在槽（或空闲链表）中的双向链表，槽头的prev为NIL
+        std::uint16_t version;
+        bool pending;
+    };
+
+    std::vector<Node> nodes;
+    std::uint16_t heads[SLOT_COUNT];
+    std::uint16_t freeHead;
+    int pendingCount;
+    int growCount;                      // 节点池扩容的次数，非零说明CAPACITY偏小
+    std::uint32_t currentTick;
+    float accumulator;                  // 不足一个tick的剩余时间
+
+    bool isLive(TimerHandle handle) const;
+    void unlink(std::uint16_t index);
+    void release(std::uint16_t index);
+    void grow();
+
+public:
+    TimerWheel();
+
+    // 清空所有定时，之前的句柄全部失效
+    void clear();
+
+    // delaySeconds后触发event（向上取整到tick，至少一个tick）；节点用尽时先扩容，总能返回有效句柄
+    TimerHandle schedule(float delaySeconds, const TimerEvent& event);
+    // 取消handle并重新安排，返回新句柄
+    TimerHandle reschedule(TimerHandle handle, float delaySeconds, const TimerEvent& event);
+    // 取消未到期的定时；句柄已失效时什么也不做
+    void cancel(TimerHandle handle);
+
+    bool isPending(TimerHandle handle) const { return isLive(handle); }
+    float timeLeft(TimerHandle handle) const;
+
+    // 推进deltaTime，把到期的事件按到期顺序追加到fired
+    void advance(float deltaTime, std::vector<TimerEvent>& fired);
+
+    std::uint32_t getTick() const { return currentTick; }
+    int getPendingCount() const { return pendingCount; }
+    int getGrowCount() const { return growCount; }
+};
+
+// 时间层级：GAMEPLAY和UI都是GLOBAL的子层，实际缩放为沿父层逐级相乘
+enum TimeLayer {
+    TIME_GLOBAL,        // 总时间（暂停、慢动作调试）
+    TIME_GAMEPLAY,      // 游戏世界：玩家物理、世界实体、障碍物生成与寿命、平台重生（时间减缓作用于此层）
+    TIME_UI,            // 界面表现：屏幕震动等
+    TIME_LAYER_COUNT
+};
+
+// 全局时钟：每帧由真实时间算出各层的时间步长，每层的时间轮按该层的步长推进。
+// 道具效果和连击登记在总时间上，时间减缓不会拉长它们（包括时间减缓自身）的实际时长
+class GameClock {
+private:
+    float scales[TIME_LAYER_COUNT];     // 各层相对父层的缩放
+    float deltas[TIME_LAYER_COUNT];     // 本帧各层的时间步长
+    TimerWheel timers[TIME_LAYER_COUNT];
+
+public:
+    GameClock();
+
+    void reset();
+
+    static TimeLayer getParent(TimeLayer layer);     // GLOBAL的父层是它自己
+
+    void setScale(TimeLayer layer, float scale) { scales[layer] = scale; }
+    float getScale(TimeLayer layer) const { return scales[layer]; }
+    float getEffectiveScale(TimeLayer layer) const;
+
+    // 开始新的一帧：按当前缩放计算各层步长
+    void tick(float realDeltaTime);
+    float getDelta(TimeLayer layer) const { return deltas[layer]; }
+
+    // 各层的时间轮按本帧该层的步长推进，到期事件按层序追加到fired
+    void advanceTimers(std::vector<TimerEvent>& fired);
+
+    TimerWheel& getTimers(TimeLayer layer) { return timers[layer]; }
+    const TimerWheel& getTimers(TimeLayer layer) const { return timers[layer]; }
+};
@@ -0,0 +1,1019 @@
+#include "Game.h"
+#include "DrawUtils.h"
+#include <graphics.h>
+#include <windows.h>
+
+// Game及其界面部件的绘制：只读模拟状态，依赖EasyX和Win32，只在Windows上编译
+
+void BackgroundScrolling::draw(float cameraY) {
+    for (const auto& layer : layers) {
+        float drawY = layer.y - cameraY;
+
+        // 绘制重复的背景层
+        for (int i = -2; i <= 3; i++) {
+            float layerY = drawY + i * layer.height;
+            if (layerY < WINDOW_HEIGHT + 50 && layerY > -layer.height - 50) {
+                setfillcolor(layer.color);
+                solidrectangle(0, (int)layerY, WINDOW_WIDTH, (int)(layerY + layer.height));
+            }
+        }
+    }
+}
+
+void PlatformPreview::draw(const World& world, float cameraY, FrameArena& arena) const {
+    FrameVector<PreviewPlatform> previews{ FrameAllocator<PreviewPlatform>(arena) };
+    previews.reserve(RESERVED);
+    collect(world, cameraY, previews);
+
+    for (const auto& preview : previews) {
+        float drawY = preview.y - cameraY;
+
+        COLORREF previewColor;
+        switch (preview.type) {
+        case NORMAL: previewColor = Theme::PLATFORM_NORMAL; break;
+        case MOVING: previewColor = Theme::PLATFORM_MOVING; break;
+        case BREAKABLE: previewColor = Theme::PLATFORM_BREAKABLE; break;
+        case SPRING: previewColor = Theme::PLATFORM_SPRING; break;
+        }
+
+        // 绘制半透明预览
+        int r = (int)(GetRValue(previewColor) * preview.alpha);
+        int g = (int)(GetGValue(previewColor) * preview.alpha);
+        int b = (int)(GetBValue(previewColor) * preview.alpha);
+
+        setfillcolor(RGB(r, g, b));
+        setlinestyle(PS_DOT, 1);
+        setlinecolor(RGB(r, g, b));
+
+        rectangle((int)preview.x, (int)drawY,
+            (int)(preview.x + preview.width), (int)(drawY + 20));
+    }
+}
+
+void Game::drawAudioSettings() {
+    // 绘制背景
+    setbkcolor(Theme::BACKGROUND);
+    cleardevice();
+
+    // 绘制标题
+    settextcolor(RGB(255, 255, 255));
+    settextstyle(48, 0, L"Arial");
+    const wchar_t* title = L"Audio Settings";
+    int titleWidth = textwidth(title);
+    int titleX = (WINDOW_WIDTH - titleWidth) / 2;
+    outtextxy(titleX, 80, title);
+
+    // 绘制音频状态
+    settextstyle(24, 0, L"Arial");
+    const wchar_t* audioStatus = audioManager.isAudioEnabled() ? L"Audio: ON" : L"Audio: OFF";
+    COLORREF statusColor = audioManager.isAudioEnabled() ? RGB(0, 255, 0) : RGB(255, 0, 0);
+    settextcolor(statusColor);
+    int statusWidth = textwidth(audioStatus);
+    outtextxy((WINDOW_WIDTH - statusWidth) / 2, 150, audioStatus);
+
+    // 修改：调整音量条和文字布局，为按钮留出更多空间
+    settextcolor(RGB(255, 255, 255));
+    settextstyle(20, 0, L"Arial");
+
+    // 音量条的左右边距增加，为按钮留出空间
+    int volumeBarX = WINDOW_WIDTH / 2 - 150;  // 增加左边距
+    int volumeBarWidth = 300;  // 增加宽度
+    int volumeBarHeight = 20;
+
+    // 主音量 - 调整位置和间距
+    HudText masterVolumeText;
+    masterVolumeText << L"Master Volume: " << (int)(audioManager.getMasterVolume() * 100) << L"%";
+    int masterTextWidth = textwidth(masterVolumeText.c_str());
+    outtextxy((WINDOW_WIDTH - masterTextWidth) / 2, 240, masterVolumeText.c_str());  // 向上移动
+    drawVolumeBar(volumeBarX, 265, volumeBarWidth, volumeBarHeight, audioManager.getMasterVolume());
+
+    // 音乐音量 - 调整位置和间距
+    HudText musicVolumeText;
+    musicVolumeText << L"Music Volume: " << (int)(audioManager.getMusicVolume() * 100) << L"%";
+    int musicTextWidth = textwidth(musicVolumeText.c_str());
+    outtextxy((WINDOW_WIDTH - musicTextWidth) / 2, 300, musicVolumeText.c_str());  // 向上移动
+    drawVolumeBar(volumeBarX, 325, volumeBarWidth, volumeBarHeight, audioManager.getMusicVolume());
+
+    // 音效音量 - 调整位置和间距
+    HudText sfxVolumeText;
+    sfxVolumeText << L"SFX Volume: " << (int)(audioManager.getSFXVolume() * 100) << L"%";
+    int sfxTextWidth = textwidth(sfxVolumeText.c_str());
+    outtextxy((WINDOW_WIDTH - sfxTextWidth) / 2, 360, sfxVolumeText.c_str());  // 向上移动
+    drawVolumeBar(volumeBarX, 385, volumeBarWidth, volumeBarHeight, audioManager.getSFXVolume());
+
+    // 绘制按钮 - 现在按钮位置已经调整，不会遮挡文字
+    drawButton(muteButton, RGB(100, 100, 100), RGB(150, 150, 150), RGB(255, 255, 255));
+    drawButton(masterVolumeDownButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(masterVolumeUpButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(musicVolumeDownButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(musicVolumeUpButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(sfxVolumeDownButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(sfxVolumeUpButton, RGB(80, 80, 80), RGB(120, 120, 120), RGB(255, 255, 255));
+    drawButton(backFromAudioButton, RGB(100, 100, 100), RGB(150, 150, 150), RGB(255, 255, 255));
+
+    // 绘制快捷键提示 - 向下移动以适应新布局
+    settextcolor(RGB(150, 150, 150));
+    settextstyle(16, 0, L"Arial");
+    static const wchar_t* const shortcuts[] = {
+        L"M: Toggle Mute",
+        L"N: Volume Down",
+        L"B: Volume Up",
+        L"Backspace: Return to Menu"
+    };
+
+    int shortcutY = 500;  // 向下移动
+    for (const wchar_t* shortcut : shortcuts) {
+        int shortcutWidth = textwidth(shortcut);
+        outtextxy((WINDOW_WIDTH - shortcutWidth) / 2, shortcutY, shortcut);
+        shortcutY += 20;
+    }
+}
+
+void Game::drawVolumeBar(int x, int y, int width, int height, float volume) {
+    // 背景
+    setfillcolor(RGB(50, 50, 50));
+    solidrectangle(x, y, x + width, y + height);
+
+    // 音量条
+    int volumeWidth = (int)(width * volume);
+    COLORREF volumeColor = RGB(0, 255, 0);
+    if (volume > 0.8f) volumeColor = RGB(255, 255, 0);
+    if (volume > 0.9f) volumeColor = RGB(255, 0, 0);
+
+    setfillcolor(volumeColor);
+    solidrectangle(x, y, x + volumeWidth, y + height);
+
+    // 边框
+    setlinecolor(RGB(200, 200, 200));
+    setlinestyle(PS_SOLID, 1);
+    rectangle(x, y, x + width, y + height);
+}
+
+void Game::render() {
+    MemoryScope memoryScope(MEM_UI);
+    BeginBatchDraw();
+
+    setbkcolor(Theme::BACKGROUND);
+    cleardevice();
+
+    switch (currentState) {
+    case MENU:
+        drawMenu();
+        break;
+    case HELP:        
+        drawHelp();
+        break;
+		case AUDIO_SETTINGS:
+        drawAudioSettings();
+			break;
+    case PLAYING:
+        drawViews();
+        break;
+    case PAUSED:
+        drawViews();
+        drawPause();
+        break;
+    case GAME_OVER:
+        drawViews();
+        drawGameOver();
+        break;
+    }
+
+    EndBatchDraw();
+    frameArena.reset();
+}
+
+void Game::drawViews() {
+    if (slots.size() == 1 || localView >= 0) {
+        PlayerSlot& slot = slots[localView >= 0 ? localView : 0];
+
+        // 应用屏幕震动（仅在游戏中）
+        float shakeX = 0, shakeY = 0;
+        if (currentState == PLAYING) {
+            slot.player.getShakeOffset(shakeX, shakeY);
+        }
+        drawGame(slot, shakeX, shakeY);
+        return;
+    }
+
+    for (auto& slot : slots) {
+        float shakeX = 0, shakeY = 0;
+        if (currentState == PLAYING && slot.alive) {
+            slot.player.getShakeOffset(shakeX, shakeY);
+        }
+
+        // 原点和裁剪区使用物理坐标，缩放之后视口内仍按整屏坐标绘制
+        int viewX, viewY;
+        getViewport(slot.index, viewX, viewY);
+        HRGN region = CreateRectRgn(viewX, viewY, viewX + WINDOW_WIDTH / 2, viewY + WINDOW_HEIGHT / 2);
+        setcliprgn(region);
+        DeleteObject(region);
+        setorigin(viewX, viewY);
+        setaspectratio(0.5f, 0.5f);
+
+        drawGame(slot, shakeX, shakeY);
+
+        setaspectratio(1.0f, 1.0f);
+        setorigin(0, 0);
+        setcliprgn(NULL);
+    }
+
+    // 视口分隔线
+    setlinecolor(Theme::PRIMARY_DARK);
+    setlinestyle(PS_SOLID, 3);
+    line(WINDOW_WIDTH / 2, 0, WINDOW_WIDTH / 2, WINDOW_HEIGHT);
+    if (slots.size() > 2) {
+        line(0, WINDOW_HEIGHT / 2, WINDOW_WIDTH, WINDOW_HEIGHT / 2);
+    }
+    setlinestyle(PS_SOLID, 1);
+}
+
+void Game::drawMenu() {
+    // 绘制背景渐变
+    for (int i = 0; i < WINDOW_HEIGHT; i++) {
+        float ratio = (float)i / WINDOW_HEIGHT;
+        COLORREF bgColor = DrawUtils::interpolateColor(
+            Theme::BACKGROUND,
+            DrawUtils::adjustBrightness(Theme::BACKGROUND, 0.8f),
+            ratio
+        );
+        setlinecolor(bgColor);
+        line(0, i, WINDOW_WIDTH, i);
+    }
+
+    // 绘制游戏标题
+    settextcolor(Theme::PRIMARY_DARK);
+    settextstyle(60, 0, L"Arial");
+    const wchar_t* title = L"Jump Game";
+    int titleWidth = textwidth(title);
+    int titleX = (WINDOW_WIDTH - titleWidth) / 2;
+
+    // 标题阴影
+    settextcolor(RGB(100, 100, 100));
+    outtextxy(titleX + 3, 120 + 3, title);
+
+    // 标题主体
+    settextcolor(Theme::PRIMARY);
+    outtextxy(titleX, 120, title);
+
+    // 绘制副标题
+    settextcolor(Theme::TEXT_SECONDARY);
+    settextstyle(20, 0, L"Arial");
+    const wchar_t* subtitle = L"A Challenging Platform Adventure";
+    int subtitleWidth = textwidth(subtitle);
+    int subtitleX = (WINDOW_WIDTH - subtitleWidth) / 2;
+    outtextxy(subtitleX, 200, subtitle);
+
+    // 绘制按钮
+    drawButton(startButton, Theme::PRIMARY, Theme::PRIMARY_LIGHT, RGB(255, 255, 255));
+    drawButton(helpButton, Theme::SECONDARY, Theme::PRIMARY_LIGHT, RGB(255, 255, 255));
+    drawButton(audioSettingsButton, RGB(100, 150, 200), RGB(150, 200, 255), RGB(255, 255, 255));
+    drawButton(playersButton, RGB(120, 170, 120), RGB(170, 220, 170), RGB(255, 255, 255));
+
+    // 绘制控制提示
+    settextcolor(Theme::TEXT_DISABLED);
+    settextstyle(16, 0, L"Arial");
+    static const wchar_t* const hints[] = {
+        L"Press SPACE or click Start to begin",
+        L"Press H or click Help for instructions",
+			L"Press V or click for Audio Settings",
+        L"Click Players for split screen: P1 A/D/W, P2 arrows, P3 J/L/I, P4 numpad 4/6/8",
+        L"Press ESC to exit"
+    };
+
+    int hintY = 580;
+    for (const wchar_t* hint : hints) {
+        int hintWidth = textwidth(hint);
+        int hintX = (WINDOW_WIDTH - hintWidth) / 2;
+        outtextxy(hintX, hintY, hint);
+        hintY += 25;
+    }
+
+    // 绘制版本信息
+    settextcolor(Theme::TEXT_DISABLED);
+    settextstyle(14, 0, L"Arial");
+    const wchar_t* version = L"Version 1.0 - EasyX Graphics";
+    int versionWidth = textwidth(version);
+    outtextxy(WINDOW_WIDTH - versionWidth - 20, WINDOW_HEIGHT - 30, version);
+}
+
+void Game::drawHelp() {
+    // 绘制背景
+    setbkcolor(Theme::BACKGROUND);
+    cleardevice();
+
+    // 创建滚动视口
+    int viewportY = -(int)helpScrollOffset;
+    int contentStartY = viewportY;
+
+    // 绘制标题
+    settextcolor(Theme::PRIMARY);
+    settextstyle(40, 0, L"Arial");
+    const wchar_t* title = L"Game Help";
+    int titleWidth = textwidth(title);
+    int titleX = (WINDOW_WIDTH - titleWidth) / 2;
+    if (contentStartY + 30 > -50 && contentStartY + 30 < WINDOW_HEIGHT + 50) {
+        outtextxy(titleX, contentStartY + 30, title);
+    }
+
+    // 绘制帮助内容
+    int startY = contentStartY + 100;
+    int lineHeight = 28;  // 增加行高
+    int sectionSpacing = 35;  // 增加段落间距
+    int currentY = startY;
+
+    // 游戏玩法说明
+    if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+        settextcolor(Theme::PRIMARY_DARK);
+        settextstyle(24, 0, L"Arial");
+        outtextxy(50, currentY, L"How to Play:");
+    }
+    currentY += 45;  // 增加标题后的间距
+
+    settextcolor(Theme::TEXT_PRIMARY);
+    settextstyle(16, 0, L"Arial");
+    static const wchar_t* const gameplayInstructions[] = {
+        L"• Use A/D or Arrow Keys to move left and right",
+        L"• Press SPACE to jump (supports double jump with power-up)",
+        L"• Collect items on platforms for special abilities",
+        L"• Avoid obstacles that fall from above",
+        L"• Build combo by jumping to higher platforms",
+        L"• Survive as long as possible and reach maximum height!"
+    };
+
+    for (const wchar_t* instruction : gameplayInstructions) {
+        if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+            outtextxy(70, currentY, instruction);
+        }
+        currentY += lineHeight;
+    }
+
+    currentY += sectionSpacing;
+
+    // 道具说明 - 改善排版
+    if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+        settextcolor(Theme::PRIMARY_DARK);
+        settextstyle(24, 0, L"Arial");
+        outtextxy(50, currentY, L"Power-ups:");
+    }
+    currentY += 45;
+
+    settextcolor(Theme::TEXT_PRIMARY);
+    settextstyle(16, 0, L"Arial");
+
+    // 道具信息结构
+    struct ItemInfo {
+        const wchar_t* name;
+        const wchar_t* description;
+        COLORREF color;
+    };
+
+    static const ItemInfo items[] = {
+        {L"Speed Boost", L"Increases movement speed for 5 seconds", Theme::ITEM_SPEED},
+        {L"Shield", L"Protects from damage and enables revival", Theme::ITEM_SHIELD},
+        {L"Double Jump", L"Enables triple jump for 10 seconds", Theme::ITEM_DOUBLE_JUMP},
+        {L"Slow Time", L"Slows down time for easier navigation", Theme::ITEM_SLOW_TIME},
+        {L"Magnetic Field", L"Attracts nearby coins automatically", Theme::ITEM_MAGNETIC_FIELD},
+        {L"Freeze Obstacles", L"Freezes all obstacles for 10 seconds", Theme::ITEM_FREEZE_OBSTACLES},
+        {L"Health Boost", L"Restores 2 health points instantly", Theme::ITEM_HEALTH_BOOST},
+        {L"Invincibility", L"Temporary immunity to all damage", Theme::ITEM_INVINCIBILITY},
+        {L"Coin", L"Increases score and currency", Theme::ITEM_COIN}
+    };
+
+    int col1X = 70;
+    int col2X = 620;  // 调整第二列位置
+    size_t itemsPerColumn = 5;
+    int itemLineHeight = 38;  // 增加道具间行高
+
+    for (size_t i = 0; i < sizeof(items) / sizeof(items[0]); i++) {
+        int drawX = (i < itemsPerColumn) ? col1X : col2X;
+        int drawY = currentY + (i % itemsPerColumn) * itemLineHeight;
+
+        if (drawY > -50 && drawY < WINDOW_HEIGHT + 50) {
+            // 绘制道具颜色指示器
+            setfillcolor(items[i].color);
+            solidcircle(drawX, drawY + 10, 8);  // 增大指示器
+
+            // 绘制道具名称
+            settextcolor(items[i].color);
+            settextstyle(16, 0, L"Arial");
+            outtextxy(drawX + 25, drawY, items[i].name);
+
+            // 绘制道具描述
+            settextcolor(Theme::TEXT_SECONDARY);
+            settextstyle(14, 0, L"Arial");
+            outtextxy(drawX + 25, drawY + 20, items[i].description);
+        }
+    }
+
+    currentY += itemsPerColumn * itemLineHeight + sectionSpacing;
+
+    // 障碍物说明
+    if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+        settextcolor(Theme::PRIMARY_DARK);
+        settextstyle(24, 0, L"Arial");
+        outtextxy(50, currentY, L"Obstacles:");
+    }
+    currentY += 45;
+
+    settextcolor(Theme::TEXT_PRIMARY);
+    settextstyle(16, 0, L"Arial");
+
+    static const wchar_t* const obstacles[] = {
+        L"• Spikes: Static ground hazards - 1 damage",
+        L"• Fireballs: Fall from above - 2 damage",
+        L"• Lasers: Move horizontally - 3 damage",
+        L"• Rotating Saws: Spin in place - 2 damage",
+        L"• Falling Rocks: Accelerate downward - 1 damage",
+        L"• Moving Walls: Slide across screen - 1 damage"
+    };
+
+    for (const wchar_t* obstacle : obstacles) {
+        if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+            outtextxy(70, currentY, obstacle);
+        }
+        currentY += lineHeight;
+    }
+
+    currentY += sectionSpacing;
+
+    // 平台类型说明
+    if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+        settextcolor(Theme::PRIMARY_DARK);
+        settextstyle(24, 0, L"Arial");
+        outtextxy(50, currentY, L"Platform Types:");
+    }
+    currentY += 45;
+
+    settextcolor(Theme::TEXT_PRIMARY);
+    settextstyle(16, 0, L"Arial");
+
+    static const wchar_t* const platformTypes[] = {
+        L"• Normal Platforms: Standard jumping platforms",
+        L"• Moving Platforms: Slide back and forth",
+        L"• Breakable Platforms: Break after being stepped on",
+        L"• Spring Platforms: Launch you higher when stepped on"
+    };
+
+    for (const wchar_t* platformType : platformTypes) {
+        if (currentY > -50 && currentY < WINDOW_HEIGHT + 50) {
+            outtextxy(70, currentY, platformType);
+        }
+        currentY += lineHeight;
+    }
+
+    currentY += sectionSpacing;
+
+    // 重新计算最大滚动偏移，确保正确性
+    int totalContentHeight = currentY + 150;  // 内容总高度
+    int availableHeight = WINDOW_HEIGHT - 160;  // 可用显示区域（减去固定按钮和提示的空间）
+    maxHelpScrollOffset = std::max(0.0f, (float)(totalContentHeight - availableHeight));
+
+    // 绘制返回按钮（固定位置，不受滚动影响）
+    Button fixedBackButton = backButton;
+    fixedBackButton.y = WINDOW_HEIGHT - 80;  // 固定在底部
+    drawButton(fixedBackButton, Theme::PRIMARY, Theme::PRIMARY_LIGHT, RGB(255, 255, 255));
+
+    // 绘制滚动指示器
+    if (maxHelpScrollOffset > 0) {
+        // 绘制滚动条
+        float scrollBarHeight = 200.0f;
+        float scrollBarY = 100.0f;
+        float scrollBarX = WINDOW_WIDTH - 20.0f;
+
+        // 滚动条背景
+        setfillcolor(RGB(200, 200, 200));
+        solidrectangle((int)scrollBarX, (int)scrollBarY, (int)scrollBarX + 10, (int)(scrollBarY + scrollBarHeight));
+
+        // 改进滚动条滑块计算
+        float contentRatio = (float)availableHeight / totalContentHeight;  // 可见内容比例
+        float thumbHeight = std::max(20.0f, scrollBarHeight * contentRatio);  // 滑块高度，最小20像素
+        float scrollProgress = helpScrollOffset / maxHelpScrollOffset;  // 滚动进度
+        float thumbY = scrollBarY + scrollProgress * (scrollBarHeight - thumbHeight);
+
+        setfillcolor(Theme::PRIMARY);
+        solidrectangle((int)scrollBarX, (int)thumbY, (int)scrollBarX + 10, (int)(thumbY + thumbHeight));
+
+        // 绘制滚动提示
+        settextcolor(Theme::TEXT_DISABLED);
+        settextstyle(14, 0, L"Arial");
+        outtextxy(WINDOW_WIDTH - 150, WINDOW_HEIGHT - 50, L"Use ↑↓ or PgUp/PgDn to scroll");
+    }
+
+    // 修改：更新底部提示文字
+    settextcolor(Theme::TEXT_DISABLED);
+    settextstyle(16, 0, L"Arial");
+    const wchar_t* backHint = L"Press Backspace or click Back to return to menu";  // 修改提示文字
+    int backHintWidth = textwidth(backHint);
+    int backHintX = (WINDOW_WIDTH - backHintWidth) / 2;
+    outtextxy(backHintX, WINDOW_HEIGHT - 30, backHint);
+}
+
+void Game::drawButton(const Button& button, COLORREF normalColor, COLORREF hoverColor, COLORREF textColor) {
+    // 只绘制在视口内的按钮
+    if (button.y < -button.height || button.y > WINDOW_HEIGHT) {
+        return;
+    }
+
+    // 选择颜色
+    COLORREF buttonColor = button.isHovered ? hoverColor : normalColor;
+
+    // 绘制按钮背景
+    DrawUtils::drawSoftShadowRect(button.x, button.y, button.width, button.height, 10, buttonColor, 3);
+
+    // 绘制按钮边框
+    setlinecolor(button.isHovered ? Theme::PRIMARY_LIGHT : Theme::PRIMARY_DARK);
+    setlinestyle(PS_SOLID, 2);
+    rectangle(button.x, button.y, button.x + button.width, button.y + button.height);
+
+    // 绘制按钮文字
+    settextcolor(textColor);
+    settextstyle(24, 0, L"Arial");
+    int textWidth = textwidth(button.text.c_str());
+    int textHeight = textheight(button.text.c_str());
+    int textX = button.x + (button.width - textWidth) / 2;
+    int textY = button.y + (button.height - textHeight) / 2;
+    outtextxy(textX, textY, button.text.c_str());
+
+    // 悬停时添加光晕效果
+    if (button.isHovered) {
+        DrawUtils::drawGlowRect(button.x - 2, button.y - 2, button.width + 4, button.height + 4,
+            Theme::PRIMARY_LIGHT, 0.3f);
+    }
+}
+
+void Game::drawGame(PlayerSlot& slot, float shakeX, float shakeY) {
+    float cameraY = slot.cameraY;
+
+    // 绘制背景滚动
+    background.draw(cameraY);
+
+    // 绘制平台预览
+    platformPreview.draw(world, cameraY, frameArena);
+
+    // 绘制平台
+    world.drawPlatforms(shakeX, -cameraY + shakeY, cameraY - 50, cameraY + WINDOW_HEIGHT + 50);
+
+    // 绘制最佳一局的幽灵（在玩家之下）
+    ghostPlayer.draw(shakeX, -cameraY + shakeY, slot.player.getWidth(), slot.player.getHeight(), WINDOW_HEIGHT);
+
+    // 绘制玩家：同一世界中的其他玩家在下，本视口的玩家在最上面
+    for (auto& other : slots) {
+        if (&other != &slot && other.alive) {
+            other.player.drawWithOffset(shakeX, -cameraY + shakeY);
+        }
+    }
+    if (slot.alive || slots.size() == 1) {
+        slot.player.drawWithOffset(shakeX, -cameraY + shakeY);
+    }
+
+    // 绘制障碍物
+    world.drawObstacles(shakeX, -cameraY + shakeY, cameraY - 100, cameraY + WINDOW_HEIGHT + 100);
+
+    // 绘制金币
+    world.drawCoins(shakeX, -cameraY + shakeY, cameraY - 50, cameraY + WINDOW_HEIGHT + 50);
+
+    // 绘制死亡线（增强特效）
+    float deathLineY = slot.killZone - cameraY;
+    if (deathLineY > 0 && deathLineY < WINDOW_HEIGHT + 100) {
+        // 计算危险强度
+        float dangerIntensity = 1.0f;
+        if (deathLineY < WINDOW_HEIGHT) {
+            dangerIntensity = 1.0f - (deathLineY / WINDOW_HEIGHT) * 0.5f;
+        }
+
+        // 使用DrawUtils.cpp中的drawDangerZone
+        DrawUtils::drawDangerZone(deathLineY, dangerIntensity);
+
+        // 额外的警告效果
+        if (deathLineY < WINDOW_HEIGHT - 50) {
+            // 屏幕边缘红色警告
+            COLORREF warningColor = AnimationUtils::colorFlash(RGB(255, 0, 0), RGB(255, 255, 255),
+                dangerIntensity * 0.3f);
+            setfillcolor(warningColor);
+            solidrectangle(0, 0, WINDOW_WIDTH, 5);
+            solidrectangle(0, WINDOW_HEIGHT - 5, WINDOW_WIDTH, WINDOW_HEIGHT);
+            solidrectangle(0, 0, 5, WINDOW_HEIGHT);
+            solidrectangle(WINDOW_WIDTH - 5, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+        }
+    }
+
+    drawGameUI(slot);
+}
+
+void Game::drawGameUI(const PlayerSlot& slot) {
+    const Player& player = slot.player;
+
+    // 绘制描边文字的辅助函数
+    auto drawTextWithOutline = [&](const wchar_t* text, int x, int y, COLORREF textColor) {
+        // 黑色描边
+        settextcolor(RGB(0, 0, 0));
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                if (dx != 0 || dy != 0) {
+                    outtextxy(x + dx, y + dy, text);
+                }
+            }
+        }
+        // 主文字
+        settextcolor(textColor);
+        outtextxy(x, y, text);
+        };
+
+    // 设置字体
+    settextstyle(22, 0, L"Arial");
+
+    // 左侧UI布局 - 所有信息都在左侧显示
+    int startX = 30;
+    int startY = 30;
+    int lineHeight = 30;
+
+    // 分数显示
+    HudText scoreText;
+    if (slots.size() > 1) {
+        scoreText << L"P" << slot.index + 1 << L"  ";
+    }
+    scoreText << L"Score: " << slot.score;
+    drawTextWithOutline(scoreText.c_str(), startX, startY, RGB(255, 255, 255));
+
+    // 高度显示
+    HudText heightText;
+    heightText << L"Height: " << slot.maxHeight;
+    drawTextWithOutline(heightText.c_str(), startX, startY + lineHeight, RGB(100, 200, 255));
+
+    // 道具收集数
+    HudText itemText;
+    itemText << L"Items: " << player.getItemsCollected();
+    drawTextWithOutline(itemText.c_str(), startX, startY + lineHeight * 2, RGB(255, 200, 100));
+
+    // 时间显示
+    HudText timeText;
+    timeText << L"Time: " << (int)gameTime << L"s";
+    drawTextWithOutline(timeText.c_str(), startX, startY + lineHeight * 3, RGB(200, 255, 200));
+
+    // 连击显示
+    if (player.getComboCount() > 1) {
+        HudText comboText;
+        comboText << L"Combo: " << player.getComboCount() << L"x";
+        COLORREF comboColor = DrawUtils::getComboColor(player.getComboCount());
+        drawTextWithOutline(comboText.c_str(), startX, startY + lineHeight * 4, comboColor);
+    }
+
+    // 生命值显示
+    settextstyle(18, 0, L"Arial");
+    int healthY = startY + lineHeight * 5;
+
+    // 绘制生命值背景
+    setfillcolor(RGB(50, 50, 50));
+    solidrectangle(startX, healthY, startX + 200, healthY + 25);
+
+    // 绘制生命值条
+    float healthPercentage = (float)player.getHealth() / player.getMaxHealth();
+    COLORREF healthColor;
+    if (healthPercentage > 0.6f) {
+        healthColor = RGB(0, 255, 0);
+    }
+    else if (healthPercentage > 0.3f) {
+        healthColor = RGB(255, 255, 0);
+    }
+    else {
+        healthColor = RGB(255, 0, 0);
+    }
+
+    setfillcolor(healthColor);
+    solidrectangle(startX + 5, healthY + 5,
+        (int)(startX + 5 + 190 * healthPercentage),
+        healthY + 20);
+
+    // 生命值文字
+    HudText healthText;
+    healthText << L"Health: " << player.getHealth() << L"/" << player.getMaxHealth();
+    drawTextWithOutline(healthText.c_str(), startX + 10, healthY + 6, RGB(255, 255, 255));
+
+    // 金币显示
+    HudText coinText;
+    coinText << L"Coins: " << player.getCoins();
+    drawTextWithOutline(coinText.c_str(), startX, healthY + 35, RGB(255, 215, 0));
+
+    // 道具状态显示 - 也在左侧
+    settextstyle(16, 0, L"Arial");
+    int effectY = healthY + 65;
+
+    for (int type = 0; type < ITEM_TYPE_COUNT; type++) {
+        const PowerUpDef& def = getPowerUpDef((ItemType)type);
+        if (def.hudLabel && player.hasEffect(def.type)) {
+            drawTextWithOutline(def.hudLabel, startX, effectY, def.hudColor);
+            effectY += 20;
+        }
+    }
+
+    // 控制提示 - 移到右下角
+    settextstyle(14, 0, L"Arial");
+    int controlX = WINDOW_WIDTH - 220;
+    int controlY = WINDOW_HEIGHT - 100;
+
+    const wchar_t* controls[] = {
+        L"A/D: Move",
+        L"SPACE: Jump",
+        L"P: Pause",
+        L"ESC: Exit"
+    };
+    if (slots.size() > 1 && !netplay) {  // 联机时本机玩家使用单人按键
+        static const wchar_t* playerControls[MAX_LOCAL_PLAYERS][2] = {
+            { L"A/D: Move", L"W: Jump" },
+            { L"Left/Right: Move", L"Up: Jump" },
+            { L"J/L: Move", L"I: Jump" },
+            { L"Num4/Num6: Move", L"Num8: Jump" }
+        };
+        controls[0] = playerControls[slot.index][0];
+        controls[1] = playerControls[slot.index][1];
+    }
+
+    for (size_t i = 0; i < sizeof(controls) / sizeof(controls[0]); i++) {
+        drawTextWithOutline(controls[i], controlX, controlY + (int)i * 18, Theme::TEXT_DISABLED);
+    }
+
+    // 多人时已出局的玩家在自己的视口中显示结果
+    if (!slot.alive && slots.size() > 1 && currentState == PLAYING) {
+        DrawUtils::drawSoftShadowRect(WINDOW_WIDTH / 2 - 200, WINDOW_HEIGHT / 2 - 60, 400, 120, 15, Theme::DANGER);
+        settextcolor(WHITE);
+        settextstyle(40, 0, L"Arial");
+        HudText outText;
+        outText << L"P" << slot.index + 1 << L" OUT";
+        outtextxy((WINDOW_WIDTH - textwidth(outText.c_str())) / 2, WINDOW_HEIGHT / 2 - 45, outText.c_str());
+
+        settextstyle(22, 0, L"Arial");
+        HudText resultText;
+        resultText << L"Score: " << slot.score << L"   Height: " << slot.maxHeight;
+        outtextxy((WINDOW_WIDTH - textwidth(resultText.c_str())) / 2, WINDOW_HEIGHT / 2 + 10, resultText.c_str());
+    }
+}
+
+void Game::drawPause() {
+    setfillcolor(DrawUtils::blendColor(RGB(0, 0, 0), RGB(255, 255, 255), 0.7f));
+    solidrectangle(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    DrawUtils::drawSoftShadowRect(WINDOW_WIDTH / 2 - 100, WINDOW_HEIGHT / 2 - 60, 200, 120, 15, Theme::PRIMARY);
+
+    settextcolor(WHITE);
+    settextstyle(30, 0, L"Arial");
+    const wchar_t* pauseText = L"PAUSED";
+    int pauseWidth = textwidth(pauseText);
+    int pauseX = (WINDOW_WIDTH - pauseWidth) / 2;
+    outtextxy(pauseX, WINDOW_HEIGHT / 2 - 30, pauseText);
+
+    settextstyle(16, 0, L"Arial");
+    settextcolor(Theme::PRIMARY_LIGHT);
+    const wchar_t* resumeText = L"P to resume";
+    int resumeWidth = textwidth(resumeText);
+    int resumeX = (WINDOW_WIDTH - resumeWidth) / 2;
+    outtextxy(resumeX, WINDOW_HEIGHT / 2 + 5, resumeText);
+
+    const wchar_t* menuText = L"ESC to return to menu";
+    int menuWidth = textwidth(menuText);
+    int menuX = (WINDOW_WIDTH - menuWidth) / 2;
+    outtextxy(menuX, WINDOW_HEIGHT / 2 + 30, menuText);
+}
+
+void Game::drawGameOver() {
+    // 半透明背景
+    setfillcolor(DrawUtils::blendColor(RGB(0, 0, 0), RGB(255, 255, 255), 0.8f));
+    solidrectangle(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    // 扩大结算面板；有历史成绩时右侧增加排行榜
+    const vector<ScoreEntry>& topScores = scoreStore.getTopScores();
+    bool showLeaderboard = !topScores.empty();
+    int panelWidth = showLeaderboard ? 820 : 450;
+    int panelHeight = showLeaderboard ? 460 : 400;
+    int panelX = WINDOW_WIDTH / 2 - panelWidth / 2;
+    int panelY = WINDOW_HEIGHT / 2 - panelHeight / 2;
+
+    // 绘制结算面板背景
+    DrawUtils::drawSoftShadowRect(panelX, panelY, panelWidth, panelHeight, 20, Theme::PRIMARY);
+
+    // 标题
+    settextcolor(WHITE);
+    settextstyle(45, 0, L"Arial");
+    const wchar_t* gameOverText = L"Game Over";
+    int gameOverWidth = textwidth(gameOverText);
+    int gameOverX = (WINDOW_WIDTH - gameOverWidth) / 2;
+    outtextxy(gameOverX, panelY + 30, gameOverText);
+
+    // 统计信息
+    settextstyle(22, 0, L"Arial");
+    settextcolor(Theme::PRIMARY_LIGHT);
+
+    int statY = panelY + 100;
+    int lineHeight = 35;
+    int statCenterX = showLeaderboard ? panelX + 225 : WINDOW_WIDTH / 2;
+
+    if (slots.size() > 1) {
+        drawPlayerResults(statCenterX, statY, lineHeight);
+    }
+    else {
+        drawRunStats(slots[0], statCenterX, statY, lineHeight);
+    }
+
+    if (showLeaderboard) {
+        drawLeaderboard(topScores, panelX + 470, statY, panelX + panelWidth - 30);
+    }
+
+    // 操作提示
+    settextstyle(24, 0, L"Arial");
+    settextcolor(Theme::WARNING);
+    const wchar_t* restartText = L"SPACE - Return to Menu";
+    int restartWidth = textwidth(restartText);
+    outtextxy((WINDOW_WIDTH - restartWidth) / 2, panelY + panelHeight - 60, restartText);
+
+    const wchar_t* exitText = L"ESC - Exit Game";
+    int exitWidth = textwidth(exitText);
+    outtextxy((WINDOW_WIDTH - exitWidth) / 2, panelY + panelHeight - 30, exitText);
+}
+
+void Game::drawRunStats(const PlayerSlot& slot, int statCenterX, int statY, int lineHeight) {
+    const Player& player = slot.player;
+    long long score = slot.score;
+    long long maxHeight = slot.maxHeight;
+
+    // 最终得分
+    HudText finalScoreText;
+    finalScoreText << L"Final Score: " << score;
+    int scoreWidth = textwidth(finalScoreText.c_str());
+    outtextxy(statCenterX - scoreWidth / 2, statY, finalScoreText.c_str());
+
+    // 最大高度
+    HudText maxHeightText;
+    maxHeightText << L"Max Height: " << maxHeight << L" pixels";
+    int heightWidth = textwidth(maxHeightText.c_str());
+    outtextxy(statCenterX - heightWidth / 2, statY + lineHeight, maxHeightText.c_str());
+
+    // 道具收集统计
+    HudText itemsText;
+    itemsText << L"Items Collected: " << player.getItemsCollected();
+    int itemsWidth = textwidth(itemsText.c_str());
+    outtextxy(statCenterX - itemsWidth / 2, statY + lineHeight * 2, itemsText.c_str());
+
+    // 存活时间
+    int minutes = (int)gameTime / 60;
+    int seconds = (int)gameTime % 60;
+    HudText survivalTimeText;
+    survivalTimeText << L"Survival Time: " << minutes << L":" << padded(seconds, 2);
+    int timeWidth = textwidth(survivalTimeText.c_str());
+    outtextxy(statCenterX - timeWidth / 2, statY + lineHeight * 3, survivalTimeText.c_str());
+
+    // 最高连击
+    HudText maxComboText;
+    maxComboText << L"Max Combo: " << player.getComboCount() << L"x";
+    int comboWidth = textwidth(maxComboText.c_str());
+    outtextxy(statCenterX - comboWidth / 2, statY + lineHeight * 4, maxComboText.c_str());
+
+    // 金币收集
+    HudText coinsText;
+    coinsText << L"Coins Collected: " << player.getCoins();
+    int coinsWidth = textwidth(coinsText.c_str());
+    outtextxy(statCenterX - coinsWidth / 2, statY + lineHeight * 5, coinsText.c_str());
+
+    // 评级系统
+    settextstyle(28, 0, L"Arial");
+    HudText rank;
+    rank << L"Rank: ";
+    COLORREF rankColor = RGB(255, 255, 255);
+
+    if (maxHeight >= 5000) {
+        rank << L"S+ Master";
+        rankColor = RGB(255, 215, 0);  // 金色
+    }
+    else if (maxHeight >= 3000) {
+        rank << L"A+ Expert";
+        rankColor = RGB(255, 100, 100);  // 红色
+    }
+    else if (maxHeight >= 1500) {
+        rank << L"B+ Advanced";
+        rankColor = RGB(100, 255, 100);  // 绿色
+    }
+    else if (maxHeight >= 800) {
+        rank << L"C+ Skilled";
+        rankColor = RGB(100, 100, 255);  // 蓝色
+    }
+    else {
+        rank << L"D Beginner";
+        rankColor = RGB(200, 200, 200);  // 灰色
+    }
+
+    settextcolor(rankColor);
+    int rankWidth = textwidth(rank.c_str());
+    outtextxy(statCenterX - rankWidth / 2, statY + lineHeight * 6, rank.c_str());
+}
+
+void Game::drawPlayerResults(int statCenterX, int statY, int lineHeight) {
+    // 按得分从高到低插入排序，同分时保持玩家顺序；最多MAX_LOCAL_PLAYERS名，不分配内存
+    const PlayerSlot* order[MAX_LOCAL_PLAYERS];
+    size_t count = 0;
+    for (const PlayerSlot& slot : slots) {
+        size_t i = count++;
+        while (i > 0 && order[i - 1]->score < slot.score) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = &slot;
+    }
+
+    settextstyle(28, 0, L"Arial");
+    settextcolor(RGB(255, 215, 0));
+    HudText winnerText;
+    winnerText << L"P" << order[0]->index + 1 << L" Wins!";
+    outtextxy(statCenterX - textwidth(winnerText.c_str()) / 2, statY, winnerText.c_str());
+
+    settextstyle(22, 0, L"Arial");
+    for (size_t i = 0; i < count; i++) {
+        const PlayerSlot& slot = *order[i];
+        settextcolor(i == 0 ? WHITE : Theme::PRIMARY_LIGHT);
+
+        int minutes = (int)slot.survivalTime / 60;
+        int seconds = (int)slot.survivalTime % 60;
+        HudText resultText;
+        resultText << i + 1 << L". P" << slot.index + 1 <<
+            L"   Score " << slot.score <<
+            L"   Height " << slot.maxHeight <<
+            L"   " << minutes << L":" << padded(seconds, 2);
+        outtextxy(statCenterX - textwidth(resultText.c_str()) / 2, statY + lineHeight * (int)(i + 1) + 10, resultText.c_str());
+    }
+
+    // 金币和道具按全体玩家合计
+    int coins = 0;
+    int items = 0;
+    for (const PlayerSlot& slot : slots) {
+        coins += slot.player.getCoins();
+        items += slot.player.getItemsCollected();
+    }
+    settextcolor(Theme::PRIMARY_LIGHT);
+    HudText totalsText;
+    totalsText << L"Coins: " << coins << L"   Items: " << items;
+    outtextxy(statCenterX - textwidth(totalsText.c_str()) / 2, statY + lineHeight * 6, totalsText.c_str());
+}
+
+void Game::drawLeaderboard(const vector<ScoreEntry>& topScores, int left, int top, int right) {
+    const size_t LEADERBOARD_ROWS = 5;
+    int rowHeight = 32;
+
+    settextstyle(26, 0, L"Arial");
+    settextcolor(WHITE);
+    bool newHighScore = false;
+    for (const PlayerSlot& slot : slots) {
+        if (slot.scoreRank == 1) newHighScore = true;
+    }
+    outtextxy(left, top, newHighScore ? L"New High Score!" : L"High Scores");
+
+    settextstyle(22, 0, L"Arial");
+    for (size_t i = 0; i < topScores.size() && i < LEADERBOARD_ROWS; i++) {
+        const ScoreEntry& entry = topScores[i];
+        int rowY = top + 45 + (int)i * rowHeight;
+
+        bool thisRun = false;
+        for (const PlayerSlot& slot : slots) {
+            if ((int)i + 1 == slot.scoreRank) thisRun = true;
+        }
+
+        if (thisRun) {
+            DrawUtils::drawTransparentRect(left - 8, rowY - 4, right - left + 16, rowHeight - 4, Theme::TEXT_COMBO, 0.35f);
+            settextcolor(WHITE);
+        }
+        else {
+            settextcolor(Theme::PRIMARY_LIGHT);
+        }
+
+        HudText rankText;
+        rankText << i + 1 << L". " << entry.player.c_str();
+        outtextxy(left, rowY, rankText.c_str());
+
+        HudText scoreText;
+        scoreText << entry.score;
+        outtextxy(right - textwidth(scoreText.c_str()), rowY, scoreText.c_str());
+    }
+
+    // 本局未进前几名时单独显示名次或个人最佳
+    settextstyle(20, 0, L"Arial");
+    settextcolor(Theme::WARNING);
+    int noteY = top + 45 + (int)LEADERBOARD_ROWS * rowHeight + 10;
+    HudText noteText;
+    for (const PlayerSlot& slot : slots) {
+        if (slot.scoreRank > (int)LEADERBOARD_ROWS) {
+            if (slots.size() > 1) noteText << L"P" << slot.index + 1 << L" ";
+            else noteText << L"This run: ";
+            noteText << L"#" << slot.scoreRank << L"  ";
+        }
+        else if (slot.scoreRank == 0 && slot.personalBest) {
+            if (slots.size() > 1) noteText << L"P" << slot.index + 1 << L" PB!  ";
+            else noteText << L"New personal best!";
+        }
+    }
+    if (!noteText.empty()) {
+        outtextxy(left, noteY, noteText.c_str());
+    }
+
+    settextcolor(Theme::PRIMARY_LIGHT);
+    const ScoreTotals& totals = scoreStore.getTotals();
+    HudText totalsText;
+    totalsText << L"Runs: " << totals.runs << L"   Coins: " << totals.coins;
+    outtextxy(left, noteY + 30, totalsText.c_str());
+}
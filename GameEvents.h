@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// 模拟中发生的事：碰撞和玩家逻辑只追加事件，音效、粒子、震动和统计在本帧模拟结束后统一处理
+enum GameEventType : std::uint8_t {
+    EVENT_JUMPED,           // value：本次是第几跳
+    EVENT_LANDED,
+    EVENT_SPRING_BOUNCE,
+    EVENT_PLATFORM_BROKE,
+    EVENT_COIN_COLLECTED,   // value：金币面值
+    EVENT_ITEM_PICKED,      // value：道具类型
+    EVENT_DAMAGED,          // value：伤害值，无敌期间的碰撞不产生
+    EVENT_COMBO,            // value：连击数
+    EVENT_RESPAWNED         // 护盾复活
+};
+
+struct GameEvent {
+    GameEventType type;
+    std::uint8_t player;    // 玩家序号
+    std::int32_t value;
+};
+
+// 一帧的事件：容量在构造时预留，追加不分配内存；超出预留时照常扩容
+class GameEventBuffer {
+private:
+    std::vector<GameEvent> events;
+
+public:
+    static const size_t RESERVED = 256;
+
+    GameEventBuffer() { events.reserve(RESERVED); }
+
+    void push(GameEventType type, int player, int value = 0) {
+        events.push_back(GameEvent{ type, (std::uint8_t)player, (std::int32_t)value });
+    }
+    void clear() { events.clear(); }
+
+    bool empty() const { return events.empty(); }
+    size_t size() const { return events.size(); }
+    const GameEvent* begin() const { return events.data(); }
+    const GameEvent* end() const { return events.data() + events.size(); }
+};
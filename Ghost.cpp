@@ -0,0 +1,272 @@
+#include "Ghost.h"
+#include "BinaryIO.h"
+#include "Player.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    std::vector<std::uint8_t> encodeHeader(const GhostHeader& header) {
+        std::vector<std::uint8_t> bytes;
+        BinaryIO::putU32(bytes, GhostHeader::MAGIC);
+        BinaryIO::putU32(bytes, GhostHeader::VERSION);
+        BinaryIO::putU32(bytes, header.sampleCount);
+        BinaryIO::putU32(bytes, header.durationMs);
+        BinaryIO::putU64(bytes, (std::uint64_t)header.maxHeight);
+        bytes.resize(GhostHeader::SIZE, 0);
+        return bytes;
+    }
+
+    bool decodeHeader(const std::uint8_t* in, GhostHeader& header) {
+        BinaryIO::Reader reader(in, GhostHeader::SIZE);
+        if (reader.u32() != GhostHeader::MAGIC || reader.u32() != GhostHeader::VERSION) {
+            return false;
+        }
+        header.sampleCount = reader.u32();
+        header.durationMs = reader.u32();
+        header.maxHeight = (std::int64_t)reader.u64();
+        return reader.good();
+    }
+
+    // 单块字节数上限，超出说明文件已损坏
+    const std::uint32_t MAX_CHUNK_BYTES = 64 * 1024;
+}
+
+GhostSample GhostSample::fromPlayer(float time, const Player& player) {
+    GhostSample sample;
+    sample.timeMs = (std::int32_t)std::lround(time * 1000.0f);
+    sample.x = (std::int32_t)std::lround(player.getX() * POSITION_SCALE);
+    sample.y = (std::int32_t)std::lround(player.getY() * POSITION_SCALE);
+
+    if (player.isOnGround()) sample.flags |= GHOST_ON_GROUND;
+    if (player.hasShield()) sample.flags |= GHOST_SHIELD;
+    if (player.hasInvincibilityActive()) sample.flags |= GHOST_INVINCIBLE;
+    if (player.hasSpeedBoost()) sample.flags |= GHOST_SPEED_BOOST;
+    return sample;
+}
+
+namespace GhostCodec {
+
+    void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back((std::uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((std::uint8_t)value);
+    }
+
+    bool readVarint(const std::uint8_t*& cursor, const std::uint8_t* end, std::uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (cursor >= end) return false;
+            std::uint8_t byte = *cursor++;
+            value |= (std::uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    void encodeSample(std::vector<std::uint8_t>& out, const GhostSample& previous, const GhostSample& sample) {
+        bool flagsChanged = sample.flags != previous.flags;
+
+        writeVarint(out, (std::uint32_t)(sample.timeMs - previous.timeMs));
+        writeVarint(out, (zigzag(sample.x - previous.x) << 1) | (flagsChanged ? 1u : 0u));
+        writeVarint(out, zigzag(sample.y - previous.y));
+        if (flagsChanged) {
+            out.push_back(sample.flags);
+        }
+    }
+
+    bool decodeSample(const std::uint8_t*& cursor, const std::uint8_t* end, const GhostSample& previous, GhostSample& sample) {
+        std::uint32_t deltaTime, deltaX, deltaY;
+        if (!readVarint(cursor, end, deltaTime) || !readVarint(cursor, end, deltaX) || !readVarint(cursor, end, deltaY)) {
+            return false;
+        }
+
+        sample.timeMs = previous.timeMs + (std::int32_t)deltaTime;
+        sample.x = previous.x + unzigzag(deltaX >> 1);
+        sample.y = previous.y + unzigzag(deltaY);
+        sample.flags = previous.flags;
+        if (deltaX & 1u) {
+            if (cursor >= end) return false;
+            sample.flags = *cursor++;
+        }
+        return true;
+    }
+}
+
+GhostRecorder::GhostRecorder() : chunkSamples(0) {
+}
+
+bool GhostRecorder::start(const std::string& path) {
+    discard();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    // 先写占位文件头，finish时回写
+    header = GhostHeader();
+    std::vector<std::uint8_t> bytes = encodeHeader(header);
+    file.write((const char*)bytes.data(), bytes.size());
+
+    chunk.clear();
+    chunk.reserve(SAMPLES_PER_CHUNK * 6);
+    chunkSamples = 0;
+    last = GhostSample();
+    return true;
+}
+
+void GhostRecorder::record(float time, const Player& player) {
+    if (!file.is_open()) return;
+
+    GhostSample sample = GhostSample::fromPlayer(time, player);
+    GhostCodec::encodeSample(chunk, chunkSamples == 0 ? GhostSample() : last, sample);
+    last = sample;
+    chunkSamples++;
+    header.sampleCount++;
+    header.durationMs = (std::uint32_t)std::max(0, sample.timeMs);
+
+    if (chunkSamples >= SAMPLES_PER_CHUNK) {
+        flushChunk();
+    }
+}
+
+void GhostRecorder::flushChunk() {
+    if (chunkSamples == 0) return;
+
+    std::vector<std::uint8_t> prefix;
+    BinaryIO::putU32(prefix, (std::uint32_t)chunkSamples);
+    BinaryIO::putU32(prefix, (std::uint32_t)chunk.size());
+    file.write((const char*)prefix.data(), prefix.size());
+    file.write((const char*)chunk.data(), chunk.size());
+
+    chunk.clear();
+    chunkSamples = 0;
+}
+
+bool GhostRecorder::finish(long long maxHeight) {
+    if (!file.is_open()) return false;
+
+    flushChunk();
+    header.maxHeight = maxHeight;
+
+    std::vector<std::uint8_t> bytes = encodeHeader(header);
+    file.seekp(0);
+    file.write((const char*)bytes.data(), bytes.size());
+
+    bool ok = file.good() && header.sampleCount > 0;
+    file.close();
+    return ok;
+}
+
+void GhostRecorder::discard() {
+    if (file.is_open()) {
+        file.close();
+    }
+    chunk.clear();
+    chunkSamples = 0;
+}
+
+GhostPlayer::GhostPlayer()
+    : chunkCursor(0), chunkRemaining(0), samplesRead(0), hasNext(false), currentTime(0) {
+}
+
+bool GhostPlayer::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    std::uint8_t bytes[GhostHeader::SIZE];
+    if (!file.read((char*)bytes, GhostHeader::SIZE) || !decodeHeader(bytes, header) || header.sampleCount == 0) {
+        close();
+        return false;
+    }
+
+    // 预读前两帧
+    if (!readSample(previous)) {
+        close();
+        return false;
+    }
+    hasNext = readSample(next);
+    return true;
+}
+
+void GhostPlayer::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    header = GhostHeader();
+    chunk.clear();
+    chunkCursor = 0;
+    chunkRemaining = 0;
+    samplesRead = 0;
+    previous = GhostSample();
+    next = GhostSample();
+    hasNext = false;
+    currentTime = 0;
+}
+
+bool GhostPlayer::loadChunk() {
+    std::uint8_t prefix[8];
+    if (!file.read((char*)prefix, sizeof(prefix))) return false;
+
+    std::uint32_t count = BinaryIO::getU32(prefix);
+    std::uint32_t byteCount = BinaryIO::getU32(prefix + 4);
+    if (count == 0 || byteCount > MAX_CHUNK_BYTES) return false;
+
+    // 复用同一块缓冲区
+    chunk.resize(byteCount);
+    if (byteCount > 0 && !file.read((char*)chunk.data(), byteCount)) return false;
+
+    chunkCursor = 0;
+    chunkRemaining = count;
+    chunkPrevious = GhostSample();
+    return true;
+}
+
+bool GhostPlayer::readSample(GhostSample& sample) {
+    if (samplesRead >= header.sampleCount) return false;
+    if (chunkRemaining == 0 && !loadChunk()) return false;
+
+    const std::uint8_t* begin = chunk.data() + chunkCursor;
+    const std::uint8_t* cursor = begin;
+    if (!GhostCodec::decodeSample(cursor, chunk.data() + chunk.size(), chunkPrevious, sample)) {
+        return false;
+    }
+
+    chunkCursor += cursor - begin;
+    chunkRemaining--;
+    chunkPrevious = sample;
+    samplesRead++;
+    return true;
+}
+
+void GhostPlayer::advance(float time) {
+    if (!file.is_open()) return;
+
+    currentTime = time;
+    std::int32_t timeMs = (std::int32_t)(time * 1000.0f);
+    while (hasNext && next.timeMs <= timeMs) {
+        previous = next;
+        hasNext = readSample(next);
+    }
+}
+
+float GhostPlayer::getX() const {
+    float x = (float)previous.x;
+    if (hasNext && next.timeMs > previous.timeMs) {
+        float t = std::min(1.0f, std::max(0.0f, (currentTime * 1000.0f - previous.timeMs) / (next.timeMs - previous.timeMs)));
+        x += (next.x - previous.x) * t;
+    }
+    return x / GhostSample::POSITION_SCALE;
+}
+
+float GhostPlayer::getY() const {
+    float y = (float)previous.y;
+    if (hasNext && next.timeMs > previous.timeMs) {
+        float t = std::min(1.0f, std::max(0.0f, (currentTime * 1000.0f - previous.timeMs) / (next.timeMs - previous.timeMs)));
+        y += (next.y - previous.y) * t;
+    }
+    return y / GhostSample::POSITION_SCALE;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+
+class Player;
+
+// 幽灵文件：最佳一局的玩家轨迹，下一局作为半透明的对手一起回放
+const char* const GHOST_BEST_PATH = "best_run.ghost";
+const char* const GHOST_RECORDING_PATH = "recording.ghost.tmp";
+
+// 状态位
+enum GhostFlags {
+    GHOST_ON_GROUND = 1 << 0,
+    GHOST_SHIELD = 1 << 1,
+    GHOST_INVINCIBLE = 1 << 2,
+    GHOST_SPEED_BOOST = 1 << 3
+};
+
+// 轨迹中的一帧：时间取整到毫秒，位置量化到1/POSITION_SCALE像素
+struct GhostSample {
+    static const int POSITION_SCALE = 4;
+
+    std::int32_t timeMs;
+    std::int32_t x, y;
+    std::uint8_t flags;
+
+    GhostSample() : timeMs(0), x(0), y(0), flags(0) {}
+
+    static GhostSample fromPlayer(float time, const Player& player);
+};
+
+// 帧间增量编码：每个字段记录与上一帧的差值，做zigzag后按varint写出
+// 相邻帧的位移通常只有几像素，一帧约占4字节
+namespace GhostCodec {
+    void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value);
+    bool readVarint(const std::uint8_t*& cursor, const std::uint8_t* end, std::uint32_t& value);
+
+    inline std::uint32_t zigzag(std::int32_t value) { return ((std::uint32_t)value << 1) ^ (std::uint32_t)(value >> 31); }
+    inline std::int32_t unzigzag(std::uint32_t value) { return (std::int32_t)(value >> 1) ^ -(std::int32_t)(value & 1); }
+
+    // dx的最低位标记状态位是否变化，变化时才追加一个字节
+    void encodeSample(std::vector<std::uint8_t>& out, const GhostSample& previous, const GhostSample& sample);
+    bool decodeSample(const std::uint8_t*& cursor, const std::uint8_t* end, const GhostSample& previous, GhostSample& sample);
+}
+
+// 文件头；之后是若干分块，每块以[帧数][字节数]开头，块内第一帧相对全零帧编码，可以独立解码
+struct GhostHeader {
+    static const std::uint32_t MAGIC = 0x4F48474A;     // "JGHO"
+    static const std::uint32_t VERSION = 1;
+    static const int SIZE = 32;
+
+    std::uint32_t sampleCount;
+    std::uint32_t durationMs;
+    std::int64_t maxHeight;
+
+    GhostHeader() : sampleCount(0), durationMs(0), maxHeight(0) {}
+};
+
+// 录制：按块编码并写入文件，内存中只保留当前块
+// 结束时回写文件头中的帧数、时长和最大高度
+class GhostRecorder {
+private:
+    static const int SAMPLES_PER_CHUNK = 256;
+
+    std::ofstream file;
+    std::vector<std::uint8_t> chunk;
+    int chunkSamples;
+    GhostSample last;
+    GhostHeader header;
+
+    void flushChunk();
+
+public:
+    GhostRecorder();
+
+    bool start(const std::string& path);
+    void record(float time, const Player& player);
+    bool finish(long long maxHeight);   // 写完并关闭文件
+    void discard();                     // 放弃本次录制（文件由下一次start覆盖）
+
+    bool isRecording() const { return file.is_open(); }
+};
+
+// 回放：流式读取，只缓存当前块的字节和前后两帧，内存占用与录像时长无关
+class GhostPlayer {
+private:
+    std::ifstream file;
+    GhostHeader header;
+    std::vector<std::uint8_t> chunk;
+    size_t chunkCursor;
+    std::uint32_t chunkRemaining;       // 当前块中尚未解码的帧数
+    std::uint32_t samplesRead;
+    GhostSample chunkPrevious;          // 块内增量的基准帧
+    GhostSample previous, next;         // 当前时间两侧的帧
+    bool hasNext;
+    float currentTime;
+
+    bool readSample(GhostSample& sample);
+    bool loadChunk();
+
+public:
+    GhostPlayer();
+
+    bool open(const std::string& path);
+    void close();
+
+    // 推进到time秒，只能向前
+    void advance(float time);
+
+    bool isLoaded() const { return file.is_open(); }
+    bool isVisible() const { return isLoaded() && samplesRead > 0 && currentTime * 1000.0f <= (float)header.durationMs; }
+    long long getMaxHeight() const { return isLoaded() ? (long long)header.maxHeight : 0; }
+
+    // 两帧之间线性插值
+    float getX() const;
+    float getY() const;
+    std::uint8_t getFlags() const { return previous.flags; }
+
+    void draw(float offsetX, float offsetY, float width, float height, int screenHeight) const;
+};
@@ -0,0 +1,49 @@
+#include "Ghost.h"
+#include "DrawUtils.h"
+
+void GhostPlayer::draw(float offsetX, float offsetY, float width, float height, int screenHeight) const {
+    if (!isVisible()) return;
+
+    float drawX = getX() + offsetX;
+    float drawY = getY() + offsetY;
+    COLORREF bodyColor = DrawUtils::blendColor(Theme::BACKGROUND, Theme::PLAYER_MAIN, 0.35f);
+    COLORREF edgeColor = DrawUtils::blendColor(Theme::BACKGROUND, Theme::PLAYER_ACCENT, 0.6f);
+
+    // 幽灵在屏幕外时在边缘画一个指向它的小三角
+    if (drawY + height < 0 || drawY > screenHeight) {
+        bool above = drawY + height < 0;
+        int centerX = (int)(drawX + width / 2);
+        int edgeY = above ? 8 : screenHeight - 8;
+        int direction = above ? 1 : -1;
+        POINT arrow[3] = {
+            { centerX, edgeY },
+            { centerX - 8, edgeY + direction * 12 },
+            { centerX + 8, edgeY + direction * 12 }
+        };
+        setfillcolor(edgeColor);
+        solidpolygon(arrow, 3);
+        return;
+    }
+
+    // 半透明：与背景色混合后绘制，不画阴影和粒子
+    std::uint8_t flags = getFlags();
+    if (flags & GHOST_INVINCIBLE) {
+        bodyColor = DrawUtils::blendColor(Theme::BACKGROUND, RGB(255, 215, 0), 0.35f);
+    }
+    else if (flags & GHOST_SPEED_BOOST) {
+        bodyColor = DrawUtils::blendColor(Theme::BACKGROUND, Theme::PLAYER_SPEED_EFFECT, 0.35f);
+    }
+
+    setfillcolor(bodyColor);
+    solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+    setlinecolor(edgeColor);
+    setlinestyle(PS_DASH, 1);
+    rectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+    if (flags & GHOST_SHIELD) {
+        setlinecolor(DrawUtils::blendColor(Theme::BACKGROUND, Theme::SHIELD_GLOW, 0.5f));
+        circle((int)(drawX + width / 2), (int)(drawY + height / 2), 25);
+    }
+    setlinestyle(PS_SOLID, 1);
+}
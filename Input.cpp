@@ -0,0 +1,135 @@
+#include "Input.h"
+
+// 键盘和鼠标只在Windows上由采样线程读取；其他平台只有无窗口模式，输入全部来自脚本或网络
+#ifdef _WIN32
+#include <graphics.h>
+#include <windows.h>
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+InputSystem::InputSystem(bool enabled)
+    : enabled(enabled), startTime(std::chrono::steady_clock::now()),
+    heldKeys(0), running(false) {
+    if (enabled) {
+        running = true;
+        sampler = std::thread(&InputSystem::samplerLoop, this);
+    }
+}
+
+InputSystem::~InputSystem() {
+    running = false;
+    if (sampler.joinable()) {
+        sampler.join();
+    }
+}
+
+double InputSystem::now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool InputSystem::readKey(InputKey key) {
+#ifdef _WIN32
+    switch (key) {
+    case KEY_LEFT: return (GetAsyncKeyState('A') & 0x8000) || (GetAsyncKeyState(VK_LEFT) & 0x8000);
+    case KEY_RIGHT: return (GetAsyncKeyState('D') & 0x8000) || (GetAsyncKeyState(VK_RIGHT) & 0x8000);
+    case KEY_UP: return (GetAsyncKeyState(VK_UP) & 0x8000) != 0;
+    case KEY_DOWN: return (GetAsyncKeyState(VK_DOWN) & 0x8000) != 0;
+    case KEY_PAGE_UP: return (GetAsyncKeyState(VK_PRIOR) & 0x8000) != 0;
+    case KEY_PAGE_DOWN: return (GetAsyncKeyState(VK_NEXT) & 0x8000) != 0;
+    case KEY_SPACE: return (GetAsyncKeyState(VK_SPACE) & 0x8000) != 0;
+    case KEY_ESCAPE: return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) != 0;
+    case KEY_BACKSPACE: return (GetAsyncKeyState(VK_BACK) & 0x8000) != 0;
+    case KEY_PAUSE: return (GetAsyncKeyState('P') & 0x8000) != 0;
+    case KEY_HELP: return (GetAsyncKeyState('H') & 0x8000) != 0;
+    case KEY_AUDIO_SETTINGS: return (GetAsyncKeyState('V') & 0x8000) != 0;
+    case KEY_MUTE: return (GetAsyncKeyState('M') & 0x8000) != 0;
+    case KEY_VOLUME_DOWN: return (GetAsyncKeyState('N') & 0x8000) != 0;
+    case KEY_VOLUME_UP: return (GetAsyncKeyState('B') & 0x8000) != 0;
+    case KEY_QUIT: return (GetAsyncKeyState(VK_F4) & 0x8000) != 0;
+    case KEY_MEMORY_REPORT: return (GetAsyncKeyState(VK_F3) & 0x8000) != 0;
+    case KEY_MOUSE_LEFT: return (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
+    case KEY_P1_LEFT: return (GetAsyncKeyState('A') & 0x8000) != 0;
+    case KEY_P1_RIGHT: return (GetAsyncKeyState('D') & 0x8000) != 0;
+    case KEY_P1_JUMP: return (GetAsyncKeyState('W') & 0x8000) != 0;
+    case KEY_P2_LEFT: return (GetAsyncKeyState(VK_LEFT) & 0x8000) != 0;
+    case KEY_P2_RIGHT: return (GetAsyncKeyState(VK_RIGHT) & 0x8000) != 0;
+    case KEY_P2_JUMP: return (GetAsyncKeyState(VK_UP) & 0x8000) != 0;
+    case KEY_P3_LEFT: return (GetAsyncKeyState('J') & 0x8000) != 0;
+    case KEY_P3_RIGHT: return (GetAsyncKeyState('L') & 0x8000) != 0;
+    case KEY_P3_JUMP: return (GetAsyncKeyState('I') & 0x8000) != 0;
+    case KEY_P4_LEFT: return (GetAsyncKeyState(VK_NUMPAD4) & 0x8000) != 0;
+    case KEY_P4_RIGHT: return (GetAsyncKeyState(VK_NUMPAD6) & 0x8000) != 0;
+    case KEY_P4_JUMP: return (GetAsyncKeyState(VK_NUMPAD8) & 0x8000) != 0;
+    default: return false;
+    }
+#else
+    (void)key;
+    return false;
+#endif
+}
+
+void InputSystem::samplerLoop() {
+    // 默认系统时钟精度约15毫秒，采样期间提高到1毫秒
+#ifdef _WIN32
+    timeBeginPeriod(1);
+#endif
+
+    std::uint32_t last = 0;
+    while (running) {
+        double time = now();
+        std::uint32_t current = 0;
+        for (int key = 0; key < INPUT_KEY_COUNT; key++) {
+            if (readKey((InputKey)key)) {
+                current |= 1u << key;
+            }
+        }
+
+        std::uint32_t changed = current ^ last;
+        for (int key = 0; changed != 0 && key < INPUT_KEY_COUNT; key++) {
+            if (changed & (1u << key)) {
+                // 队列满时丢弃事件，按住状态仍由heldKeys给出
+                events.tryPush(InputEvent{ (InputKey)key, (current >> key) & 1u ? true : false, time });
+            }
+        }
+        heldKeys.store(current, std::memory_order_release);
+        last = current;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+InputFrame InputSystem::poll() {
+    InputFrame frame;
+    frame.time = now();
+    if (!enabled) return frame;
+
+    InputEvent event;
+    while (events.tryPop(event)) {
+        std::uint32_t bit = 1u << event.key;
+        if (event.down) {
+            if (!(frame.pressed & bit)) {
+                frame.pressTime[event.key] = event.time;
+            }
+            frame.pressed |= bit;
+        }
+        else {
+            frame.released |= bit;
+        }
+    }
+    frame.held = heldKeys.load(std::memory_order_acquire);
+
+    // 鼠标位置不需要边沿，直接读取
+#ifdef _WIN32
+    POINT cursorPos;
+    GetCursorPos(&cursorPos);
+    ScreenToClient(GetHWnd(), &cursorPos);
+    frame.mouseX = cursorPos.x;
+    frame.mouseY = cursorPos.y;
+#endif
+    return frame;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "SpscQueue.h"
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+// 逻辑按键：一个逻辑键可以对应多个物理键（如A和←都是KEY_LEFT）
+enum InputKey {
+    KEY_LEFT,
+    KEY_RIGHT,
+    KEY_UP,
+    KEY_DOWN,
+    KEY_PAGE_UP,
+    KEY_PAGE_DOWN,
+    KEY_SPACE,
+    KEY_ESCAPE,
+    KEY_BACKSPACE,
+    KEY_PAUSE,          // P
+    KEY_HELP,           // H
+    KEY_AUDIO_SETTINGS, // V
+    KEY_MUTE,           // M
+    KEY_VOLUME_DOWN,    // N
+    KEY_VOLUME_UP,      // B
+    KEY_QUIT,           // F4
+    KEY_MEMORY_REPORT,  // F3
+    KEY_MOUSE_LEFT,
+
+    // 分屏多人时每名玩家各自的左、右、跳
+    KEY_P1_LEFT,        // A
+    KEY_P1_RIGHT,       // D
+    KEY_P1_JUMP,        // W
+    KEY_P2_LEFT,        // ←
+    KEY_P2_RIGHT,       // →
+    KEY_P2_JUMP,        // ↑
+    KEY_P3_LEFT,        // J
+    KEY_P3_RIGHT,       // L
+    KEY_P3_JUMP,        // I
+    KEY_P4_LEFT,        // 小键盘4
+    KEY_P4_RIGHT,       // 小键盘6
+    KEY_P4_JUMP,        // 小键盘8
+    INPUT_KEY_COUNT
+};
+
+// 按键状态用32位掩码保存
+static_assert(INPUT_KEY_COUNT <= 32, "InputKey must fit in a 32-bit mask");
+
+const int MAX_LOCAL_PLAYERS = 4;
+
+// 按键事件：按下或松开的时刻（秒，InputSystem创建时为0）
+struct InputEvent {
+    InputKey key;
+    bool down;
+    double time;
+};
+
+// 一个逻辑帧的输入：当前按住的键，以及上一帧之后发生过的按下/松开
+// 帧内按下又松开的短按同样记为pressed
+struct InputFrame {
+    double time;
+    std::uint32_t held;
+    std::uint32_t pressed;
+    std::uint32_t released;
+    double pressTime[INPUT_KEY_COUNT];  // 本帧内第一次按下的时刻
+    int mouseX, mouseY;
+
+    InputFrame() : time(0), held(0), pressed(0), released(0), mouseX(0), mouseY(0) {
+        for (int i = 0; i < INPUT_KEY_COUNT; i++) {
+            pressTime[i] = 0;
+        }
+    }
+
+    bool isDown(InputKey key) const { return (held >> key) & 1u; }
+    bool wasPressed(InputKey key) const { return (pressed >> key) & 1u; }
+    bool wasReleased(InputKey key) const { return (released >> key) & 1u; }
+
+    // 按下到本帧采样经过的时间，用于跳跃缓冲扣除已等待的部分
+    float pressAge(InputKey key) const { return wasPressed(key) ? (float)(time - pressTime[key]) : 0.0f; }
+
+    // 多人时第playerIndex名玩家看到的输入：把他的左、右、跳映射到KEY_LEFT、KEY_RIGHT、KEY_SPACE
+    InputFrame forPlayer(int playerIndex) const {
+        static const InputKey playerKeys[MAX_LOCAL_PLAYERS][3] = {
+            { KEY_P1_LEFT, KEY_P1_RIGHT, KEY_P1_JUMP },
+            { KEY_P2_LEFT, KEY_P2_RIGHT, KEY_P2_JUMP },
+            { KEY_P3_LEFT, KEY_P3_RIGHT, KEY_P3_JUMP },
+            { KEY_P4_LEFT, KEY_P4_RIGHT, KEY_P4_JUMP }
+        };
+        static const InputKey targets[3] = { KEY_LEFT, KEY_RIGHT, KEY_SPACE };
+
+        InputFrame frame;
+        frame.time = time;
+        frame.mouseX = mouseX;
+        frame.mouseY = mouseY;
+        for (int i = 0; i < 3; i++) {
+            InputKey source = playerKeys[playerIndex][i];
+            std::uint32_t bit = 1u << targets[i];
+            if (isDown(source)) frame.held |= bit;
+            if (wasPressed(source)) frame.pressed |= bit;
+            if (wasReleased(source)) frame.released |= bit;
+            frame.pressTime[targets[i]] = pressTime[source];
+        }
+        return frame;
+    }
+};
+
+// 输入系统：采样线程以1毫秒间隔读取按键，变化时带时间戳写入无锁队列；
+// 游戏线程每帧调用poll取出事件，统一做边沿检测，得到InputFrame
+// 无窗口模式不启动采样线程，poll始终返回空帧
+class InputSystem {
+private:
+    static const size_t QUEUE_CAPACITY = 256;
+
+    bool enabled;
+    std::chrono::steady_clock::time_point startTime;
+    SpscQueue<InputEvent, QUEUE_CAPACITY> events;
+    std::atomic<std::uint32_t> heldKeys;    // 采样线程看到的最新按住状态，队列溢出时以它为准
+    std::atomic<bool> running;
+    std::thread sampler;
+
+    void samplerLoop();
+    static bool readKey(InputKey key);
+
+public:
+    explicit InputSystem(bool enabled);
+    ~InputSystem();
+
+    InputSystem(const InputSystem&) = delete;
+    InputSystem& operator=(const InputSystem&) = delete;
+
+    double now() const;
+    InputFrame poll();
+};
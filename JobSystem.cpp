@@ -0,0 +1,214 @@
+#include "JobSystem.h"
+
+int& JobSystem::currentWorker() {
+    static thread_local int index = -1;
+    return index;
+}
+
+int& JobSystem::requestedWorkerCount() {
+    static int count = -1;
+    return count;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance(requestedWorkerCount() >= 0 ? requestedWorkerCount()
+        : (int)std::thread::hardware_concurrency() - 1);
+    return instance;
+}
+
+JobSystem::JobSystem(int workerCount)
+    : injected(INITIAL_QUEUE_CAPACITY), freeForRangeCount(FOR_RANGE_COUNT), queuedCount(0), running(true) {
+    for (int i = 0; i < FOR_RANGE_COUNT; i++) {
+        forRanges[i].owner.store(0, std::memory_order_relaxed);
+        freeForRanges[i] = FOR_RANGE_COUNT - 1 - i;
+    }
+    if (workerCount < 0) workerCount = 0;
+    for (int i = 0; i < workerCount; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void JobSystem::push(Job&& job) {
+    int worker = currentWorker();
+    if (worker >= 0) {
+        std::lock_guard<std::mutex> guard(queues[worker]->lock);
+        queues[worker]->jobs.pushBack(std::move(job));
+    }
+    else {
+        std::lock_guard<std::mutex> guard(injectedLock);
+        injected.pushBack(std::move(job));
+    }
+
+    // 先计数再经过sleepLock通知：正在判断是否休眠的工作线程要么看到计数，要么已在等待、能收到通知
+    queuedCount.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::popLocal(Job& job) {
+    int worker = currentWorker();
+    if (worker < 0) return false;
+
+    WorkerQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.jobs.empty()) return false;
+
+    queue.jobs.popBack(job);
+    queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(Job& job) {
+    int worker = currentWorker();
+    size_t count = queues.size();
+    size_t start = worker >= 0 ? (size_t)worker + 1 : 0;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t victim = (start + i) % count;
+        if ((int)victim == worker) continue;
+
+        WorkerQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.jobs.empty()) continue;
+
+        queue.jobs.popFront(job);
+        queuedCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::popInjected(Job& job, const JobCounter* owner) {
+    std::lock_guard<std::mutex> guard(injectedLock);
+    if (injected.empty()) return false;
+    if (owner && injected.front().counter != owner) return false;
+
+    injected.popFront(job);
+    queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void JobSystem::execute(Job& job) {
+    if (job.range) {
+        helpRange(*job.range, job.generation);
+    }
+    else {
+        job.function();
+    }
+    // 计数是任务对外的最后一次访问：wait返回后counter可以立即销毁
+    if (job.counter) {
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void JobSystem::workerLoop(int index) {
+    currentWorker() = index;
+
+    // 没有任务时先让出一会儿再休眠：同一帧内接连的parallelFor不必每次都唤醒线程
+    const int SPIN_ROUNDS = 64;
+    int idleRounds = 0;
+
+    while (running.load(std::memory_order_acquire)) {
+        Job job;
+        if (popLocal(job) || steal(job) || popInjected(job, nullptr)) {
+            execute(job);
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [this]() {
+            return queuedCount.load(std::memory_order_acquire) > 0 || !running.load(std::memory_order_acquire);
+        });
+        idleRounds = 0;
+    }
+}
+
+void JobSystem::run(JobCounter& counter, std::function<void()> function) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    push(Job{ std::move(function), &counter, nullptr, 0 });
+}
+
+void JobSystem::submit(std::function<void()> function) {
+    push(Job{ std::move(function), nullptr, nullptr, 0 });
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        Job job;
+        if (popLocal(job) || steal(job) || popInjected(job, &counter)) {
+            execute(job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystem::ForRange* JobSystem::acquireRange(std::uint32_t& generation) {
+    std::lock_guard<std::mutex> guard(forRangeLock);
+    if (freeForRangeCount == 0) return nullptr;
+
+    ForRange* range = &forRanges[freeForRanges[--freeForRangeCount]];
+    generation = (std::uint32_t)(range->owner.load(std::memory_order_acquire) >> 32);
+    return range;
+}
+
+void JobSystem::releaseRange(ForRange* range, std::uint32_t generation) {
+    // 等仍在领取分段的帮手退出后递增代号，之后才开始执行的帮手任务看到代号不符直接返回
+    const std::uint64_t current = (std::uint64_t)generation << 32;
+    const std::uint64_t next = (std::uint64_t)(generation + 1) << 32;
+    std::uint64_t expected = current;
+    while (!range->owner.compare_exchange_weak(expected, next, std::memory_order_acq_rel)) {
+        expected = current;
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> guard(forRangeLock);
+    freeForRanges[freeForRangeCount++] = (int)(range - forRanges);
+}
+
+void JobSystem::helpRange(ForRange& range, std::uint32_t generation) {
+    std::uint64_t owner = range.owner.load(std::memory_order_acquire);
+    do {
+        if ((std::uint32_t)(owner >> 32) != generation) return;
+    } while (!range.owner.compare_exchange_weak(owner, owner + 1, std::memory_order_acq_rel));
+
+    claimRanges(range);
+    range.owner.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::claimRanges(ForRange& range) {
+    size_t finished = 0;
+    for (;;) {
+        size_t index = range.nextRange.fetch_add(1, std::memory_order_relaxed);
+        if (index >= range.rangeCount) break;
+        size_t begin = index * range.grain;
+        range.invoke(range.body, begin, begin + range.grain < range.count ? begin + range.grain : range.count);
+        finished++;
+    }
+    if (finished > 0) {
+        range.finishedRanges.fetch_add(finished, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RingQueue.h"
+
+// fork/join的完成计数：run时加一，任务执行完后减一，wait等到归零
+class JobCounter {
+private:
+    friend class JobSystem;
+    std::atomic<int> pending;
+
+public:
+    JobCounter() : pending(0) {}
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// 工作窃取任务池：每个工作线程有自己的双端队列，自己从队尾取（后进先出，刚拆出的子任务数据还在缓存里），
+// 空闲时从其他线程的队头窃取；非工作线程提交的任务进入共享的注入队列。
+// 全进程共用一个池：批量模拟、后台分块生成和逐帧的实体更新都在这里执行，不再各自开线程
+class JobSystem {
+private:
+    static const size_t INITIAL_QUEUE_CAPACITY = 256;
+    static const int FOR_RANGE_COUNT = 64;      // 同时进行（含嵌套）的parallelFor上限，用尽时直接在本线程执行
+
+    // parallelFor的分段状态：预先分配在池中，按代号区分前后两次调用。
+    // 迟到的帮手任务可能在调用者返回后才开始执行，代号不符时直接返回，不会领取下一次调用的分段
+    struct ForRange {
+        std::atomic<std::uint64_t> owner;       // 高32位为代号，低32位为正在领取分段的帮手数
+        std::atomic<size_t> nextRange;
+        std::atomic<size_t> finishedRanges;
+        size_t rangeCount;
+        size_t count;
+        size_t grain;
+        const void* body;
+        void (*invoke)(const void* body, size_t begin, size_t end);
+    };
+
+    // 任务大小固定：parallelFor的帮手任务只带分段和代号，function为空，入队时不分配
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter;            // 不需要等待的任务为nullptr
+        ForRange* range;                // parallelFor的帮手任务，否则为nullptr
+        std::uint32_t generation;
+    };
+
+    // 任务队列只在满时扩容，出入队不访问堆
+    struct WorkerQueue {
+        std::mutex lock;
+        RingQueue<Job> jobs;
+
+        WorkerQueue() : jobs(INITIAL_QUEUE_CAPACITY) {}
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;     // 每个工作线程一个
+    std::vector<std::thread> threads;
+    std::mutex injectedLock;
+    RingQueue<Job> injected;
+
+    ForRange forRanges[FOR_RANGE_COUNT];
+    std::mutex forRangeLock;
+    int freeForRanges[FOR_RANGE_COUNT];
+    int freeForRangeCount;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<int> queuedCount;       // 各队列中尚未取走的任务数，为0时工作线程休眠
+    std::atomic<bool> running;
+
+    static int& currentWorker();        // 当前线程的工作线程序号，非工作线程为-1
+    static int& requestedWorkerCount();
+
+    explicit JobSystem(int workerCount);
+
+    void workerLoop(int index);
+    void push(Job&& job);
+    bool popLocal(Job& job);
+    bool steal(Job& job);
+    bool popInjected(Job& job, const JobCounter* owner);
+    void execute(Job& job);
+
+    ForRange* acquireRange(std::uint32_t& generation);
+    void releaseRange(ForRange* range, std::uint32_t generation);
+    void helpRange(ForRange& range, std::uint32_t generation);
+    static void claimRanges(ForRange& range);
+
+    template <typename Body>
+    static void invokeBody(const void* body, size_t begin, size_t end) {
+        (*static_cast<const Body*>(body))(begin, end);
+    }
+
+public:
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 第一次调用时创建线程：默认为硬件线程数-1（调用线程自己也参与执行）
+    static JobSystem& getInstance();
+    // 在第一次getInstance之前设置工作线程数，0表示所有任务都由等待的线程自己执行
+    static void setWorkerCount(int count) { requestedWorkerCount() = count; }
+
+    int getWorkerCount() const { return (int)threads.size(); }
+
+    // fork：提交任务，计入counter
+    void run(JobCounter& counter, std::function<void()> function);
+    // 提交不需要等待的任务
+    void submit(std::function<void()> function);
+    // join：等待counter归零，期间执行本线程队列中的任务、从其他工作线程窃取，
+    // 以及注入队列中属于同一counter的任务（不会执行其他线程提交的无关长任务）
+    void wait(JobCounter& counter);
+
+    // 把[0, count)按grain切成若干段并行执行body(begin, end)；第r段为[r * grain, min(count, (r + 1) * grain))，
+    // 按段写结果再按段序合并即可得到与串行相同、与线程数无关的结果。
+    // count不超过grain或没有工作线程时直接在本线程执行body(0, count)。
+    // 调用者自己也领取分段，只等已被领走的分段完成，不执行其他任务。
+    // 分段状态取自预先分配的池，帮手任务大小固定，稳定运行时不访问堆
+    template <typename Body>
+    void parallelFor(size_t count, size_t grain, const Body& body) {
+        if (grain == 0) grain = 1;
+        if (count <= grain || threads.empty()) {
+            if (count > 0) body(0, count);
+            return;
+        }
+
+        std::uint32_t generation = 0;
+        ForRange* range = acquireRange(generation);
+        if (!range) {
+            body(0, count);
+            return;
+        }
+
+        range->nextRange.store(0, std::memory_order_relaxed);
+        range->finishedRanges.store(0, std::memory_order_relaxed);
+        range->rangeCount = (count + grain - 1) / grain;
+        range->count = count;
+        range->grain = grain;
+        range->body = &body;
+        range->invoke = &invokeBody<Body>;
+
+        // 队列中已有足够多的任务等着工作线程时不再追加帮手：工作线程忙不过来（单核机器）时，
+        // 迟到的帮手只会在队列中堆积，让队列在游戏运行中扩容
+        size_t helpers = range->rangeCount - 1;
+        if (helpers > threads.size()) helpers = threads.size();
+        for (size_t i = 0; i < helpers; i++) {
+            if (queuedCount.load(std::memory_order_relaxed) >= (int)threads.size()) break;
+            push(Job{ std::function<void()>(), nullptr, range, generation });
+        }
+
+        claimRanges(*range);
+        while (range->finishedRanges.load(std::memory_order_acquire) < range->rangeCount) {
+            std::this_thread::yield();
+        }
+        releaseRange(range, generation);
+    }
+};
@@ -0,0 +1,56 @@
+#include "JumpEnvelope.h"
+#include <cmath>
+#include <algorithm>
+
+// 两段水平区间之间的空隙，重叠时为0
+static float horizontalGap(float ax, float aw, float bx, float bw) {
+    return std::max(0.0f, std::max(bx - (ax + aw), ax - (bx + bw)));
+}
+
+JumpEnvelope::JumpEnvelope(int jumps, float speedMultiplier)
+    : jumpSpeed(-Player::JUMP_SPEED), gravity(Player::GRAVITY),
+    // 按住方向键时稳态速度约为MOVE_SPEED*FRICTION/(1-FRICTION)，这里保守取MOVE_SPEED
+    horizontalSpeed(Player::MOVE_SPEED * speedMultiplier),
+    jumps(std::max(1, jumps)) {
+    // 每次在最高点再跳一次，总高度为单跳高度v²/2g的jumps倍
+    maxRise = this->jumps * jumpSpeed * jumpSpeed / (2.0f * gravity);
+}
+
+JumpEnvelope JumpEnvelope::forPlayer(const Player& player) {
+    // 时间减缓同时作用于重力和位移，轨迹形状不变，不影响包络
+    return JumpEnvelope(player.getMaxJumps(), player.getSpeedMultiplier());
+}
+
+float JumpEnvelope::maxHorizontalReach(float rise) const {
+    if (rise > maxRise) return -1.0f;
+
+    // 连跳到最高点所需时间 + 从最高点落回目标高度的时间
+    float timeToApex = jumps * jumpSpeed / gravity;
+    float fallTime = sqrtf(2.0f * (maxRise - rise) / gravity);
+    return horizontalSpeed * (timeToApex + fallTime);
+}
+
+bool JumpEnvelope::canReach(const Platform& from, const Platform& to) const {
+    float rise = from.getY() - to.getY();
+    if (rise > getSafeRise()) return false;
+
+    // 移动平台按起点计算，往返范围从可用距离中扣除
+    float gap = horizontalGap(from.getStartX(), from.getWidth(), to.getStartX(), to.getWidth());
+    float slack = from.getMoveRange() + to.getMoveRange();
+    // 留0.5像素容差，clampReachableX修正到边界上的平台不会因浮点误差被判为不可达
+    return gap + slack <= maxHorizontalReach(rise) * SAFETY_MARGIN + 0.5f;
+}
+
+float JumpEnvelope::clampReachableY(const Platform& from, float y) const {
+    return std::max(y, from.getY() - getSafeRise());
+}
+
+float JumpEnvelope::clampReachableX(const Platform& from, float x, float width, float y, PlatformType type) const {
+    float reach = maxHorizontalReach(from.getY() - y) * SAFETY_MARGIN;
+    reach -= from.getMoveRange() + (type == MOVING ? Platform::MOVING_RANGE : 0.0f);
+    reach = std::max(0.0f, reach);
+
+    float minX = from.getStartX() - reach - width;
+    float maxX = from.getStartX() + from.getWidth() + reach;
+    return std::max(minX, std::min(x, maxX));
+}
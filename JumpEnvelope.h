@@ -0,0 +1,38 @@
+#pragma once
+#include "Player.h"
+#include "Platform.h"
+
+// 玩家跳跃可达范围（包络）：由Player的物理常量和道具效果推导
+// 平台生成器用它保证相邻平台之间始终存在可达路径
+class JumpEnvelope {
+private:
+    float jumpSpeed;        // 起跳速度（取正值）
+    float gravity;
+    float horizontalSpeed;  // 空中水平速度（保守估计）
+    int jumps;              // 可用跳跃次数（含地面起跳）
+    float maxRise;          // 最大上升高度，构造时算好
+
+public:
+    // 安全系数：只使用理论包络的80%，留出帧步长误差和操作余量
+    static constexpr float SAFETY_MARGIN = 0.8f;
+
+    // 默认为无道具时的基础能力（2段跳、无加速）
+    explicit JumpEnvelope(int jumps = 2, float speedMultiplier = 1.0f);
+
+    // 按玩家当前生效的道具计算（额外跳跃、加速）
+    static JumpEnvelope forPlayer(const Player& player);
+
+    int getJumps() const { return jumps; }
+    float getMaxRise() const { return maxRise; }
+    float getSafeRise() const { return maxRise * SAFETY_MARGIN; }
+
+    // 上升rise像素（负值表示向下）后仍能落脚的最大水平距离，超出高度上限返回-1
+    float maxHorizontalReach(float rise) const;
+
+    // 从from平台能否跳到to平台（O(1)，按安全系数判断）
+    bool canReach(const Platform& from, const Platform& to) const;
+
+    // 修正候选平台：把高度限制在可跳范围内，再把x收到可达区间内（均为O(1)）
+    float clampReachableY(const Platform& from, float y) const;
+    float clampReachableX(const Platform& from, float x, float width, float y, PlatformType type) const;
+};
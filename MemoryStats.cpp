@@ -0,0 +1,149 @@
+#include "MemoryStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace {
+    // 每块内存前的记录，占16字节，返回给调用方的地址保持malloc的16字节对齐
+    struct BlockHeader {
+        std::size_t size;
+        MemoryTag tag;
+    };
+    const std::size_t HEADER_SIZE = 16;
+    static_assert(sizeof(BlockHeader) <= HEADER_SIZE, "block header must fit in 16 bytes");
+
+    // 计数器在静态初始化之前就是零，全局构造函数中的分配同样能记录
+    struct TagCounters {
+        std::atomic<long long> allocations;
+        std::atomic<long long> frees;
+        std::atomic<long long> liveBytes;
+        std::atomic<long long> peakBytes;
+        std::atomic<long long> frameAllocations;
+        std::atomic<long long> frameBytes;
+    };
+    TagCounters counters[MEM_TAG_COUNT];
+
+    // 只由调用endFrame的游戏线程读写
+    long long maxFrameAllocations[MEM_TAG_COUNT];
+    long long allocatingFrames[MEM_TAG_COUNT];
+    long long frameCount;
+
+    thread_local MemoryTag threadTag = MEM_GENERAL;
+
+    void* allocateTracked(std::size_t size) {
+        unsigned char* block = static_cast<unsigned char*>(std::malloc(HEADER_SIZE + size));
+        if (!block) return nullptr;
+
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+        header->size = size;
+        header->tag = threadTag;
+
+        TagCounters& tag = counters[header->tag];
+        tag.allocations.fetch_add(1, std::memory_order_relaxed);
+        tag.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        tag.frameBytes.fetch_add((long long)size, std::memory_order_relaxed);
+        long long live = tag.liveBytes.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+        long long peak = tag.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !tag.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        return block + HEADER_SIZE;
+    }
+
+    void freeTracked(void* pointer) {
+        if (!pointer) return;
+
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HEADER_SIZE;
+        const BlockHeader* header = reinterpret_cast<const BlockHeader*>(block);
+        TagCounters& tag = counters[header->tag];
+        tag.frees.fetch_add(1, std::memory_order_relaxed);
+        tag.liveBytes.fetch_sub((long long)header->size, std::memory_order_relaxed);
+        std::free(block);
+    }
+
+    void* allocateOrThrow(std::size_t size) {
+        void* pointer = allocateTracked(size);
+        if (!pointer) throw std::bad_alloc();
+        return pointer;
+    }
+}
+
+// 替换全局的分配函数：整个程序（包括标准库容器）的分配都经过这里
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocateTracked(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocateTracked(size); }
+
+void operator delete(void* pointer) noexcept { freeTracked(pointer); }
+void operator delete[](void* pointer) noexcept { freeTracked(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { freeTracked(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { freeTracked(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { freeTracked(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { freeTracked(pointer); }
+
+namespace MemoryStats {
+    const char* tagName(MemoryTag tag) {
+        switch (tag) {
+        case MEM_GENERAL: return "general";
+        case MEM_AUDIO: return "audio";
+        case MEM_PARTICLES: return "particles";
+        case MEM_PLATFORMS: return "platforms";
+        case MEM_WORLD: return "world";
+        case MEM_UI: return "ui";
+        default: return "?";
+        }
+    }
+
+    MemoryTag currentTag() { return threadTag; }
+    void setCurrentTag(MemoryTag tag) { threadTag = tag; }
+
+    MemoryFrame endFrame() {
+        MemoryFrame frame;
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            frame.allocations[i] = counters[i].frameAllocations.exchange(0, std::memory_order_relaxed);
+            frame.bytes[i] = counters[i].frameBytes.exchange(0, std::memory_order_relaxed);
+            if (frame.allocations[i] > 0) {
+                allocatingFrames[i]++;
+                if (frame.allocations[i] > maxFrameAllocations[i]) {
+                    maxFrameAllocations[i] = frame.allocations[i];
+                }
+            }
+        }
+        frameCount++;
+        return frame;
+    }
+
+    long long getFrameCount() { return frameCount; }
+
+    MemoryTagStats getTagStats(MemoryTag tag) {
+        const TagCounters& source = counters[tag];
+        MemoryTagStats stats;
+        stats.allocations = source.allocations.load(std::memory_order_relaxed);
+        stats.frees = source.frees.load(std::memory_order_relaxed);
+        stats.liveBytes = source.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = source.peakBytes.load(std::memory_order_relaxed);
+        stats.maxFrameAllocations = maxFrameAllocations[tag];
+        stats.allocatingFrames = allocatingFrames[tag];
+        return stats;
+    }
+
+    void writeReport(std::ostream& out) {
+        // 先取出全部数值再输出：输出本身的分配不计入表中
+        MemoryTagStats stats[MEM_TAG_COUNT];
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            stats[i] = getTagStats(static_cast<MemoryTag>(i));
+        }
+
+        out << "frames: " << frameCount << "\n";
+        out << std::left << std::setw(12) << "tag" << std::right
+            << std::setw(12) << "allocs" << std::setw(12) << "frees"
+            << std::setw(14) << "live bytes" << std::setw(14) << "peak bytes"
+            << std::setw(12) << "max/frame" << std::setw(12) << "frames" << "\n";
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            out << std::left << std::setw(12) << tagName(static_cast<MemoryTag>(i)) << std::right
+                << std::setw(12) << stats[i].allocations << std::setw(12) << stats[i].frees
+                << std::setw(14) << stats[i].liveBytes << std::setw(14) << stats[i].peakBytes
+                << std::setw(12) << stats[i].maxFrameAllocations << std::setw(12) << stats[i].allocatingFrames << "\n";
+        }
+    }
+}
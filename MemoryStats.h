@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+// 内存统计的子系统标签：分配记在当前线程的标签下，释放记回分配时的标签
+enum MemoryTag {
+    MEM_GENERAL,        // 未标记
+    MEM_AUDIO,          // 音频：MCI命令字符串、正在播放的声音列表
+    MEM_PARTICLES,      // 玩家粒子
+    MEM_PLATFORMS,      // 平台生成与分块拼接：块池扩容时才分配，块用完后归还复用
+    MEM_WORLD,          // 游戏逻辑：实体组件池、时间轮、待销毁列表等
+    MEM_UI,             // 绘制与界面文字
+    MEM_TAG_COUNT
+};
+
+// 一个标签的累计统计
+struct MemoryTagStats {
+    long long allocations;          // 累计分配次数
+    long long frees;                // 累计释放次数
+    long long liveBytes;            // 当前未释放的字节数
+    long long peakBytes;            // liveBytes的最高值
+    long long maxFrameAllocations;  // 单帧最多的分配次数
+    long long allocatingFrames;     // 有分配的帧数
+};
+
+// 一帧内各标签的分配
+struct MemoryFrame {
+    long long allocations[MEM_TAG_COUNT];
+    long long bytes[MEM_TAG_COUNT];
+
+    // mask按标签取位（1 << MEM_UI），只统计mask中的标签
+    long long count(unsigned int mask = ~0u) const {
+        long long total = 0;
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            if ((mask >> i) & 1u) total += allocations[i];
+        }
+        return total;
+    }
+};
+
+// 全局operator new/delete的统计：每次分配在块前记下大小和标签，按标签累计次数、在用字节和高水位，
+// 帧末endFrame取出本帧的分配。用来确认逐帧的代码不访问堆，以及长时间运行时各子系统没有泄漏
+namespace MemoryStats {
+    const char* tagName(MemoryTag tag);
+
+    MemoryTag currentTag();
+    void setCurrentTag(MemoryTag tag);
+
+    // 游戏线程每帧结束时调用：返回本帧的分配并清零，同时更新各标签的单帧最大值
+    MemoryFrame endFrame();
+    long long getFrameCount();
+
+    MemoryTagStats getTagStats(MemoryTag tag);
+
+    // 各标签的统计表，按需输出（游戏中按F3写入文件）
+    void writeReport(std::ostream& out);
+}
+
+// 作用域内当前线程的分配记在tag下，离开时恢复外层的标签
+class MemoryScope {
+private:
+    MemoryTag previous;
+
+public:
+    explicit MemoryScope(MemoryTag tag) : previous(MemoryStats::currentTag()) { MemoryStats::setCurrentTag(tag); }
+    ~MemoryScope() { MemoryStats::setCurrentTag(previous); }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+};
@@ -0,0 +1,276 @@
+#include "NetSession.h"
+#include "Game.h"
+#include "SnapshotRing.h"
+#include "BinaryIO.h"
+#include <chrono>
+#include <algorithm>
+
+namespace {
+    const std::uint32_t PACKET_MAGIC = 0x54454E4A;     // "JNET"
+    const std::uint32_t MAX_INPUTS_PER_PACKET = 32;
+
+    // 第playerIndex名玩家的左、右、跳（与InputFrame::forPlayer对应）
+    const InputKey PLAYER_KEYS[MAX_LOCAL_PLAYERS][3] = {
+        { KEY_P1_LEFT, KEY_P1_RIGHT, KEY_P1_JUMP },
+        { KEY_P2_LEFT, KEY_P2_RIGHT, KEY_P2_JUMP },
+        { KEY_P3_LEFT, KEY_P3_RIGHT, KEY_P3_JUMP },
+        { KEY_P4_LEFT, KEY_P4_RIGHT, KEY_P4_JUMP }
+    };
+}
+
+NetInput NetInput::fromFrame(const InputFrame& frame) {
+    NetInput input;
+    if (frame.isDown(KEY_LEFT)) input.buttons |= LEFT;
+    if (frame.isDown(KEY_RIGHT)) input.buttons |= RIGHT;
+    if (frame.isDown(KEY_SPACE)) input.buttons |= JUMP;
+    if (frame.wasPressed(KEY_SPACE)) {
+        input.buttons |= JUMP_PRESSED;
+        input.pressAgeMs = (std::uint8_t)std::min(255, std::max(0, (int)(frame.pressAge(KEY_SPACE) * 1000.0f)));
+    }
+    return input;
+}
+
+NetInput NetInput::predictNext() const {
+    NetInput next;
+    next.buttons = buttons & (LEFT | RIGHT | JUMP);
+    return next;
+}
+
+NetSession::NetSession(Game& game, NetTransport& transport, int playerCount, int localPlayer, int inputDelay)
+    : game(game), transport(transport), playerCount(playerCount), localPlayer(localPlayer),
+    inputDelay(std::max(0, std::min(inputDelay, (int)MAX_ROLLBACK_FRAMES))),
+    currentTick(0), firstMismatch(NO_TICK), snapshots(new SnapshotRing(SNAPSHOT_COUNT)),
+    lastChecksumTick(NO_TICK) {
+    inputs.resize(INPUT_WINDOW * playerCount);
+    usedInputs.resize(INPUT_WINDOW * playerCount);
+    checksums.resize(INPUT_WINDOW, { NO_TICK, 0 });
+
+    // 前inputDelay帧各端都没有输入，视为已确定
+    received.assign(playerCount, (std::uint32_t)this->inputDelay);
+    peerAcks.assign(playerCount, (std::uint32_t)this->inputDelay);
+    peerChecked.assign(playerCount, (std::uint32_t)NO_TICK);
+}
+
+NetSession::~NetSession() {
+}
+
+std::uint32_t NetSession::getConfirmedTick() const {
+    return *std::min_element(received.begin(), received.end());
+}
+
+bool NetSession::getChecksum(std::uint32_t tick, std::uint32_t& checksum) const {
+    const ChecksumRecord& record = checksums[tick % INPUT_WINDOW];
+    if (record.tick != tick) return false;
+    checksum = record.checksum;
+    return true;
+}
+
+bool NetSession::advance(const InputFrame& localFrame) {
+    receivePackets();
+    rollback();
+
+    // 再往前模拟就可能需要超过MAX_ROLLBACK_FRAMES帧的回滚，等待远端
+    if (currentTick >= getConfirmedTick() + (std::uint32_t)MAX_ROLLBACK_FRAMES) {
+        stats.stalls++;
+        sendInputs();
+        return false;
+    }
+
+    // 本机输入在inputDelay帧后生效
+    std::uint32_t inputTick = currentTick + inputDelay;
+    inputAt(inputTick, localPlayer) = NetInput::fromFrame(localFrame);
+    received[localPlayer] = inputTick + 1;
+
+    simulate(currentTick, currentTick >= getConfirmedTick());
+    currentTick++;
+    stats.ticks++;
+
+    sendInputs();
+    return true;
+}
+
+void NetSession::poll() {
+    receivePackets();
+    rollback();
+    sendInputs();
+}
+
+void NetSession::receivePackets() {
+    while (transport.receive(packet)) {
+        stats.packetsReceived++;
+        handlePacket(packet);
+    }
+}
+
+// 数据包：[magic][发送者][玩家数][发送者已收到的各玩家输入帧数 × 玩家数]
+//         [首帧][帧数][(按键, 按下时长) × 帧数][摘要帧][摘要]
+void NetSession::handlePacket(const std::vector<std::uint8_t>& data) {
+    BinaryIO::Reader reader(data.data(), data.size());
+    if (reader.u32() != PACKET_MAGIC) return;
+
+    int sender = reader.u8();
+    int players = reader.u8();
+    if (!reader.good() || players != playerCount || sender >= playerCount || sender == localPlayer) return;
+
+    for (int player = 0; player < playerCount; player++) {
+        std::uint32_t ack = reader.u32();
+        if (player == localPlayer && reader.good()) {
+            peerAcks[sender] = std::max(peerAcks[sender], ack);
+        }
+    }
+
+    std::uint32_t firstTick = reader.u32();
+    std::uint32_t count = reader.u8();
+    for (std::uint32_t i = 0; i < count; i++) {
+        NetInput input;
+        input.buttons = reader.u8();
+        input.pressAgeMs = reader.u8();
+        if (!reader.good()) return;
+
+        std::uint32_t tick = firstTick + i;
+        if (tick < received[sender]) continue;                      // 已经有了
+        if (tick > received[sender]) break;                         // 中间缺帧，等对端重发
+        if (tick >= getConfirmedTick() + INPUT_WINDOW) break;       // 超出历史缓冲
+
+        inputAt(tick, sender) = input;
+        received[sender] = tick + 1;
+
+        // 这一帧已经用预测的输入模拟过，预测错了就要从这里重算
+        if (tick < currentTick && usedAt(tick, sender) != input) {
+            firstMismatch = std::min(firstMismatch, tick);
+        }
+    }
+
+    // 对端已确定帧的摘要与本机同一帧比较
+    std::uint32_t checksumTick = reader.u32();
+    std::uint32_t remoteChecksum = reader.u32();
+    if (!reader.good() || checksumTick == NO_TICK) return;
+    if (peerChecked[sender] != NO_TICK && checksumTick <= peerChecked[sender]) return;
+
+    std::uint32_t localChecksum;
+    if (getChecksum(checksumTick, localChecksum)) {
+        peerChecked[sender] = checksumTick;
+        stats.checksumsCompared++;
+        if (localChecksum != remoteChecksum) {
+            stats.desyncs++;
+        }
+    }
+}
+
+void NetSession::sendInputs() {
+    // 从最落后的对端尚未收到的帧开始发
+    std::uint32_t end = received[localPlayer];
+    std::uint32_t first = end;
+    for (int player = 0; player < playerCount; player++) {
+        if (player != localPlayer) {
+            first = std::min(first, peerAcks[player]);
+        }
+    }
+    std::uint32_t count = std::min(end - first, MAX_INPUTS_PER_PACKET);
+
+    packet.clear();
+    BinaryIO::putU32(packet, PACKET_MAGIC);
+    BinaryIO::putU8(packet, (std::uint8_t)localPlayer);
+    BinaryIO::putU8(packet, (std::uint8_t)playerCount);
+    for (int player = 0; player < playerCount; player++) {
+        BinaryIO::putU32(packet, received[player]);
+    }
+
+    BinaryIO::putU32(packet, first);
+    BinaryIO::putU8(packet, (std::uint8_t)count);
+    for (std::uint32_t i = 0; i < count; i++) {
+        const NetInput& input = inputAt(first + i, localPlayer);
+        BinaryIO::putU8(packet, input.buttons);
+        BinaryIO::putU8(packet, input.pressAgeMs);
+    }
+
+    std::uint32_t checksum = 0;
+    if (lastChecksumTick != NO_TICK) {
+        getChecksum(lastChecksumTick, checksum);
+    }
+    BinaryIO::putU32(packet, lastChecksumTick);
+    BinaryIO::putU32(packet, checksum);
+
+    transport.send(packet);
+    stats.packetsSent++;
+}
+
+void NetSession::rollback() {
+    // 预测正确时不会重算，已模拟的帧之后才确定；追上时当前状态就是最后一帧之后的状态
+    if (firstMismatch == NO_TICK || firstMismatch >= currentTick) {
+        firstMismatch = NO_TICK;
+        if (currentTick > 0 && getConfirmedTick() >= currentTick && lastChecksumTick != currentTick - 1) {
+            recordChecksum(currentTick - 1);
+        }
+        return;
+    }
+
+    std::uint32_t from = firstMismatch;
+    firstMismatch = NO_TICK;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 快照是模拟from之前保存的；重算过程中音效不重复播放
+    game.setReplaying(true);
+    snapshots->load(game, from);
+    for (std::uint32_t tick = from; tick < currentTick; tick++) {
+        simulate(tick, tick != from && tick >= getConfirmedTick());
+    }
+    game.setReplaying(false);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    int frames = (int)(currentTick - from);
+    stats.rollbacks++;
+    stats.resimulatedFrames += frames;
+    stats.maxRollbackFrames = std::max(stats.maxRollbackFrames, frames);
+    stats.maxResimMs = std::max(stats.maxResimMs, ms);
+    stats.totalResimMs += ms;
+}
+
+void NetSession::simulate(std::uint32_t tick, bool saveState) {
+    // 输入可能全部确定的帧不会再回滚到，不需要快照
+    if (saveState) {
+        snapshots->save(game, tick);
+    }
+
+    // 各玩家的输入合成一帧：第i名玩家的按键写到KEY_P{i+1}_*，Game按玩家拆分
+    InputFrame frame;
+    frame.time = tick * (double)NET_TICK_SECONDS;
+    bool confirmed = true;
+    for (int player = 0; player < playerCount; player++) {
+        NetInput input;
+        if (tick < received[player]) {
+            input = inputAt(tick, player);
+        }
+        else {
+            confirmed = false;
+            if (received[player] > 0) {
+                input = inputAt(received[player] - 1, player).predictNext();
+            }
+        }
+        usedAt(tick, player) = input;
+
+        const InputKey* keys = PLAYER_KEYS[player];
+        if (input.buttons & NetInput::LEFT) frame.held |= 1u << keys[0];
+        if (input.buttons & NetInput::RIGHT) frame.held |= 1u << keys[1];
+        if (input.buttons & NetInput::JUMP) frame.held |= 1u << keys[2];
+        if (input.buttons & NetInput::JUMP_PRESSED) {
+            frame.pressed |= 1u << keys[2];
+            frame.pressTime[keys[2]] = frame.time - input.pressAgeMs / 1000.0;
+        }
+    }
+
+    if (game.getState() == PLAYING) {
+        game.injectInput(frame);
+        game.updateGame(NET_TICK_SECONDS);
+    }
+
+    if (confirmed) {
+        recordChecksum(tick);
+    }
+}
+
+void NetSession::recordChecksum(std::uint32_t tick) {
+    checksums[tick % INPUT_WINDOW] = { tick, game.getChecksum() };
+    lastChecksumTick = tick;
+}
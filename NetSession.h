@@ -0,0 +1,133 @@
+#pragma once
+#include "Input.h"
+#include "NetTransport.h"
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+class Game;
+class SnapshotRing;
+
+// 联机对战固定使用60Hz逻辑帧，各端步长完全相同
+const float NET_TICK_SECONDS = 1.0f / 60.0f;
+
+// 一名玩家一帧的输入：联机时各端之间只交换它（2字节）
+struct NetInput {
+    enum Buttons {
+        LEFT = 1 << 0,
+        RIGHT = 1 << 1,
+        JUMP = 1 << 2,
+        JUMP_PRESSED = 1 << 3
+    };
+
+    std::uint8_t buttons;
+    std::uint8_t pressAgeMs;    // 跳跃键按下到采样经过的毫秒数（跳跃缓冲扣除已等待的部分）
+
+    NetInput() : buttons(0), pressAgeMs(0) {}
+
+    // 取单人按键（KEY_LEFT、KEY_RIGHT、KEY_SPACE）
+    static NetInput fromFrame(const InputFrame& frame);
+
+    // 远端输入未到时的预测：保持按住的键，不重复按下事件
+    NetInput predictNext() const;
+
+    bool operator==(const NetInput& other) const { return buttons == other.buttons && pressAgeMs == other.pressAgeMs; }
+    bool operator!=(const NetInput& other) const { return !(*this == other); }
+};
+
+// 联机统计
+struct NetStats {
+    long long ticks;                // 已模拟的帧数
+    long long stalls;               // 等待远端输入而没有推进的次数
+    long long rollbacks;
+    long long resimulatedFrames;
+    int maxRollbackFrames;
+    double maxResimMs;              // 单次回滚（恢复快照并重算到当前帧）的最长耗时
+    double totalResimMs;
+    long long packetsSent;
+    long long packetsReceived;
+    long long checksumsCompared;
+    long long desyncs;              // 与远端同一帧摘要不一致的次数
+
+    NetStats()
+        : ticks(0), stalls(0), rollbacks(0), resimulatedFrames(0), maxRollbackFrames(0),
+        maxResimMs(0), totalResimMs(0), packetsSent(0), packetsReceived(0),
+        checksumsCompared(0), desyncs(0) {
+    }
+};
+
+// 回滚联机：各端运行同一个确定性的模拟，只交换每帧的输入
+// - 本机输入延迟inputDelay帧生效，延迟以内的网络波动不会引起回滚
+// - 远端输入未到时按其上一帧预测并先行模拟；收到与预测不同的输入时，恢复到该帧之前的快照，
+//   用正确的输入重新模拟到当前帧
+// - 本机领先所有输入都已确定的帧MAX_ROLLBACK_FRAMES帧后暂停推进（退化为锁步），回滚深度因此有上界
+// - 每个数据包携带对端尚未确认收到的全部本机输入，丢包由之后的数据包补上
+// - 模拟时（含回滚重算）输入已全部确定的帧，以及本端追上确定帧时的最新帧，记录状态摘要并发给对端比较，
+//   用于发现不同步
+// 各端必须使用相同的种子、玩家数和inputDelay，Game需先调用startNetRun
+class NetSession {
+public:
+    static const int MAX_ROLLBACK_FRAMES = 8;
+    static const int INPUT_WINDOW = 64;                             // 输入历史的帧数
+    static const int SNAPSHOT_COUNT = MAX_ROLLBACK_FRAMES + 2;      // 快照环形缓冲的帧数
+    static const std::uint32_t NO_TICK = 0xFFFFFFFFu;
+
+private:
+    struct ChecksumRecord {
+        std::uint32_t tick;
+        std::uint32_t checksum;
+    };
+
+    Game& game;
+    NetTransport& transport;
+    int playerCount;
+    int localPlayer;
+    int inputDelay;
+
+    std::uint32_t currentTick;                  // 下一个要模拟的帧
+    std::vector<NetInput> inputs;               // [帧 % INPUT_WINDOW][玩家]：已知的真实输入
+    std::vector<NetInput> usedInputs;           // 模拟该帧时实际使用的输入（可能是预测）
+    std::vector<std::uint32_t> received;        // 各玩家已连续收到的输入帧数
+    std::vector<std::uint32_t> peerAcks;        // 各对端已收到的本机输入帧数
+    std::vector<std::uint32_t> peerChecked;     // 各对端已比较过摘要的最新帧
+    std::uint32_t firstMismatch;                // 需要从这一帧起重新模拟，没有时为NO_TICK
+
+    std::unique_ptr<SnapshotRing> snapshots;    // 第tick帧：模拟该帧之前的状态
+    std::vector<ChecksumRecord> checksums;      // [帧 % INPUT_WINDOW]：已确定帧模拟之后的摘要
+    std::uint32_t lastChecksumTick;
+
+    NetStats stats;
+    std::vector<std::uint8_t> packet;
+
+    NetInput& inputAt(std::uint32_t tick, int player) { return inputs[(tick % INPUT_WINDOW) * playerCount + player]; }
+    NetInput& usedAt(std::uint32_t tick, int player) { return usedInputs[(tick % INPUT_WINDOW) * playerCount + player]; }
+
+    void receivePackets();
+    void handlePacket(const std::vector<std::uint8_t>& data);
+    void sendInputs();
+    void rollback();
+    void simulate(std::uint32_t tick, bool saveState);
+    void recordChecksum(std::uint32_t tick);
+
+public:
+    NetSession(Game& game, NetTransport& transport, int playerCount, int localPlayer, int inputDelay = 2);
+    ~NetSession();
+
+    NetSession(const NetSession&) = delete;
+    NetSession& operator=(const NetSession&) = delete;
+
+    // 推进一帧：收包、必要时回滚重算，然后用本机这一帧的输入模拟新的一帧并发送
+    // 远端落后太多时本帧不模拟，返回false
+    bool advance(const InputFrame& localFrame);
+
+    // 只收发和回滚、不推进（本机结束后等待其余各端的输入全部到达）
+    void poll();
+
+    std::uint32_t getCurrentTick() const { return currentTick; }
+    std::uint32_t getConfirmedTick() const;     // 此前的帧所有玩家的输入都已确定
+
+    // 已确定帧的状态摘要，tick太旧（已被覆盖）或尚未确定时返回false
+    bool getChecksum(std::uint32_t tick, std::uint32_t& checksum) const;
+
+    const NetStats& getStats() const { return stats; }
+};
@@ -0,0 +1,202 @@
+#include "NetTransport.h"
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef SOCKET SocketHandle;
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+typedef int SocketHandle;
+#endif
+
+namespace {
+    const std::intptr_t INVALID_HANDLE = -1;
+    const size_t MAX_DATAGRAM = 1500;
+
+    // Winsock需要先初始化，进程内只做一次
+    bool initSockets() {
+#ifdef _WIN32
+        static bool initialized = false;
+        if (!initialized) {
+            WSADATA data;
+            initialized = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }
+        return initialized;
+#else
+        return true;
+#endif
+    }
+
+    bool wouldBlock() {
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+    }
+}
+
+std::unique_ptr<NetTransport> LoopbackHub::connect(int endpoint) {
+    return std::unique_ptr<NetTransport>(new LoopbackTransport(*this, endpoint));
+}
+
+void LoopbackTransport::send(const std::vector<std::uint8_t>& packet) {
+    std::lock_guard<std::mutex> lock(hub.mutex);
+    for (size_t i = 0; i < hub.inboxes.size(); i++) {
+        if ((int)i != endpoint) {
+            hub.inboxes[i].push_back(packet);
+        }
+    }
+}
+
+bool LoopbackTransport::receive(std::vector<std::uint8_t>& packet) {
+    std::lock_guard<std::mutex> lock(hub.mutex);
+    auto& inbox = hub.inboxes[endpoint];
+    if (inbox.empty()) return false;
+
+    packet.swap(inbox.front());
+    inbox.pop_front();
+    return true;
+}
+
+UdpTransport::UdpTransport() : socketHandle(INVALID_HANDLE) {
+}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open(std::uint16_t localPort, const std::vector<std::string>& peerAddresses) {
+    close();
+    if (!initSockets()) return false;
+
+    peers.clear();
+    for (const auto& text : peerAddresses) {
+        size_t colon = text.rfind(':');
+        if (colon == std::string::npos) return false;
+
+        in_addr address;
+        if (inet_pton(AF_INET, text.substr(0, colon).c_str(), &address) != 1) return false;
+        peers.push_back({ ntohl(address.s_addr), (std::uint16_t)atoi(text.c_str() + colon + 1) });
+    }
+
+    std::intptr_t handle = (std::intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_HANDLE) return false;
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(localPort);
+
+    // 非阻塞：receive在没有数据时立即返回
+    bool ok = bind((SocketHandle)handle, (sockaddr*)&local, sizeof(local)) == 0;
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ok = ok && ioctlsocket((SocketHandle)handle, FIONBIO, &nonBlocking) == 0;
+#else
+    ok = ok && fcntl((int)handle, F_SETFL, fcntl((int)handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    socketHandle = handle;
+    if (!ok) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void UdpTransport::close() {
+    if (socketHandle == INVALID_HANDLE) return;
+#ifdef _WIN32
+    closesocket((SocketHandle)socketHandle);
+#else
+    ::close((int)socketHandle);
+#endif
+    socketHandle = INVALID_HANDLE;
+}
+
+bool UdpTransport::isOpen() const {
+    return socketHandle != INVALID_HANDLE;
+}
+
+void UdpTransport::send(const std::vector<std::uint8_t>& packet) {
+    if (!isOpen()) return;
+
+    for (const auto& peer : peers) {
+        sockaddr_in target = {};
+        target.sin_family = AF_INET;
+        target.sin_addr.s_addr = htonl(peer.address);
+        target.sin_port = htons(peer.port);
+        sendto((SocketHandle)socketHandle, (const char*)packet.data(), (int)packet.size(), 0,
+            (const sockaddr*)&target, sizeof(target));
+    }
+}
+
+bool UdpTransport::receive(std::vector<std::uint8_t>& packet) {
+    if (!isOpen()) return false;
+
+    // 对端尚未启动时，Windows会把ICMP端口不可达报告为接收错误，跳过这类错误继续读
+    for (int attempt = 0; attempt < 16; attempt++) {
+        packet.resize(MAX_DATAGRAM);
+        sockaddr_in source;
+        socklen_t sourceSize = sizeof(source);
+        int size = (int)recvfrom((SocketHandle)socketHandle, (char*)packet.data(), (int)packet.size(), 0,
+            (sockaddr*)&source, &sourceSize);
+        if (size >= 0) {
+            packet.resize(size);
+            return true;
+        }
+        if (wouldBlock()) break;
+    }
+    packet.clear();
+    return false;
+}
+
+LatencyInjector::LatencyInjector(NetTransport& inner, int latencyMs, int jitterMs, float lossRate, unsigned int seed)
+    : inner(inner), latencyMs(std::max(0, latencyMs)), jitterMs(std::max(0, jitterMs)), lossRate(lossRate),
+    random(seed != 0 ? seed : 1), startTime(std::chrono::steady_clock::now()) {
+}
+
+double LatencyInjector::nowMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void LatencyInjector::flush() {
+    double now = nowMs();
+    for (size_t i = 0; i < pending.size();) {
+        if (pending[i].dueMs <= now) {
+            inner.send(pending[i].packet);
+            if (i + 1 < pending.size()) {
+                pending[i] = std::move(pending.back());
+            }
+            pending.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void LatencyInjector::send(const std::vector<std::uint8_t>& packet) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    if (unit(random) < lossRate) return;
+
+    double delay = latencyMs;
+    if (jitterMs > 0) {
+        delay += std::uniform_int_distribution<int>(-jitterMs, jitterMs)(random);
+    }
+    pending.push_back({ nowMs() + std::max(0.0, delay), packet });
+    flush();
+}
+
+bool LatencyInjector::receive(std::vector<std::uint8_t>& packet) {
+    flush();
+    return inner.receive(packet);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <chrono>
+
+// 数据报传输：与UDP语义相同，不保证送达和顺序；send发给所有对端，receive不阻塞
+class NetTransport {
+public:
+    virtual ~NetTransport() = default;
+    virtual void send(const std::vector<std::uint8_t>& packet) = 0;
+    virtual bool receive(std::vector<std::uint8_t>& packet) = 0;
+};
+
+// 进程内回环：同一个LoopbackHub上的各端点互相收发，可以在不同线程中使用
+class LoopbackHub {
+private:
+    friend class LoopbackTransport;
+
+    std::mutex mutex;
+    std::vector<std::deque<std::vector<std::uint8_t>>> inboxes;
+
+public:
+    explicit LoopbackHub(int endpoints) : inboxes(endpoints) {}
+
+    std::unique_ptr<NetTransport> connect(int endpoint);
+};
+
+class LoopbackTransport : public NetTransport {
+private:
+    LoopbackHub& hub;
+    int endpoint;
+
+public:
+    LoopbackTransport(LoopbackHub& hub, int endpoint) : hub(hub), endpoint(endpoint) {}
+
+    void send(const std::vector<std::uint8_t>& packet) override;
+    bool receive(std::vector<std::uint8_t>& packet) override;
+};
+
+// UDP：绑定本机端口，向每个对端地址发送一份（本机多进程或局域网对战）
+class UdpTransport : public NetTransport {
+private:
+    struct Peer {
+        std::uint32_t address;      // 主机字节序
+        std::uint16_t port;
+    };
+
+    std::intptr_t socketHandle;
+    std::vector<Peer> peers;
+
+public:
+    UdpTransport();
+    ~UdpTransport();
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // peerAddresses形如"127.0.0.1:47101"
+    bool open(std::uint16_t localPort, const std::vector<std::string>& peerAddresses);
+    void close();
+    bool isOpen() const;
+
+    void send(const std::vector<std::uint8_t>& packet) override;
+    bool receive(std::vector<std::uint8_t>& packet) override;
+};
+
+// 网络条件模拟：给发出的数据包加上固定延迟、随机抖动和丢包，抖动可能使包乱序
+// 包在一层传输之外，各端都包一层即为双向；随机数独立于游戏模拟
+class LatencyInjector : public NetTransport {
+private:
+    struct DelayedPacket {
+        double dueMs;
+        std::vector<std::uint8_t> packet;
+    };
+
+    NetTransport& inner;
+    int latencyMs;
+    int jitterMs;
+    float lossRate;
+    std::minstd_rand random;
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<DelayedPacket> pending;
+
+    double nowMs() const;
+    void flush();
+
+public:
+    LatencyInjector(NetTransport& inner, int latencyMs, int jitterMs, float lossRate, unsigned int seed);
+
+    void send(const std::vector<std::uint8_t>& packet) override;
+    bool receive(std::vector<std::uint8_t>& packet) override;
+};
@@ -1,10 +1,10 @@
 #include "Player.h"
 #include "Theme.h"
-#include "AudioManager.h"
-#include <graphics.h>
-#include <windows.h>
+#include "JobSystem.h"
+#include "MemoryStats.h"
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
 
 // 静态常量定义
 const float Player::GRAVITY = 600.0f;
@@ -12,99 +12,59 @@ const float Player::JUMP_SPEED = -400.0f;
 const float Player::MOVE_SPEED = 300.0f;
 const float Player::FRICTION = 0.8f;
 const float Player::MAX_FALL_SPEED = 500.0f;
+const float Player::JUMP_BUFFER_TIME = 0.1f;
+const float Player::COYOTE_TIME = 0.08f;
+const int Player::BASE_MAX_JUMPS = 2;
+const float Player::COMBO_TIMEOUT = 3.0f;
+
+// 粒子并行积分的分段大小，粒子更少时直接在本线程执行
+static const size_t PARTICLE_GRAIN = 256;
 
 Player::Player(float x, float y)
-    : x(x), y(y), vx(0), vy(0), width(30), height(30),
-    onGround(false), wasOnGround(false), jumpCount(0), maxJumps(2),
+    : x(x), y(y), prevX(x), prevY(y), vx(0), vy(0), width(30), height(30),
+    onGround(false), wasOnGround(false), jumpCount(0),
+    jumpBufferTimer(0.0f), coyoteTimer(0.0f),
     currentColor(Theme::PLAYER_MAIN), pulseTimer(0.0f),
-    speedBoostTimer(0.0f), shieldTimer(0.0f), hasShieldActive(false), shieldUsed(false),
-    doubleJumpTimer(0.0f), slowTimeTimer(0.0f), magneticFieldTimer(0.0f), freezeObstaclesTimer(0.0f),
-    invincibilityTimer(0.0f), hasInvincibility(false),
+    effectCount(0), shieldUsed(false), timers(nullptr), timerOwner(0), events(nullptr),
     health(3), maxHealth(3), invulnerabilityTimer(0.0f), coins(0),
-    timeScaleFactor(1.0f), magnetRadius(0.0f), hasDoubleJump(false), obstaclesFrozen(false),
-    comboCount(0), comboTimer(0.0f), lastLandingTime(0.0f),
+    comboCount(0), comboTimer(NULL_TIMER), lastLandingTime(0.0f),
     lastPlatformY(0.0f), hasValidLastPlatform(false), currentPlatformY(0.0f), 
     shakeIntensity(0.0f), shakeTimer(0.0f),
     bonusScore(0), itemsCollected(0) {
 }
 
-void Player::update(float deltaTime) {
-    // 应用时间缩放
-    float effectiveDeltaTime = deltaTime * timeScaleFactor;
+void Player::update(const GameClock& clock) {
+    // 物理按游戏层时间（时间减缓作用于此层），输入相关的计时按总时间，屏幕震动按界面时间
+    // 道具效果和连击的到期由时间轮触发，见onTimer
+    float deltaTime = clock.getDelta(TIME_GLOBAL);
+    float effectiveDeltaTime = clock.getDelta(TIME_GAMEPLAY);
 
     pulseTimer += effectiveDeltaTime;
 
-    // 更新道具效果计时器
-    if (speedBoostTimer > 0) {
-        speedBoostTimer -= deltaTime;
-    }
-
-    if (shieldTimer > 0) {
-        shieldTimer -= deltaTime;
-        if (shieldTimer <= 0) {
-            hasShieldActive = false;
-        }
-    }
-
-    // 更新新道具效果
-    if (doubleJumpTimer > 0) {
-        doubleJumpTimer -= deltaTime;
-        if (doubleJumpTimer <= 0) {
-            hasDoubleJump = false;
-            maxJumps = 2;  // 恢复到2段跳
-        }
-    }
-
-    if (slowTimeTimer > 0) {
-        slowTimeTimer -= deltaTime;
-        if (slowTimeTimer <= 0) {
-            timeScaleFactor = 1.0f;  // 恢复正常时间
-        }
-    }
-
-    if (magneticFieldTimer > 0) {
-        magneticFieldTimer -= deltaTime;
-        if (magneticFieldTimer <= 0) {
-            magnetRadius = 0.0f;
-        }
-    }
-
-    if (freezeObstaclesTimer > 0) {
-        freezeObstaclesTimer -= deltaTime;
-        if (freezeObstaclesTimer <= 0) {
-            obstaclesFrozen = false;
-        }
-    }
-
     if (invulnerabilityTimer > 0) {
         invulnerabilityTimer -= deltaTime;
     }
 
-    // 更新无敌计时器
-    if (invincibilityTimer > 0) {
-        invincibilityTimer -= deltaTime;
-        if (invincibilityTimer <= 0) {
-            hasInvincibility = false;
-        }
-    }
-
-    // 更新连击计时器
-    if (comboTimer > 0) {
-        comboTimer -= deltaTime;
-        if (comboTimer <= 0) {
-            resetCombo();
-        }
-    }
-
     // 更新屏幕震动
     if (shakeTimer > 0) {
-        shakeTimer -= deltaTime;
+        shakeTimer -= clock.getDelta(TIME_UI);
         shakeIntensity *= 0.95f;  // 震动衰减
         if (shakeTimer <= 0) {
             shakeIntensity = 0;
         }
     }
 
+    // 跳跃缓冲和土狼时间按真实时间计算
+    if (jumpBufferTimer > 0) {
+        jumpBufferTimer -= deltaTime;
+    }
+    if (onGround) {
+        coyoteTimer = COYOTE_TIME;
+    }
+    else if (coyoteTimer > 0) {
+        coyoteTimer -= deltaTime;
+    }
+
     // 重力应用
     if (!onGround) {
         vy += GRAVITY * effectiveDeltaTime;
@@ -124,6 +84,8 @@ void Player::update(float deltaTime) {
     vx *= FRICTION;
 
     // 更新位置
+    prevX = x;
+    prevY = y;
     x += vx * effectiveDeltaTime;
     y += vy * effectiveDeltaTime;
 
@@ -142,14 +104,7 @@ void Player::setOnGround(bool grounded) {
 
     if (onGround && !wasOnGround && vy > 0) {
         jumpCount = 0;
-
-        // 播放着陆音效
-        AudioManager::getInstance().playSound(SoundType::LAND, false);
-
-        createLandingParticles();
-
-        // 着陆震动
-        addScreenShake(2.0f);
+        emit(EVENT_LANDED);
         lastLandingTime = pulseTimer;
     }
 }
@@ -167,47 +122,33 @@ void Player::getShakeOffset(float& shakeX, float& shakeY) const {
 
 void Player::moveLeft() {
     float speed = MOVE_SPEED;
-    if (speedBoostTimer > 0) speed *= 1.5f;  // 加速效果
+    speed *= getSpeedMultiplier();  // 加速效果
     vx -= speed;
-
-    // 添加移动粒子效果
-    if (speedBoostTimer > 0 && rand() % 3 == 0) {
-        createSpeedParticles();
-    }
 }
 
 void Player::moveRight() {
     float speed = MOVE_SPEED;
-    if (speedBoostTimer > 0) speed *= 1.5f;  // 加速效果
+    speed *= getSpeedMultiplier();  // 加速效果
     vx += speed;
-
-    // 添加移动粒子效果
-    if (speedBoostTimer > 0 && rand() % 3 == 0) {
-        createSpeedParticles();
-    }
 }
 
 void Player::jump() {
-    if (onGround || jumpCount < maxJumps) {
+    if (canJump()) {
+        // 土狼时间内的起跳按地面起跳计算，不消耗空中跳跃次数
+        if (!onGround && coyoteTimer > 0) {
+            jumpCount = 0;
+        }
+        coyoteTimer = 0.0f;
+
         vy = JUMP_SPEED;
         onGround = false;
         jumpCount++;
-
-        // 播放跳跃音效
-        try {
-            AudioManager::getInstance().playSound(SoundType::JUMP, false);
-        }catch(...){}
-        createJumpParticles();
-        addScreenShake(1.5f);
+        emit(EVENT_JUMPED, jumpCount);  // 二段跳的特效由事件的value区分
 
         // 跳跃时重置连击计时器（保持连击）
         if (comboCount > 0) {
-            comboTimer = 3.0f;  // 重置连击计时器
-        }
-
-        // 二段跳的特殊效果
-        if (jumpCount > 1) {
-            createDoubleJumpParticles();
+            comboTimer = timers->reschedule(comboTimer, COMBO_TIMEOUT,
+                TimerEvent{ TIMER_COMBO_TIMEOUT, (std::uint8_t)timerOwner, 0 });  // 重置连击计时器
         }
     }
 }
@@ -218,12 +159,13 @@ void Player::updateComboSystem(float platformY) {
     // 检查是否应该增加combo
     if (shouldIncrementCombo(platformY)) {
         comboCount++;
-        comboTimer = 3.0f;  // 3秒内必须继续跳跃才能保持连击
+        // 3秒内必须继续跳跃才能保持连击
+        comboTimer = timers->reschedule(comboTimer, COMBO_TIMEOUT,
+            TimerEvent{ TIMER_COMBO_TIMEOUT, (std::uint8_t)timerOwner, 0 });
 
         // 连击特效
         if (comboCount > 3) {
-            AudioManager::getInstance().playSound(SoundType::COMBO_SOUND, false);
-            createComboEffect();
+            emit(EVENT_COMBO, comboCount);
         }
     }
 
@@ -260,39 +202,96 @@ void Player::resetComboSystem() {
     currentPlatformY = 0.0f;
 }
 
-void Player::applySpeedBoost() {
-    speedBoostTimer = 5.0f;
+// 按数据表拾取道具：一次性效果、持续效果、加分依次生效，音效和特效由EVENT_ITEM_PICKED的处理方按同一张表播放
+void Player::applyItem(ItemType type, int value) {
+    const PowerUpDef& def = getPowerUpDef(type);
+    emit(EVENT_ITEM_PICKED, type);
+
+    switch (def.instant) {
+    case INSTANT_HEAL:
+        heal((int)def.strength);
+        break;
+    case INSTANT_COIN:
+        collectCoin(value);
+        break;
+    default:
+        break;
+    }
+
+    if (def.duration > 0) {
+        int index = findEffectIndex(type);
+        if (index < 0) {
+            index = effectCount++;
+            effects[index].type = type;
+            effects[index].expiry = NULL_TIMER;
+        }
+        ActiveEffect& effect = effects[index];
+        float duration = def.stacking == STACK_EXTEND ? timers->timeLeft(effect.expiry) + def.duration : def.duration;
+        effect.expiry = timers->reschedule(effect.expiry, duration,
+            TimerEvent{ TIMER_EFFECT_EXPIRED, (std::uint8_t)timerOwner, (std::uint32_t)type });
+        effect.strength = def.strength;
+
+        if (type == SHIELD) {
+            shieldUsed = false;
+        }
+    }
 
-    // 播放道具收集音效
-    AudioManager::getInstance().playSound(SoundType::ITEM_COLLECT, false);
+    addBonusScore(def.bonusScore);
+    if (def.countsAsItem) {
+        incrementItemsCollected();
+    }
+}
 
-    createSpeedBoostEffect();
-    addBonusScore(50);
-    incrementItemsCollected();
+// 到期的效果用末尾一项填补，保持数组紧凑
+void Player::removeEffect(int index) {
+    timers->cancel(effects[index].expiry);
+    effects[index] = effects[--effectCount];
 }
 
-void Player::applyShield() {
-    hasShieldActive = true;
-    shieldTimer = 10.0f;
-    shieldUsed = false;
+void Player::onTimer(const TimerEvent& event) {
+    switch (event.kind) {
+    case TIMER_EFFECT_EXPIRED: {
+        int index = findEffectIndex((ItemType)event.data);
+        if (index >= 0) {
+            removeEffect(index);
+        }
+        break;
+    }
+    case TIMER_COMBO_TIMEOUT:
+        comboTimer = NULL_TIMER;
+        resetCombo();
+        break;
+    default:
+        break;
+    }
+}
 
-    AudioManager::getInstance().playSound(SoundType::SHIELD_ACTIVATE, false);
+void Player::emit(GameEventType type, int value) {
+    if (events) events->push(type, timerOwner, value);
+}
 
-    createShieldActivateEffect();
-    addBonusScore(100);
-    incrementItemsCollected();
+int Player::findEffectIndex(ItemType type) const {
+    for (int i = 0; i < effectCount; i++) {
+        if (effects[i].type == type) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-void Player::applyInvincibility() {
-    invincibilityTimer = 8.0f;
-    hasInvincibility = true;
+const ActiveEffect* Player::findEffect(ItemType type) const {
+    int index = findEffectIndex(type);
+    return index >= 0 ? &effects[index] : nullptr;
+}
 
-    // 播放无敌音效
-    AudioManager::getInstance().playSound(SoundType::INVINCIBILITY, false);
+float Player::getEffectStrength(ItemType type, float inactiveValue) const {
+    const ActiveEffect* effect = findEffect(type);
+    return effect ? effect->strength : inactiveValue;
+}
 
-    addBonusScore(150);
-    incrementItemsCollected();
-    createInvincibilityEffect();
+float Player::getEffectTimeLeft(ItemType type) const {
+    const ActiveEffect* effect = findEffect(type);
+    return effect ? timers->timeLeft(effect->expiry) : 0.0f;
 }
 
 // 添加奖励分数
@@ -308,8 +307,10 @@ void Player::addBonusScore(int points) {
 
 // 消耗护盾（用于复活）
 void Player::consumeShield() {
-    hasShieldActive = false;
-    shieldTimer = 0.0f;
+    int index = findEffectIndex(SHIELD);
+    if (index >= 0) {
+        removeEffect(index);
+    }
     shieldUsed = true;
 }
 
@@ -319,21 +320,23 @@ void Player::addCombo() {
 
 void Player::resetCombo() {
     comboCount = 0;
-    comboTimer = 0.0f;
+    timers->cancel(comboTimer);
+    comboTimer = NULL_TIMER;
     resetComboSystem();  // 同时重置combo系统
 }
 
 void Player::createJumpParticles() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 8; i++) {
         float angle = (float)i / 8.0f * 6.28f;  // 2π
-        float speed = 50.0f + rand() % 50;
+        float speed = 50.0f + particles.random() % 50;
         float px = x + width / 2;
         float py = y + height;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * speed, sin(angle) * speed - 20,
-            0.8f + (rand() % 40) * 0.01f,
+            0.8f + (particles.random() % 40) * 0.01f,
             Theme::PARTICLE_JUMP
         ));
     }
@@ -341,13 +344,14 @@ void Player::createJumpParticles() {
 
 // 无敌激活特效
 void Player::createInvincibilityEffect() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 30; i++) {
         float angle = (float)i / 30.0f * 6.28f;
-        float radius = 30 + rand() % 20;
+        float radius = 30 + particles.random() % 20;
         float px = x + width / 2 + cos(angle) * radius;
         float py = y + height / 2 + sin(angle) * radius;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * 30, sin(angle) * 30,
             2.5f,
@@ -357,15 +361,16 @@ void Player::createInvincibilityEffect() {
 }
 
 void Player::createLandingParticles() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 5; i++) {
-        float px = x + (rand() % (int)width);
+        float px = x + (particles.random() % (int)width);
         float py = y + height;
-        float vx = (rand() % 100 - 50) * 0.5f;
+        float vx = (particles.random() % 100 - 50) * 0.5f;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
-            vx, -30.0f - rand() % 20,
-            1.0f + (rand() % 30) * 0.01f,
+            vx, -30.0f - particles.random() % 20,
+            1.0f + (particles.random() % 30) * 0.01f,
             Theme::PARTICLE_LAND
         ));
     }
@@ -373,16 +378,17 @@ void Player::createLandingParticles() {
 
 // 二段跳粒子效果
 void Player::createDoubleJumpParticles() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 12; i++) {
         float angle = (float)i / 12.0f * 6.28f;
-        float speed = 80.0f + rand() % 40;
+        float speed = 80.0f + particles.random() % 40;
         float px = x + width / 2;
         float py = y + height / 2;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * speed, sin(angle) * speed,
-            1.0f + (rand() % 50) * 0.01f,
+            1.0f + (particles.random() % 50) * 0.01f,
             Theme::ACCENT
         ));
     }
@@ -390,18 +396,19 @@ void Player::createDoubleJumpParticles() {
 
 // 速度粒子效果
 void Player::createSpeedParticles() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 3; i++) {
-        float px = x + rand() % (int)width;
-        float py = y + rand() % (int)height;
+        float px = x + particles.random() % (int)width;
+        float py = y + particles.random() % (int)height;
 
         // 根据玩家移动方向创建相反方向的粒子效果
         float direction = (this->vx > 0) ? -1.0f : 1.0f;
-        float particleSpeed = direction * (50 + rand() % 30);
+        float particleSpeed = direction * (50 + particles.random() % 30);
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
-            particleSpeed, (rand() % 20 - 10) * 0.5f,
-            0.5f + (rand() % 30) * 0.01f,
+            particleSpeed, (particles.random() % 20 - 10) * 0.5f,
+            0.5f + (particles.random() % 30) * 0.01f,
             Theme::PARTICLE_SPEED
         ));
     }
@@ -409,13 +416,14 @@ void Player::createSpeedParticles() {
 
 // 速度提升激活特效
 void Player::createSpeedBoostEffect() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 16; i++) {
         float angle = (float)i / 16.0f * 6.28f;
-        float speed = 100.0f + rand() % 50;
+        float speed = 100.0f + particles.random() % 50;
         float px = x + width / 2;
         float py = y + height / 2;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * speed, sin(angle) * speed,
             1.5f,
@@ -426,13 +434,14 @@ void Player::createSpeedBoostEffect() {
 
 // 护盾激活特效
 void Player::createShieldActivateEffect() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     for (int i = 0; i < 20; i++) {
         float angle = (float)i / 20.0f * 6.28f;
-        float radius = 25 + rand() % 10;
+        float radius = 25 + particles.random() % 10;
         float px = x + width / 2 + cos(angle) * radius;
         float py = y + height / 2 + sin(angle) * radius;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * 20, sin(angle) * 20,
             2.0f,
@@ -443,6 +452,7 @@ void Player::createShieldActivateEffect() {
 
 // 连击特效
 void Player::createComboEffect() {
+    MemoryScope memoryScope(MEM_PARTICLES);
     COLORREF comboColor = DrawUtils::getComboColor(comboCount);
 
     for (int i = 0; i < 6; i++) {
@@ -450,7 +460,7 @@ void Player::createComboEffect() {
         float px = x + width / 2 + cos(angle) * 15;
         float py = y + height / 2 + sin(angle) * 15;
 
-        particles.push_back(Particle(
+        particles.items.push_back(Particle(
             px, py,
             cos(angle) * 30, sin(angle) * 30 - 20,
             1.0f,
@@ -460,36 +470,25 @@ void Player::createComboEffect() {
 }
 
 void Player::updateParticles(float deltaTime) {
-    for (auto it = particles.begin(); it != particles.end();) {
-        it->x += it->vx * deltaTime;
-        it->y += it->vy * deltaTime;
-        it->vy += 200.0f * deltaTime;  // 重力
-        it->life -= deltaTime;
-
-        if (it->life <= 0) {
-            it = particles.erase(it);
+    // 粒子之间互不影响：分段并行积分，再统一移除寿命耗尽的粒子
+    Particle* particleData = particles.items.data();
+    JobSystem::getInstance().parallelFor(particles.items.size(), PARTICLE_GRAIN, [particleData, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Particle& particle = particleData[i];
+            particle.x += particle.vx * deltaTime;
+            particle.y += particle.vy * deltaTime;
+            particle.vy += 200.0f * deltaTime;  // 重力
+            particle.life -= deltaTime;
         }
-        else {
-            ++it;
-        }
-    }
-}
+    });
 
-void Player::drawParticles(float offsetX, float offsetY) {
-    for (const auto& particle : particles) {
-        float alpha = particle.life / particle.maxLife;
-        if (alpha > 0) {
-            // 使用Theme.cpp中的drawParticle函数
-            DrawUtils::drawParticle(particle.x + offsetX, particle.y + offsetY,
-                3.0f * alpha, particle.color, alpha);
+    particles.items.erase(std::remove_if(particles.items.begin(), particles.items.end(),
+        [](const Particle& particle) { return particle.life <= 0; }), particles.items.end());
+}
 
-            // 为特殊粒子添加光晕效果
-            if (particle.color == Theme::ITEM_SPEED_PARTICLE ||
-                particle.color == Theme::ITEM_SHIELD_PARTICLE) {
-                DrawUtils::drawSparkle(particle.x + offsetX, particle.y + offsetY,
-                    6.0f * alpha, particle.color, pulseTimer);
-            }
-        }
+void Player::updateSpeedTrail() {
+    if (hasSpeedBoost() && vx != 0.0f && particles.random() % 3 == 0) {
+        createSpeedParticles();
     }
 }
 
@@ -498,195 +497,50 @@ void Player::addScreenShake(float intensity) {
     shakeTimer = 0.3f;
 }
 
-void Player::draw() {
-    drawWithOffset(0, 0);
-}
-
-void Player::drawWithOffset(float offsetX, float offsetY) {
-    float drawX = x + offsetX;
-    float drawY = y + offsetY;
-
-    // 使用AnimationUtils进行脉动效果
-    float pulse = AnimationUtils::pulse(pulseTimer, 2.0f);
-
-    // 道具效果增强
-    if (speedBoostTimer > 0) {
-        // 使用Theme.cpp中的drawSpeedEffect
-        DrawUtils::drawSpeedEffect(drawX, drawY, width, height,
-            AnimationUtils::pulse(pulseTimer, 4.0f));
-
-        // 速度轨迹效果
-        for (int i = 1; i <= 3; i++) {
-            float trailAlpha = 0.3f / i;
-            float trailX = drawX - vx * 0.01f * i;
-            float trailY = drawY - vy * 0.01f * i;
-
-            COLORREF trailColor = DrawUtils::blendColor(Theme::PLAYER_SPEED_EFFECT,
-                RGB(255, 255, 255), trailAlpha);
-            setfillcolor(trailColor);
-            solidrectangle((int)trailX, (int)trailY,
-                (int)(trailX + width), (int)(trailY + height));
-        }
-    }
-
-    if (hasShieldActive) {
-        // 使用Theme.cpp中的drawShieldEffect
-        DrawUtils::drawShieldEffect(drawX + width / 2, drawY + height / 2,
-            25, AnimationUtils::pulse(pulseTimer, 3.0f));
-
-        // 额外的护盾光环
-        float shieldPulse = AnimationUtils::pulse(pulseTimer, 2.0f);
-        DrawUtils::drawGlowCircle((int)(drawX + width / 2), (int)(drawY + height / 2),
-            (int)(20 + 5 * shieldPulse), Theme::SHIELD_GLOW, 0.4f);
-    }
-
-    // 无敌效果绘制
-    if (hasInvincibilityActive()) {
-        // 绘制无敌光环
-        float invincibilityPulse = AnimationUtils::pulse(pulseTimer, 4.0f);
-        COLORREF invincibilityColor = RGB(255, 215, 0);  // 金色
-
-        // 绘制多层无敌光环
-        for (int i = 0; i < 3; i++) {
-            float radius = 35 + i * 10 + invincibilityPulse * 5;
-            float alpha = 0.3f - i * 0.1f;
-            DrawUtils::drawGlowCircle((int)(drawX + width / 2), (int)(drawY + height / 2),
-                (int)radius, invincibilityColor, alpha);
-        }
-
-        // 绘制星星特效
-        for (int i = 0; i < 8; i++) {
-            float angle = (float)i / 8.0f * 6.28f + pulseTimer * 2.0f;
-            float starRadius = 40 + sin(pulseTimer * 3.0f + i) * 10;
-            float starX = drawX + width / 2 + cos(angle) * starRadius;
-            float starY = drawY + height / 2 + sin(angle) * starRadius;
-            DrawUtils::drawSparkle(starX, starY, 6.0f, invincibilityColor, pulseTimer + i);
-        }
-    }
-
-    // 绘制玩家光晕（根据状态）
-    COLORREF glowColor = Theme::PLAYER_MAIN;
-    float glowIntensity = 0.3f;
-
-    if (speedBoostTimer > 0) {
-        glowColor = Theme::SPEED_GLOW;
-        glowIntensity = 0.6f;
-    }
-    if (hasShieldActive) {
-        glowColor = Theme::SHIELD_GLOW;
-        glowIntensity = 0.5f;
-    }
-    // 无敌状态光晕
-    if (hasInvincibilityActive()) {
-        glowColor = RGB(255, 215, 0);  // 金色光晕
-        glowIntensity = 0.8f;
-    }
-
-    // 连击光晕
-    if (comboCount > 5) {
-        glowColor = DrawUtils::getComboColor(comboCount);
-        glowIntensity = 0.4f + 0.3f * AnimationUtils::pulse(pulseTimer, 5.0f);
-    }
-
-    DrawUtils::drawGlowRect((int)drawX, (int)drawY, (int)width, (int)height,
-        glowColor, glowIntensity);
-
-    // 绘制阴影
-    setfillcolor(RGB(50, 50, 50));
-    solidrectangle((int)(drawX + 2), (int)(drawY + 2),
-        (int)(drawX + width + 2), (int)(drawY + height + 2));
-
-    // 绘制玩家主体（使用颜色动画）
-    COLORREF playerColor = Theme::PLAYER_MAIN;
-
-    if (speedBoostTimer > 0) {
-        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
-            Theme::PLAYER_SPEED_EFFECT, pulseTimer, 4.0f);
-    }
-    if (hasShieldActive) {
-        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
-            Theme::PLAYER_SHIELD_EFFECT, pulseTimer, 3.0f);
-    }
-    // 无敌状态颜色
-    if (hasInvincibilityActive()) {
-        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
-            RGB(255, 215, 0), pulseTimer, 5.0f);
-    }
-
-    setfillcolor(playerColor);
-    solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
-
-    // 绘制高光
-    setfillcolor(RGB(255, 255, 255));
-    solidrectangle((int)(drawX + 2), (int)(drawY + 2),
-        (int)(drawX + width - 2), (int)(drawY + 8));
-
-    // 绘制边框
-    setlinecolor(RGB(255, 255, 255));
-    setlinestyle(PS_SOLID, 2);
-    rectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
-
-    // 绘制粒子效果
-    drawParticles(offsetX, offsetY);
-}
-
-void Player::handleInput() {
+void Player::applyInput(const InputFrame& input) {
     // 移动输入
-    if (GetAsyncKeyState('A') & 0x8000 || GetAsyncKeyState(VK_LEFT) & 0x8000) {
+    if (input.isDown(KEY_LEFT)) {
         moveLeft();
     }
-    if (GetAsyncKeyState('D') & 0x8000 || GetAsyncKeyState(VK_RIGHT) & 0x8000) {
+    if (input.isDown(KEY_RIGHT)) {
         moveRight();
     }
 
-    // 跳跃输入
-    static bool spacePressed = false;
-    bool spaceDown = GetAsyncKeyState(VK_SPACE) & 0x8000;
-
-    if (spaceDown && !spacePressed) {
+    // 跳跃输入：帧内的短按也会记录；按下后已经过去的时间从缓冲窗口中扣除
+    if (input.wasPressed(KEY_SPACE)) {
+        jumpBufferTimer = JUMP_BUFFER_TIME - input.pressAge(KEY_SPACE);
+    }
+    if (jumpBufferTimer > 0 && canJump()) {
         jump();
+        jumpBufferTimer = 0.0f;
     }
-    spacePressed = spaceDown;
 }
 
 void Player::reset() {
     x = 100;
     y = 400;
+    prevX = x;
+    prevY = y;
     vx = 0;
     vy = 0;
     onGround = false;
     wasOnGround = false;
     jumpCount = 0;
+    jumpBufferTimer = 0.0f;
+    coyoteTimer = 0.0f;
     pulseTimer = 0.0f;
 
     // 重置道具效果
-    speedBoostTimer = 0.0f;
-    shieldTimer = 0.0f;
-    hasShieldActive = false;
+    while (effectCount > 0) {
+        removeEffect(effectCount - 1);
+    }
     shieldUsed = false;
 
-    // 重置新道具效果
-    doubleJumpTimer = 0.0f;
-    slowTimeTimer = 0.0f;
-    magneticFieldTimer = 0.0f;
-    freezeObstaclesTimer = 0.0f;
-
-    // 重置无敌状态
-    invincibilityTimer = 0.0f;
-    hasInvincibility = false;
-
     // 重置玩家状态
     health = maxHealth = 3;
     invulnerabilityTimer = 0.0f;
     coins = 0;
 
-    // 重置道具效果强度
-    timeScaleFactor = 1.0f;
-    magnetRadius = 0.0f;
-    hasDoubleJump = false;
-    obstaclesFrozen = false;
-    maxJumps = 2;
-
     // 重置连击
     resetCombo();
 
@@ -695,7 +549,7 @@ void Player::reset() {
     itemsCollected = 0;
 
     // 清除粒子
-    particles.clear();
+    particles.items.clear();
 
     // 重置震动
     shakeIntensity = 0.0f;
@@ -703,6 +557,8 @@ void Player::reset() {
 }
 
 void Player::checkBounds(int windowWidth, int windowHeight) {
+    (void)windowHeight;  // 上边界的限制已停用，见下方
+
     // 左右边界
     if (x < 0) {
         x = 0;
@@ -720,46 +576,9 @@ void Player::checkBounds(int windowWidth, int windowHeight) {
     }*/
 }
 
-void Player::applyDoubleJump() {
-    doubleJumpTimer = 10.0f;  // 10秒额外跳跃
-    hasDoubleJump = true;
-    maxJumps = 3;  // 增加到3段跳
-    addBonusScore(75);
-    incrementItemsCollected();
-}
-
-void Player::applySlowTime() {
-    slowTimeTimer = 8.0f;  // 8秒时间减缓
-    timeScaleFactor = 0.5f;  // 时间减缓到50%
-    addBonusScore(100);
-    incrementItemsCollected();
-}
-
-void Player::applyMagneticField() {
-    magneticFieldTimer = 15.0f;  // 15秒磁场效果
-    magnetRadius = 150.0f;  // 磁场半径
-    addBonusScore(80);
-    incrementItemsCollected();
-}
-
-void Player::applyHealthBoost() {
-    heal(2);  // 恢复2点生命
-    addBonusScore(60);
-    incrementItemsCollected();
-}
-
-void Player::applyFreezeObstacles() {
-    freezeObstaclesTimer = 10.0f;  // 10秒冻结障碍物
-    obstaclesFrozen = true;
-    addBonusScore(120);
-    incrementItemsCollected();
-}
-
 void Player::collectCoin(int value) {
     coins += value;
     addBonusScore(value);
-    // 添加收集特效
-    createSpeedBoostEffect(); // 重用特效
 }
 
 void Player::takeDamage(int damage) {
@@ -768,14 +587,9 @@ void Player::takeDamage(int damage) {
     health -= damage;
     if (health < 0) health = 0;
 
-    // 播放受伤音效
-    AudioManager::getInstance().playSound(SoundType::DAMAGE_SOUND, false);
-
     // 设置无敌时间
     invulnerabilityTimer = 1.0f;
-
-    // 添加受伤特效
-    addScreenShake(4.0f);
+    emit(EVENT_DAMAGED, damage);
 }
 
 // 添加死亡检查函数
@@ -786,7 +600,4 @@ bool Player::isDead() const {
 void Player::heal(int amount) {
     health += amount;
     if (health > maxHealth) health = maxHealth;
-
-    // 添加治疗特效
-    createShieldActivateEffect();
 }
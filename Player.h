@@ -1,6 +1,8 @@
 #pragma once
-#include <graphics.h>
-#include <windows.h>
+#include "Input.h"
+#include "PowerUp.h"
+#include "GameEvents.h"
+#include "Color.h"
 #include <vector>
 
 struct Particle {
@@ -15,34 +17,52 @@ struct Particle {
     }
 };
 
+// 粒子只是表现，不影响模拟：复制玩家（回滚快照的保存和恢复）时不复制粒子，双方各自保留原有的粒子。
+// 粒子的随机数与模拟的Random分开，跳过或关闭特效时模拟的随机序列不变
+struct ParticleList {
+    std::vector<Particle> items;
+    std::uint32_t randomState;
+
+    static const size_t RESERVED = 256;     // 同时存在的粒子通常在此之内，创建粒子时不扩容
+
+    ParticleList() : randomState(1) { items.reserve(RESERVED); }
+    ParticleList(const ParticleList&) : randomState(1) {}
+    ParticleList& operator=(const ParticleList&) { return *this; }
+
+    // 与Random::next相同的线性同余序列
+    int random() {
+        randomState = randomState * 214013u + 2531011u;
+        return (int)((randomState >> 16) & 0x7FFF);
+    }
+};
+
 class Player {
 private:
     float x, y;
+    float prevX, prevY;             // 本帧物理更新前的位置，连续碰撞检测从这里扫到当前位置
     float vx, vy;
     float width, height;
     bool onGround;
     bool wasOnGround;
     int jumpCount;
-    int maxJumps;
+    float jumpBufferTimer;          // 跳跃缓冲：按下后在此时间内一旦可以起跳就起跳
+    float coyoteTimer;              // 土狼时间：离开平台后仍可按地面起跳的剩余时间
 
     // 风格相关
     COLORREF currentColor;
     float pulseTimer;
 
-    // 道具效果
-    float speedBoostTimer;
-    float shieldTimer;
-    bool hasShieldActive;
+    // 道具效果：生效中的效果紧凑排列在前effectCount项，每种道具最多一项
+    ActiveEffect effects[ITEM_TYPE_COUNT];
+    int effectCount;
     bool shieldUsed; // 标记护盾是否已使用过
 
-    float doubleJumpTimer;          // 额外跳跃时间
-    float slowTimeTimer;            // 时间减缓时间
-    float magneticFieldTimer;       // 磁场效果时间
-    float freezeObstaclesTimer;     // 冻结障碍物时间
+    // 道具效果到期和连击超时登记在总时间的时间轮上（不受时间减缓影响），timerOwner为事件中的玩家序号
+    TimerWheel* timers;
+    int timerOwner;
 
-    // 无敌道具效果
-    float invincibilityTimer;      // 无敌时间
-    bool hasInvincibility;         // 是否有无敌效果
+    // 着陆、跳跃、拾取、受伤等事件追加到这里，音效和特效由游戏在帧末统一处理；未绑定时不记录
+    GameEventBuffer* events;
 
     // 玩家状态
     int health;                     // 生命值
@@ -50,15 +70,9 @@ private:
     float invulnerabilityTimer;     // 无敌时间
     int coins;                      // 金币数量
 
-    // 道具效果强度
-    float timeScaleFactor;          // 时间缩放因子
-    float magnetRadius;             // 磁场半径
-    bool hasDoubleJump;             // 是否有额外跳跃
-    bool obstaclesFrozen;           // 障碍物是否被冻结
-
     // 连击系统
     int comboCount;
-    float comboTimer;
+    TimerHandle comboTimer;
     float lastLandingTime;
     // Combo追踪变量
     float lastPlatformY;        // 上一个平台的Y坐标
@@ -66,7 +80,7 @@ private:
     float currentPlatformY;     // 当前平台的Y坐标
 
     // 粒子系统
-    std::vector<Particle> particles;
+    ParticleList particles;
 
     // 屏幕震动
     float shakeIntensity;
@@ -76,31 +90,47 @@ private:
     int bonusScore;    // 道具加分
     int itemsCollected; // 收集的道具数量
 
-    // 物理常量
+    int findEffectIndex(ItemType type) const;
+    void removeEffect(int index);
+    void emit(GameEventType type, int value = 0);
+
+public:
+    // 物理常量（平台生成器据此推导跳跃可达范围）
     static const float GRAVITY;
     static const float JUMP_SPEED;
     static const float MOVE_SPEED;
     static const float FRICTION;
     static const float MAX_FALL_SPEED;
+    static const float JUMP_BUFFER_TIME;
+    static const float COYOTE_TIME;
+    static const int BASE_MAX_JUMPS;
+    static const float COMBO_TIMEOUT;
 
-public:
     Player(float x = 100, float y = 100);
 
-    void update(float deltaTime);
+    // 绑定时间轮，之后的道具效果和连击计时都登记在上面
+    void bindTimers(TimerWheel* wheel, int owner) { timers = wheel; timerOwner = owner; }
+    // 绑定事件缓冲，事件中的玩家序号为bindTimers的owner
+    void bindEvents(GameEventBuffer* buffer) { events = buffer; }
+
+    void update(const GameClock& clock);
+    void onTimer(const TimerEvent& event);    // 本玩家的定时到期（道具效果、连击）
     void draw();
     void drawWithOffset(float offsetX, float offsetY);
-    void handleInput();
+    void applyInput(const InputFrame& input);
 
     // 位置和碰撞
     float getX() const { return x; }
     float getY() const { return y; }
+    float getPrevX() const { return prevX; }
+    float getPrevY() const { return prevY; }
     float getVX() const { return vx; }
     float getVY() const { return vy; }
     void setVY(float newVY) { vy = newVY; }
     float getWidth() const { return width; }
     float getHeight() const { return height; }
 
-    void setPosition(float newX, float newY) { x = newX; y = newY; }
+    void setPosition(float newX, float newY) { x = prevX = newX; y = prevY = newY; }     // 瞬移，不产生扫掠
     void setOnGround(bool grounded);
     bool isOnGround() const { return onGround; }
 
@@ -108,37 +138,38 @@ public:
     void getShakeOffset(float& shakeX, float& shakeY) const;
 
     // 移动和跳跃
+    bool canJump() const { return onGround || coyoteTimer > 0 || jumpCount < getMaxJumps(); }
     void jump();
     void moveLeft();
     void moveRight();
 
-    // 道具效果
-    void applySpeedBoost();
-    void applyShield();
+    // 道具效果：按PowerUp.cpp中的数据表生效
+    void applyItem(ItemType type, int value);
     void consumeShield();
-    bool canTakeDamage() const { return !hasShieldActive && !isDead() && !hasInvincibilityActive(); }
-    void applyDoubleJump();
-    void applySlowTime();
-    void applyMagneticField();
-    void applyHealthBoost();
-    void applyFreezeObstacles();
+    bool canTakeDamage() const { return !hasShield() && !isDead() && !hasInvincibilityActive(); }
     void collectCoin(int value);
-    void applyInvincibility();
-    bool hasInvincibilityActive() const { return invincibilityTimer > 0; }
+    const ActiveEffect* findEffect(ItemType type) const;
+    bool hasEffect(ItemType type) const { return findEffect(type) != nullptr; }
+    float getEffectStrength(ItemType type, float inactiveValue) const;
+    float getEffectTimeLeft(ItemType type) const;
+    int getActiveEffectCount() const { return effectCount; }
+    const ActiveEffect& getActiveEffect(int index) const { return effects[index]; }
 
     // 状态检查方法
-    bool hasDoubleJumpActive() const { return doubleJumpTimer > 0; }
-    bool hasSlowTimeActive() const { return slowTimeTimer > 0; }
-    bool hasMagneticFieldActive() const { return magneticFieldTimer > 0; }
-    bool hasObstaclesFrozen() const { return obstaclesFrozen; }
+    bool hasInvincibilityActive() const { return hasEffect(INVINCIBILITY); }
+    bool hasDoubleJumpActive() const { return hasEffect(DOUBLE_JUMP); }
+    bool hasSlowTimeActive() const { return hasEffect(SLOW_TIME); }
+    bool hasMagneticFieldActive() const { return hasEffect(MAGNETIC_FIELD); }
+    bool hasObstaclesFrozen() const { return hasEffect(FREEZE_OBSTACLES); }
     bool isInvulnerable() const { return invulnerabilityTimer > 0; }
 
     // 访问器
     int getHealth() const { return health; }
     int getMaxHealth() const { return maxHealth; }
     int getCoins() const { return coins; }
-    float getTimeScaleFactor() const { return timeScaleFactor; }
-    float getMagnetRadius() const { return magnetRadius; }
+    float getTimeScaleFactor() const { return getEffectStrength(SLOW_TIME, 1.0f); }
+    float getMagnetRadius() const { return getEffectStrength(MAGNETIC_FIELD, 0.0f); }
+    float getSpeedMultiplier() const { return getEffectStrength(SPEED_BOOST, 1.0f); }
 
     // 伤害系统
     void takeDamage(int damage);
@@ -168,8 +199,10 @@ public:
     void createComboEffect();               
     void createInvincibilityEffect();       
     void createRespawnEffect() { createShieldActivateEffect(); }
+    void updateSpeedTrail();                // 加速中移动时留下拖尾，表现层每帧调用
     void updateParticles(float deltaTime);
     void drawParticles(float offsetX, float offsetY);
+    size_t getParticleCount() const { return particles.items.size(); }
 
     // 屏幕震动
     void addScreenShake(float intensity);
@@ -182,8 +215,10 @@ public:
     void checkBounds(int windowWidth, int windowHeight);
 
     // 道具状态查询
-    bool hasSpeedBoost() const { return speedBoostTimer > 0; }
-    bool hasShield() const { return hasShieldActive; }
-    float getSpeedBoostTimeLeft() const { return speedBoostTimer; }
-    float getShieldTimeLeft() const { return shieldTimer; }
+    bool hasSpeedBoost() const { return hasEffect(SPEED_BOOST); }
+    int getMaxJumps() const { return BASE_MAX_JUMPS + (int)getEffectStrength(DOUBLE_JUMP, 0.0f); }
+    int getJumpCount() const { return jumpCount; }
+    bool hasShield() const { return hasEffect(SHIELD); }
+    float getSpeedBoostTimeLeft() const { return getEffectTimeLeft(SPEED_BOOST); }
+    float getShieldTimeLeft() const { return getEffectTimeLeft(SHIELD); }
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "Player.h"
+#include "DrawUtils.h"
+#include <cmath>
+#include <algorithm>
+
+void Player::drawParticles(float offsetX, float offsetY) {
+    for (const auto& particle : particles.items) {
+        float alpha = particle.life / particle.maxLife;
+        if (alpha > 0) {
+            // 使用DrawUtils.cpp中的drawParticle函数
+            DrawUtils::drawParticle(particle.x + offsetX, particle.y + offsetY,
+                3.0f * alpha, particle.color, alpha);
+
+            // 为特殊粒子添加光晕效果
+            if (particle.color == Theme::ITEM_SPEED_PARTICLE ||
+                particle.color == Theme::ITEM_SHIELD_PARTICLE) {
+                DrawUtils::drawSparkle(particle.x + offsetX, particle.y + offsetY,
+                    6.0f * alpha, particle.color, pulseTimer);
+            }
+        }
+    }
+}
+
+void Player::draw() {
+    drawWithOffset(0, 0);
+}
+
+void Player::drawWithOffset(float offsetX, float offsetY) {
+    float drawX = x + offsetX;
+    float drawY = y + offsetY;
+
+    // 道具效果增强
+    if (hasSpeedBoost()) {
+        // 使用DrawUtils.cpp中的drawSpeedEffect
+        DrawUtils::drawSpeedEffect(drawX, drawY, width, height,
+            AnimationUtils::pulse(pulseTimer, 4.0f));
+
+        // 速度轨迹效果
+        for (int i = 1; i <= 3; i++) {
+            float trailAlpha = 0.3f / i;
+            float trailX = drawX - vx * 0.01f * i;
+            float trailY = drawY - vy * 0.01f * i;
+
+            COLORREF trailColor = DrawUtils::blendColor(Theme::PLAYER_SPEED_EFFECT,
+                RGB(255, 255, 255), trailAlpha);
+            setfillcolor(trailColor);
+            solidrectangle((int)trailX, (int)trailY,
+                (int)(trailX + width), (int)(trailY + height));
+        }
+    }
+
+    if (hasShield()) {
+        // 使用DrawUtils.cpp中的drawShieldEffect
+        DrawUtils::drawShieldEffect(drawX + width / 2, drawY + height / 2,
+            25, AnimationUtils::pulse(pulseTimer, 3.0f));
+
+        // 额外的护盾光环
+        float shieldPulse = AnimationUtils::pulse(pulseTimer, 2.0f);
+        DrawUtils::drawGlowCircle((int)(drawX + width / 2), (int)(drawY + height / 2),
+            (int)(20 + 5 * shieldPulse), Theme::SHIELD_GLOW, 0.4f);
+    }
+
+    // 无敌效果绘制
+    if (hasInvincibilityActive()) {
+        // 绘制无敌光环
+        float invincibilityPulse = AnimationUtils::pulse(pulseTimer, 4.0f);
+        COLORREF invincibilityColor = RGB(255, 215, 0);  // 金色
+
+        // 绘制多层无敌光环
+        for (int i = 0; i < 3; i++) {
+            float radius = 35 + i * 10 + invincibilityPulse * 5;
+            float alpha = 0.3f - i * 0.1f;
+            DrawUtils::drawGlowCircle((int)(drawX + width / 2), (int)(drawY + height / 2),
+                (int)radius, invincibilityColor, alpha);
+        }
+
+        // 绘制星星特效
+        for (int i = 0; i < 8; i++) {
+            float angle = (float)i / 8.0f * 6.28f + pulseTimer * 2.0f;
+            float starRadius = 40 + sin(pulseTimer * 3.0f + i) * 10;
+            float starX = drawX + width / 2 + cos(angle) * starRadius;
+            float starY = drawY + height / 2 + sin(angle) * starRadius;
+            DrawUtils::drawSparkle(starX, starY, 6.0f, invincibilityColor, pulseTimer + i);
+        }
+    }
+
+    // 绘制玩家光晕（根据状态）
+    COLORREF glowColor = Theme::PLAYER_MAIN;
+    float glowIntensity = 0.3f;
+
+    if (hasSpeedBoost()) {
+        glowColor = Theme::SPEED_GLOW;
+        glowIntensity = 0.6f;
+    }
+    if (hasShield()) {
+        glowColor = Theme::SHIELD_GLOW;
+        glowIntensity = 0.5f;
+    }
+    // 无敌状态光晕
+    if (hasInvincibilityActive()) {
+        glowColor = RGB(255, 215, 0);  // 金色光晕
+        glowIntensity = 0.8f;
+    }
+
+    // 连击光晕
+    if (comboCount > 5) {
+        glowColor = DrawUtils::getComboColor(comboCount);
+        glowIntensity = 0.4f + 0.3f * AnimationUtils::pulse(pulseTimer, 5.0f);
+    }
+
+    DrawUtils::drawGlowRect((int)drawX, (int)drawY, (int)width, (int)height,
+        glowColor, glowIntensity);
+
+    // 绘制阴影
+    setfillcolor(RGB(50, 50, 50));
+    solidrectangle((int)(drawX + 2), (int)(drawY + 2),
+        (int)(drawX + width + 2), (int)(drawY + height + 2));
+
+    // 绘制玩家主体（使用颜色动画）
+    COLORREF playerColor = Theme::PLAYER_MAIN;
+
+    if (hasSpeedBoost()) {
+        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
+            Theme::PLAYER_SPEED_EFFECT, pulseTimer, 4.0f);
+    }
+    if (hasShield()) {
+        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
+            Theme::PLAYER_SHIELD_EFFECT, pulseTimer, 3.0f);
+    }
+    // 无敌状态颜色
+    if (hasInvincibilityActive()) {
+        playerColor = AnimationUtils::colorPulse(Theme::PLAYER_MAIN,
+            RGB(255, 215, 0), pulseTimer, 5.0f);
+    }
+
+    setfillcolor(playerColor);
+    solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+    // 绘制高光
+    setfillcolor(RGB(255, 255, 255));
+    solidrectangle((int)(drawX + 2), (int)(drawY + 2),
+        (int)(drawX + width - 2), (int)(drawY + 8));
+
+    // 绘制边框
+    setlinecolor(RGB(255, 255, 255));
+    setlinestyle(PS_SOLID, 2);
+    rectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+    // 绘制粒子效果
+    drawParticles(offsetX, offsetY);
+}
@@ -0,0 +1,32 @@
+#include "PowerUp.h"
+#include "Theme.h"
+
+// 按ItemType顺序排列
+static const PowerUpDef POWER_UPS[ITEM_TYPE_COUNT] = {
+    // 类型              持续   强度     叠加           一次性效果     加分  计数   音效
+    { NONE,             0.0f,  0.0f,   STACK_REFRESH, INSTANT_NONE, 0,    false, false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, nullptr, 0 },
+    { SPEED_BOOST,      5.0f,  1.5f,   STACK_REFRESH, INSTANT_NONE, 50,   true,  true,  SoundType::ITEM_COLLECT,
+        VISUAL_SPEED, L"Speed Boost Active", Theme::ITEM_SPEED },
+    { SHIELD,           10.0f, 1.0f,   STACK_REFRESH, INSTANT_NONE, 100,  true,  true,  SoundType::SHIELD_ACTIVATE,
+        VISUAL_SHIELD, L"Shield Active", Theme::ITEM_SHIELD },
+    { DOUBLE_JUMP,      10.0f, 1.0f,   STACK_REFRESH, INSTANT_NONE, 75,   true,  false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, L"Double Jump Active", RGB(100, 255, 100) },
+    { SLOW_TIME,        8.0f,  0.5f,   STACK_REFRESH, INSTANT_NONE, 100,  true,  false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, L"Slow Time Active", RGB(100, 100, 255) },
+    { MAGNETIC_FIELD,   15.0f, 150.0f, STACK_REFRESH, INSTANT_NONE, 80,   true,  false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, L"Magnetic Field Active", RGB(255, 100, 255) },
+    { HEALTH_BOOST,     0.0f,  2.0f,   STACK_REFRESH, INSTANT_HEAL, 60,   true,  false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, nullptr, 0 },
+    { FREEZE_OBSTACLES, 10.0f, 1.0f,   STACK_REFRESH, INSTANT_NONE, 120,  true,  false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, L"Obstacles Frozen", RGB(100, 255, 255) },
+    // 金币的加分等于其价值，由Player::collectCoin处理
+    { COIN,             0.0f,  0.0f,   STACK_REFRESH, INSTANT_COIN, 0,    false, false, SoundType::ITEM_COLLECT,
+        VISUAL_NONE, nullptr, 0 },
+    { INVINCIBILITY,    8.0f,  1.0f,   STACK_REFRESH, INSTANT_NONE, 150,  true,  true,  SoundType::INVINCIBILITY,
+        VISUAL_INVINCIBILITY, L"Invincibility Active", RGB(255, 215, 0) }
+};
+
+const PowerUpDef& getPowerUpDef(ItemType type) {
+    return POWER_UPS[type >= 0 && type < ITEM_TYPE_COUNT ? type : NONE];
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Platform.h"
+#include "Color.h"
+#include "AudioManager.h"
+#include "GameClock.h"
+
+// 道具效果由数据表描述：新增道具只需在PowerUp.cpp的表中加一行，不需要给Player加字段
+
+const int ITEM_TYPE_COUNT = INVINCIBILITY + 1;
+
+// 再次拾取同类道具、效果仍在生效时的叠加规则
+enum EffectStacking {
+    STACK_REFRESH,      // 重置为完整持续时间
+    STACK_EXTEND        // 在剩余时间上累加
+};
+
+// 拾取时的一次性效果
+enum EffectInstant {
+    INSTANT_NONE,
+    INSTANT_HEAL,       // 按强度恢复生命
+    INSTANT_COIN        // 按道具价值加金币
+};
+
+// 拾取时的粒子特效
+enum EffectVisual {
+    VISUAL_NONE,
+    VISUAL_SPEED,
+    VISUAL_SHIELD,
+    VISUAL_INVINCIBILITY
+};
+
+struct PowerUpDef {
+    ItemType type;
+    float duration;             // 持续时间（秒），0表示只有一次性效果
+    float strength;             // 效果强度：加速倍数、额外跳跃次数、时间缩放、磁场半径、治疗量等
+    EffectStacking stacking;
+    EffectInstant instant;
+    int bonusScore;             // 拾取加分
+    bool countsAsItem;          // 是否计入收集的道具数量
+    bool hasSound;
+    SoundType sound;
+    EffectVisual visual;
+    const wchar_t* hudLabel;    // 生效期间HUD上显示的文字
+    COLORREF hudColor;
+};
+
+// 生效中的效果：玩家身上只保存这样一个紧凑数组，可以随快照直接复制；到期由时间轮触发
+struct ActiveEffect {
+    ItemType type;
+    float strength;
+    TimerHandle expiry;
+};
+
+const PowerUpDef& getPowerUpDef(ItemType type);
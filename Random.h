@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+// 模拟使用的随机数：与MSVC CRT的rand()相同的线性同余序列，同一种子下生成的世界与以前一致
+// 状态按线程独立（与CRT相同），并且可以读出和恢复，联机回滚时随快照一起保存
+namespace Random {
+    const int MAX = 0x7FFF;
+
+    inline std::uint32_t& state() {
+        static thread_local std::uint32_t value = 1;
+        return value;
+    }
+
+    inline void seed(unsigned int value) { state() = value; }
+
+    inline int next() {
+        std::uint32_t& value = state();
+        value = value * 214013u + 2531011u;
+        return (int)((value >> 16) & MAX);
+    }
+
+    inline std::uint32_t getState() { return state(); }
+    inline void setState(std::uint32_t value) { state() = value; }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 单线程的环形队列：两端都可以出队，容量为2的幂，只在满时扩容一倍，出入队不访问堆。
+// 复制时目标容量足够则直接覆盖（快照保存与恢复不再分配）
+template <typename T>
+class RingQueue {
+private:
+    std::vector<T> items;
+    size_t head;
+    size_t count;
+
+    void grow() {
+        std::vector<T> larger(items.size() * 2);
+        for (size_t i = 0; i < count; i++) {
+            larger[i] = std::move(items[(head + i) & (items.size() - 1)]);
+        }
+        items.swap(larger);
+        head = 0;
+    }
+
+public:
+    // capacity向上取整到2的幂
+    explicit RingQueue(size_t capacity = 16) : head(0), count(0) {
+        size_t size = 1;
+        while (size < capacity) size *= 2;
+        items.resize(size);
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    const T& front() const { return items[head]; }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    void pushBack(T&& value) {
+        if (count == items.size()) grow();
+        items[(head + count) & (items.size() - 1)] = std::move(value);
+        count++;
+    }
+
+    void pushBack(const T& value) {
+        T copy(value);
+        pushBack(std::move(copy));
+    }
+
+    void popFront(T& value) {
+        value = std::move(items[head]);
+        head = (head + 1) & (items.size() - 1);
+        count--;
+    }
+
+    void popBack(T& value) {
+        count--;
+        value = std::move(items[(head + count) & (items.size() - 1)]);
+    }
+};
@@ -0,0 +1,374 @@
+#include "ScoreStore.h"
+#include "BinaryIO.h"
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+    // 日志记录：[负载长度][负载CRC32][负载]，负载第一个字节是记录类型
+    enum RecordType {
+        RECORD_HEADER = 0,      // 日志第一条：代数
+        RECORD_RUN = 1,         // 一局成绩
+        RECORD_TOTALS = 2,      // 压缩时写入的累计统计
+        RECORD_KEPT_RUN = 3     // 压缩时保留的对局，已计入累计统计
+    };
+
+    const std::uint32_t INDEX_MAGIC = 0x4943534A;      // "JSCI"
+    const std::uint32_t INDEX_VERSION = 1;
+    const std::uint32_t MAX_RECORD_BYTES = 4096;
+
+    // 分数高者在前；同分时高度高者在前，再按先达成者在前
+    bool isBetter(const ScoreEntry& a, const ScoreEntry& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.maxHeight != b.maxHeight) return a.maxHeight > b.maxHeight;
+        return a.timestamp < b.timestamp;
+    }
+
+    bool isSameRun(const ScoreEntry& a, const ScoreEntry& b) {
+        return a.timestamp == b.timestamp && a.player == b.player && a.score == b.score && a.maxHeight == b.maxHeight;
+    }
+
+    void putEntry(std::vector<std::uint8_t>& out, const ScoreEntry& entry) {
+        BinaryIO::putU64(out, (std::uint64_t)entry.timestamp);
+        BinaryIO::putFixedString(out, entry.player, ScoreEntry::NAME_LENGTH);
+        BinaryIO::putU64(out, (std::uint64_t)entry.score);
+        BinaryIO::putU64(out, (std::uint64_t)entry.maxHeight);
+        BinaryIO::putU32(out, (std::uint32_t)entry.coins);
+        BinaryIO::putU32(out, (std::uint32_t)entry.itemsCollected);
+        BinaryIO::putU32(out, (std::uint32_t)entry.maxCombo);
+        BinaryIO::putF32(out, entry.survivalTime);
+        BinaryIO::putU8(out, entry.deathCause);
+    }
+
+    ScoreEntry readEntry(BinaryIO::Reader& reader) {
+        ScoreEntry entry;
+        entry.timestamp = (std::int64_t)reader.u64();
+        entry.player = reader.fixedString(ScoreEntry::NAME_LENGTH);
+        entry.score = (std::int64_t)reader.u64();
+        entry.maxHeight = (std::int64_t)reader.u64();
+        entry.coins = (std::int32_t)reader.u32();
+        entry.itemsCollected = (std::int32_t)reader.u32();
+        entry.maxCombo = (std::int32_t)reader.u32();
+        entry.survivalTime = reader.f32();
+        entry.deathCause = reader.u8();
+        return entry;
+    }
+
+    void putTotals(std::vector<std::uint8_t>& out, const ScoreTotals& totals) {
+        BinaryIO::putU64(out, totals.runs);
+        BinaryIO::putU64(out, totals.coins);
+        BinaryIO::putU64(out, totals.itemsCollected);
+        BinaryIO::putU64(out, (std::uint64_t)(totals.playSeconds * 1000.0));
+    }
+
+    ScoreTotals readTotals(BinaryIO::Reader& reader) {
+        ScoreTotals totals;
+        totals.runs = reader.u64();
+        totals.coins = reader.u64();
+        totals.itemsCollected = reader.u64();
+        totals.playSeconds = reader.u64() / 1000.0;
+        return totals;
+    }
+
+    void countRun(ScoreTotals& totals, const ScoreEntry& entry) {
+        totals.runs++;
+        totals.coins += std::max(0, entry.coins);
+        totals.itemsCollected += std::max(0, entry.itemsCollected);
+        totals.playSeconds += entry.survivalTime;
+    }
+
+    void appendRecord(std::vector<std::uint8_t>& out, const std::vector<std::uint8_t>& payload) {
+        BinaryIO::putU32(out, (std::uint32_t)payload.size());
+        BinaryIO::putU32(out, BinaryIO::crc32(payload.data(), payload.size()));
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    std::uint64_t fileSize(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return file.is_open() ? (std::uint64_t)file.tellg() : 0;
+    }
+
+    // 先完整写入临时文件，再整体替换目标文件
+    bool writeFileAtomically(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) return false;
+            file.write((const char*)bytes.data(), bytes.size());
+            file.flush();
+            if (!file.good()) return false;
+        }
+#ifdef _WIN32
+        return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        // POSIX的rename在同一文件系统内本身就是原子替换
+        return std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    }
+
+    // 读取日志第一条记录中的代数，失败时返回0
+    std::uint32_t readLogGeneration(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::uint8_t prefix[8];
+        if (!file.read((char*)prefix, sizeof(prefix))) return 0;
+
+        std::uint32_t size = BinaryIO::getU32(prefix);
+        if (size == 0 || size > MAX_RECORD_BYTES) return 0;
+        std::vector<std::uint8_t> payload(size);
+        if (!file.read((char*)payload.data(), size)) return 0;
+        if (BinaryIO::crc32(payload.data(), size) != BinaryIO::getU32(prefix + 4)) return 0;
+
+        BinaryIO::Reader reader(payload.data(), payload.size());
+        if (reader.u8() != RECORD_HEADER) return 0;
+        std::uint32_t generation = reader.u32();
+        return reader.good() ? generation : 0;
+    }
+}
+
+ScoreStore::ScoreStore() : opened(false), generation(0), logBytes(0), runsSinceCompaction(0) {
+}
+
+void ScoreStore::resetState() {
+    topScores.clear();
+    playerBests.clear();
+    totals = ScoreTotals();
+    generation = 0;
+    logBytes = 0;
+    runsSinceCompaction = 0;
+}
+
+bool ScoreStore::open(const std::string& basePath) {
+    logPath = basePath + ".log";
+    indexPath = basePath + ".idx";
+    resetState();
+
+    std::uint64_t logSize = fileSize(logPath);
+    if (logSize == 0) {
+        // 新建：写入只有文件头的空日志
+        opened = compact();
+        return opened;
+    }
+
+    bool complete;
+    std::uint64_t indexedBytes = 0;
+    if (readIndex() && logSize >= logBytes && readLogGeneration(logPath) == generation) {
+        // 正常情况下索引已覆盖整个日志，这里读不到记录；只有上次写索引前崩溃才会补读末尾几条
+        indexedBytes = logBytes;
+        complete = scanLog(logBytes);
+    }
+    else {
+        resetState();
+        complete = scanLog(0);
+    }
+
+    if (!complete || generation == 0) {
+        // 日志末尾有写到一半的记录：重写日志，丢掉残缺部分
+        opened = compact();
+    }
+    else {
+        opened = logBytes == indexedBytes || writeIndex();
+    }
+    return opened;
+}
+
+int ScoreStore::apply(const ScoreEntry& entry) {
+    // 各玩家最佳
+    bool found = false;
+    for (auto& best : playerBests) {
+        if (best.player == entry.player) {
+            if (isBetter(entry, best)) best = entry;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        playerBests.push_back(entry);
+    }
+
+    // 排行榜
+    auto position = std::upper_bound(topScores.begin(), topScores.end(), entry, isBetter);
+    size_t rank = position - topScores.begin();
+    if (rank >= TOP_COUNT) return 0;
+
+    topScores.insert(position, entry);
+    if (topScores.size() > TOP_COUNT) {
+        topScores.pop_back();
+    }
+    return (int)rank + 1;
+}
+
+int ScoreStore::submit(const ScoreEntry& entry) {
+    if (!opened) return 0;
+
+    std::vector<std::uint8_t> payload;
+    BinaryIO::putU8(payload, RECORD_RUN);
+    putEntry(payload, entry);
+    std::vector<std::uint8_t> record;
+    appendRecord(record, payload);
+
+    // 先追加日志，再更新索引：两步之间崩溃时，下次启动从索引记录的位置扫描补上
+    {
+        std::ofstream log(logPath, std::ios::binary | std::ios::app);
+        log.write((const char*)record.data(), record.size());
+        log.flush();
+        if (!log.good()) return 0;
+    }
+
+    countRun(totals, entry);
+    int rank = apply(entry);
+
+    logBytes += record.size();
+    runsSinceCompaction++;
+    if (runsSinceCompaction >= COMPACT_THRESHOLD) {
+        compact();
+    }
+    else {
+        writeIndex();
+    }
+    return rank;
+}
+
+const ScoreEntry* ScoreStore::getPlayerBest(const std::string& player) const {
+    for (const auto& best : playerBests) {
+        if (best.player == player) return &best;
+    }
+    return nullptr;
+}
+
+bool ScoreStore::scanLog(std::uint64_t offset) {
+    std::ifstream log(logPath, std::ios::binary);
+    if (!log.is_open()) return false;
+    log.seekg((std::streamoff)offset);
+
+    std::vector<std::uint8_t> payload;
+    std::uint8_t prefix[8];
+    while (log.read((char*)prefix, sizeof(prefix))) {
+        std::uint32_t size = BinaryIO::getU32(prefix);
+        if (size == 0 || size > MAX_RECORD_BYTES) return false;
+
+        payload.resize(size);
+        if (!log.read((char*)payload.data(), size)) return false;
+        if (BinaryIO::crc32(payload.data(), size) != BinaryIO::getU32(prefix + 4)) return false;
+
+        BinaryIO::Reader reader(payload.data(), payload.size());
+        switch (reader.u8()) {
+        case RECORD_HEADER:
+            generation = reader.u32();
+            break;
+        case RECORD_TOTALS:
+            totals = readTotals(reader);
+            break;
+        case RECORD_RUN: {
+            ScoreEntry entry = readEntry(reader);
+            if (!reader.good()) return false;
+            countRun(totals, entry);
+            apply(entry);
+            runsSinceCompaction++;
+            break;
+        }
+        case RECORD_KEPT_RUN:
+            apply(readEntry(reader));
+            break;
+        default:
+            return false;
+        }
+        if (!reader.good()) return false;
+
+        logBytes = offset += sizeof(prefix) + size;
+    }
+
+    // 正好读到文件末尾才算完整
+    return log.eof() && log.gcount() == 0;
+}
+
+bool ScoreStore::compact() {
+    generation++;
+
+    std::vector<std::uint8_t> bytes;
+    std::vector<std::uint8_t> payload;
+
+    BinaryIO::putU8(payload, RECORD_HEADER);
+    BinaryIO::putU32(payload, generation);
+    appendRecord(bytes, payload);
+
+    payload.clear();
+    BinaryIO::putU8(payload, RECORD_TOTALS);
+    putTotals(payload, totals);
+    appendRecord(bytes, payload);
+
+    // 排行榜和各玩家最佳可能是同一局，只写一次
+    std::vector<const ScoreEntry*> kept;
+    for (const auto& entry : topScores) kept.push_back(&entry);
+    for (const auto& best : playerBests) {
+        bool duplicate = false;
+        for (const ScoreEntry* entry : kept) {
+            if (isSameRun(*entry, best)) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) kept.push_back(&best);
+    }
+    for (const ScoreEntry* entry : kept) {
+        payload.clear();
+        BinaryIO::putU8(payload, RECORD_KEPT_RUN);
+        putEntry(payload, *entry);
+        appendRecord(bytes, payload);
+    }
+
+    if (!writeFileAtomically(logPath, bytes)) return false;
+
+    logBytes = bytes.size();
+    runsSinceCompaction = 0;
+    return writeIndex();
+}
+
+bool ScoreStore::writeIndex() const {
+    std::vector<std::uint8_t> bytes;
+    BinaryIO::putU32(bytes, INDEX_MAGIC);
+    BinaryIO::putU32(bytes, INDEX_VERSION);
+    BinaryIO::putU32(bytes, generation);
+    BinaryIO::putU64(bytes, logBytes);
+    BinaryIO::putU32(bytes, runsSinceCompaction);
+    putTotals(bytes, totals);
+
+    BinaryIO::putU32(bytes, (std::uint32_t)topScores.size());
+    for (const auto& entry : topScores) putEntry(bytes, entry);
+    BinaryIO::putU32(bytes, (std::uint32_t)playerBests.size());
+    for (const auto& best : playerBests) putEntry(bytes, best);
+
+    BinaryIO::putU32(bytes, BinaryIO::crc32(bytes.data(), bytes.size()));
+    return writeFileAtomically(indexPath, bytes);
+}
+
+bool ScoreStore::readIndex() {
+    std::ifstream file(indexPath, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 4) return false;
+
+    size_t bodySize = bytes.size() - 4;
+    if (BinaryIO::crc32(bytes.data(), bodySize) != BinaryIO::getU32(bytes.data() + bodySize)) return false;
+
+    BinaryIO::Reader reader(bytes.data(), bodySize);
+    if (reader.u32() != INDEX_MAGIC || reader.u32() != INDEX_VERSION) return false;
+    generation = reader.u32();
+    logBytes = reader.u64();
+    runsSinceCompaction = reader.u32();
+    totals = readTotals(reader);
+
+    std::uint32_t topCount = reader.u32();
+    for (std::uint32_t i = 0; i < topCount && reader.good(); i++) {
+        topScores.push_back(readEntry(reader));
+    }
+    std::uint32_t bestCount = reader.u32();
+    for (std::uint32_t i = 0; i < bestCount && reader.good(); i++) {
+        playerBests.push_back(readEntry(reader));
+    }
+    return reader.good() && topScores.size() <= TOP_COUNT;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 一局的成绩摘要
+struct ScoreEntry {
+    static const size_t NAME_LENGTH = 16;
+
+    std::int64_t timestamp;     // 结束时间（Unix秒）
+    std::string player;         // 玩家名，最多NAME_LENGTH字节
+    std::int64_t score;
+    std::int64_t maxHeight;
+    std::int32_t coins;
+    std::int32_t itemsCollected;
+    std::int32_t maxCombo;
+    float survivalTime;
+    std::uint8_t deathCause;
+
+    ScoreEntry()
+        : timestamp(0), score(0), maxHeight(0), coins(0), itemsCollected(0), maxCombo(0),
+        survivalTime(0), deathCause(0) {
+    }
+};
+
+// 累计统计：压缩日志时被丢弃的对局仍计入这里
+struct ScoreTotals {
+    std::uint64_t runs;
+    std::uint64_t coins;
+    std::uint64_t itemsCollected;
+    double playSeconds;
+
+    ScoreTotals() : runs(0), coins(0), itemsCollected(0), playSeconds(0) {}
+};
+
+// 成绩存储：
+// - <base>.log 只追加的记录日志，每条记录带长度和CRC32，写到一半的记录在加载时被识别并丢弃
+// - <base>.idx 排行榜、各玩家最佳和累计统计的快照，记录它覆盖到的日志长度
+// 启动时只读索引（O(排行榜长度)），只有索引之后追加的记录（上次写索引前崩溃）才需要扫描；
+// 索引缺失或与日志不符时才完整扫描日志重建
+// 日志积累COMPACT_THRESHOLD条对局后压缩：只保留排行榜和各玩家最佳，其余对局并入累计统计
+// 索引和压缩后的日志都先写临时文件再替换，任意时刻崩溃都不会留下半个文件
+class ScoreStore {
+public:
+    static const size_t TOP_COUNT = 10;
+    static const std::uint32_t COMPACT_THRESHOLD = 200;
+
+private:
+    std::string logPath;
+    std::string indexPath;
+    bool opened;
+
+    std::vector<ScoreEntry> topScores;      // 按分数从高到低
+    std::vector<ScoreEntry> playerBests;    // 每个玩家一条
+    ScoreTotals totals;
+
+    std::uint32_t generation;               // 日志每压缩一次加一，用于判断索引是否对应当前日志
+    std::uint64_t logBytes;                 // 已计入内存状态的日志长度
+    std::uint32_t runsSinceCompaction;
+
+    int apply(const ScoreEntry& entry);     // 更新内存状态，返回排行榜名次（1起，未上榜为0）
+    bool readIndex();
+    bool writeIndex() const;
+    bool scanLog(std::uint64_t offset);     // 从offset起读入日志记录，返回日志末尾是否完整
+    bool compact();
+    void resetState();
+
+public:
+    ScoreStore();
+
+    // basePath不含扩展名，例如"scores"
+    bool open(const std::string& basePath);
+    bool isOpen() const { return opened; }
+
+    // 记录一局，返回排行榜名次（1起，未上榜为0）
+    int submit(const ScoreEntry& entry);
+
+    const std::vector<ScoreEntry>& getTopScores() const { return topScores; }
+    const ScoreEntry* getPlayerBest(const std::string& player) const;
+    const ScoreTotals& getTotals() const { return totals; }
+};
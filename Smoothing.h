@@ -0,0 +1,57 @@
+#pragma once
+#include <cmath>
+
+// 与帧率无关的平滑：按步长求解析解而不是每帧按固定比例混合，
+// 目标不变时无论一秒分成多少步，经过同样的时间得到同样的值
+namespace Smoothing {
+    // 一阶指数趋近的混合系数：每秒剩余差距衰减为e^-rate
+    inline float blendFactor(float rate, float deltaTime) {
+        return 1.0f - std::exp(-rate * deltaTime);
+    }
+
+    // 临界阻尼跟随：value以最快且不越过目标的方式趋近target，velocity为当前的变化率。
+    // omega越大跟得越紧，静止起步约6.6/omega秒后剩余差距不到1%。目标在一步内不变时是精确解
+    inline void criticalDamp(float& value, float& velocity, float target, float omega, float deltaTime) {
+        float offset = value - target;
+        float slope = velocity + omega * offset;
+        float decay = std::exp(-omega * deltaTime);
+        value = target + (offset + slope * deltaTime) * decay;
+        velocity = (velocity - omega * slope * deltaTime) * decay;
+    }
+}
+
+// 最近N个样本的滑动平均：环形缓冲，加入和取平均都是O(1)。
+// 累计和用double，长时间加减不会漂移到影响结果
+template <int N>
+class RunningAverage {
+private:
+    float samples[N];
+    int count;
+    int next;               // 下一个写入位置，满了之后即最早的样本
+    double sum;
+
+public:
+    RunningAverage() : count(0), next(0), sum(0.0) {}
+
+    void clear() {
+        count = 0;
+        next = 0;
+        sum = 0.0;
+    }
+
+    void add(float sample) {
+        if (count == N) {
+            sum -= samples[next];
+        }
+        else {
+            count++;
+        }
+        samples[next] = sample;
+        sum += sample;
+        next = (next + 1) % N;
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    float average() const { return count > 0 ? (float)(sum / count) : 0.0f; }
+};
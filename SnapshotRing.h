@@ -0,0 +1,55 @@
+#pragma once
+#include "Game.h"
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+// 最近若干帧的快照环形缓冲（联机回滚、存档点）：第tick帧的快照存放在tick % capacity处，
+// 每次保存以上一次保存的快照为基准，内容未变的组件池在相邻快照之间共享
+class SnapshotRing {
+private:
+    static const std::uint32_t EMPTY = 0xFFFFFFFFu;
+
+    int capacity;
+    std::unique_ptr<GameSnapshot[]> snapshots;
+    std::vector<std::uint32_t> ticks;       // 各位置保存的帧号，EMPTY表示没有
+    int lastSaved;
+
+public:
+    explicit SnapshotRing(int capacity)
+        : capacity(capacity), snapshots(new GameSnapshot[capacity]), ticks(capacity, (std::uint32_t)EMPTY), lastSaved(-1) {
+    }
+
+    SnapshotRing(const SnapshotRing&) = delete;
+    SnapshotRing& operator=(const SnapshotRing&) = delete;
+
+    int getCapacity() const { return capacity; }
+
+    void save(Game& game, std::uint32_t tick) {
+        int slot = (int)(tick % (std::uint32_t)capacity);
+        const GameSnapshot* base = lastSaved >= 0 && lastSaved != slot ? &snapshots[lastSaved] : nullptr;
+        game.saveSnapshot(snapshots[slot], base);
+        ticks[slot] = tick;
+        lastSaved = slot;
+    }
+
+    // 没有这一帧的快照（从未保存或已被覆盖）时返回false
+    bool load(Game& game, std::uint32_t tick) const {
+        const GameSnapshot* snapshot = find(tick);
+        if (!snapshot) return false;
+        game.loadSnapshot(*snapshot);
+        return true;
+    }
+
+    const GameSnapshot* find(std::uint32_t tick) const {
+        int slot = (int)(tick % (std::uint32_t)capacity);
+        return ticks[slot] == tick ? &snapshots[slot] : nullptr;
+    }
+
+    void clear() {
+        for (auto& tick : ticks) {
+            tick = EMPTY;
+        }
+        lastSaved = -1;
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// 单生产者单消费者无锁环形队列：一个线程只调用tryPush，另一个线程只调用tryPop
+// Capacity必须是2的幂，实际可容纳Capacity-1个元素
+template <typename T, size_t Capacity>
+class SpscQueue {
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    T slots[Capacity];
+
+    // 头尾索引分别只由消费者/生产者写入，分开缓存行避免伪共享
+    alignas(64) std::atomic<size_t> head;   // 下一个读取位置
+    alignas(64) std::atomic<size_t> tail;   // 下一个写入位置
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 生产者线程调用，队列满时返回false
+    bool tryPush(T&& value) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        size_t nextTail = (currentTail + 1) & (Capacity - 1);
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        slots[currentTail] = std::move(value);
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用，队列空时返回false
+    bool tryPop(T& value) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = std::move(slots[currentHead]);
+        head.store((currentHead + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+    // 仅作提示：另一线程可能同时在读写
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
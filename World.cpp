@@ -0,0 +1,815 @@
+#include "World.h"
+#include "WorldMotion.h"
+#include "Random.h"
+#include "Input.h"
+#include "JobSystem.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cfloat>
+
+// x86上金币的窄相位用SSE一次处理4枚，其他平台逐枚计算；开方和除法都是正确舍入，两种实现结果逐位相同
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WORLD_COIN_SSE 1
+#include <xmmintrin.h>
+#endif
+
+// 并行系统每段至少处理的实体数；实体更少时直接在本线程执行，不值得分发
+// 各系统的分段体按值捕获步长等标量：按引用捕获时每次写组件都要重新读取，单线程下也会变慢
+static const size_t PARALLEL_GRAIN = 256;
+
+// 金币上下浮动的幅度
+static const float COIN_BOB_AMPLITUDE = 3.0f;
+
+namespace {
+    // 障碍物本帧的扫掠框：帧初位置按帧初的经过时间求值，生成高度还原本帧的世界下移。
+    // 本帧中途生成的障碍物从生成时刻开始扫掠，只还原生成后的那部分下移
+    template <ObstacleType Type>
+    SweptBox sweptObstacle(const Obstacle<Type>& obstacle, float age, float scrollStep, float deltaTime) {
+        typedef ObstacleTraits<Type> Traits;
+        const float previousAge = std::max(0.0f, age - deltaTime);
+        const float scrolled = deltaTime > 0.0f ? scrollStep * (age - previousAge) / deltaTime : 0.0f;
+        const float previousBaseY = Traits::SCROLLS ? obstacle.y - scrolled : obstacle.y;
+        return SweptBox{
+            Traits::positionX(obstacle, previousAge), previousBaseY + Traits::offsetY(obstacle, previousAge),
+            Traits::positionX(obstacle, age), obstacle.y + Traits::offsetY(obstacle, age),
+            Traits::WIDTH, Traits::HEIGHT };
+    }
+}
+
+World::World() : timers(nullptr), events(nullptr), time(0.0), tickScroll(0.0f), tickDeltaTime(0.0f), activeTop(-FLT_MAX) {
+    // 各组件池一开始就按上限预留，游戏中实体数创新高时不在帧内扩容
+    registry.reserveEntities(ENTITY_CAPACITY);
+    registry.reserve<Transform>(ENTITY_CAPACITY);
+    registry.reserve<Bounds>(ENTITY_CAPACITY);
+    registry.reserve<PingPong>(ENTITY_CAPACITY);
+    registry.reserve<Scroll>(ENTITY_CAPACITY);
+    registry.reserve<Animation>(ENTITY_CAPACITY);
+    registry.reserve<Magnet>(ENTITY_CAPACITY);
+    registry.reserve<PlatformState>(ENTITY_CAPACITY);
+    forEachObstacleType([this](auto kind) {
+        registry.reserve<typename decltype(kind)::Component>(ENTITY_CAPACITY);
+    });
+    registry.reserve<CoinState>(ENTITY_CAPACITY);
+    registry.reserve<ItemState>(ENTITY_CAPACITY);
+    pendingDestroy.reserve(ENTITY_CAPACITY);
+    expireFlags.reserve(ENTITY_CAPACITY);
+    pickupMasks.reserve(ENTITY_CAPACITY);
+    dormantPlatforms.reserve(ENTITY_CAPACITY);
+    dormantCoins.reserve(ENTITY_CAPACITY);
+}
+
+void World::clear() {
+    registry.clear();
+    pendingDestroy.clear();
+    dormantPlatforms.clear();
+    dormantCoins.clear();
+    time = 0.0;
+    tickScroll = 0.0f;
+    tickDeltaTime = 0.0f;
+    activeTop = -FLT_MAX;
+}
+
+void World::saveState(WorldSnapshot& out, const WorldSnapshot* base) {
+    registry.save(out.registry, base ? &base->registry : nullptr);
+    // 休眠列表很短且逐项为POD，直接复制；赋值沿用快照中已有的容量
+    out.dormantPlatforms = dormantPlatforms;
+    out.dormantCoins = dormantCoins;
+    out.time = time;
+    out.activeTop = activeTop;
+}
+
+void World::restoreState(const WorldSnapshot& in) {
+    registry.restore(in.registry);
+    dormantPlatforms = in.dormantPlatforms;
+    dormantCoins = in.dormantCoins;
+    time = in.time;
+    activeTop = in.activeTop;
+    pendingDestroy.clear();
+}
+
+void World::destroy(Entity entity) {
+    // 平台连同其上的道具一起销毁，实体登记的定时一起取消
+    const Registry& view = registry;
+    if (const PlatformState* state = view.tryGet<PlatformState>(entity)) {
+        timers->cancel(state->respawnTimer);
+        registry.destroy(state->item);
+    }
+    forEachObstacleType([this, &view, entity](auto kind) {
+        if (const auto* obstacle = view.tryGet<typename decltype(kind)::Component>(entity)) {
+            timers->cancel(obstacle->expiry);
+        }
+    });
+    registry.destroy(entity);
+}
+
+void World::onTimer(const TimerEvent& event) {
+    Entity entity = (Entity)event.data;
+    if (!registry.valid(entity)) return;
+
+    switch (event.kind) {
+    case TIMER_OBSTACLE_EXPIRED:
+        destroy(entity);
+        break;
+    case TIMER_PLATFORM_RESPAWN:
+        // 破碎平台3秒后重生
+        if (PlatformState* state = registry.tryGet<PlatformState>(entity)) {
+            state->broken = false;
+            state->respawnTimer = NULL_TIMER;
+            state->hitCount = 0;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void World::destroyPending() {
+    for (Entity entity : pendingDestroy) {
+        destroy(entity);
+    }
+    pendingDestroy.clear();
+}
+
+// ---- 生成 ----
+
+Entity World::spawnPlatform(const Platform& platform, float offsetY) {
+    DormantPlatform record = {};
+    record.y = platform.getY() + offsetY;
+    record.startTime = time;
+    record.x = platform.getX();
+    record.width = platform.getWidth();
+    record.height = platform.getHeight();
+    record.type = platform.getType();
+    record.moving = platform.getType() == MOVING;
+    if (record.moving) {
+        float range = platform.getMoveRange();
+        record.track = PingPong{ platform.getStartX() - range, platform.getStartX() + range,
+            platform.getX(), platform.getMoveSpeed(), time };
+    }
+    if (const Item* item = platform.getItem()) {
+        record.hasItem = true;
+        record.itemX = item->x;
+        record.itemY = item->y + offsetY;
+        record.item = ItemState{ item->type, item->effectDuration, item->effectStrength, item->value };
+    }
+
+    if (record.y > activeTop) return createPlatform(record);
+
+    // 活动区上方：休眠，按高度插入保持升序
+    auto position = std::upper_bound(dormantPlatforms.begin(), dormantPlatforms.end(), record.y,
+        [](float y, const DormantPlatform& other) { return y < other.y; });
+    dormantPlatforms.insert(position, record);
+    return NULL_ENTITY;
+}
+
+Entity World::createPlatform(const DormantPlatform& record) {
+    Entity entity = registry.create();
+    registry.add(entity, Transform{ record.x, record.y });
+    registry.add(entity, Bounds{ record.width, record.height });
+    registry.add(entity, Scroll{});
+    registry.add(entity, Animation{ record.startTime, 0.0f });
+    if (record.moving) registry.add(entity, record.track);
+
+    PlatformState state = { record.type, false, NULL_TIMER, 0, 0.0f, false, NULL_ENTITY };
+
+    // 道具是独立实体，由平台记录句柄
+    if (record.hasItem) {
+        Entity itemEntity = registry.create();
+        registry.add(itemEntity, Transform{ record.itemX, record.itemY });
+        registry.add(itemEntity, Scroll{});
+        registry.add(itemEntity, Animation{ record.startTime, 0.0f });
+        registry.add(itemEntity, record.item);
+        state.item = itemEntity;
+    }
+
+    registry.add(entity, state);
+    return entity;
+}
+
+template <ObstacleType Type>
+Entity World::spawnObstacle(float x, float y) {
+    typedef ObstacleTraits<Type> Traits;
+    Obstacle<Type> obstacle = {};
+    obstacle.x = x;
+    obstacle.y = y;
+    obstacle.startTime = time;
+    Traits::init(obstacle);
+
+    Entity entity = registry.create();
+    obstacle.expiry = timers->schedule(Traits::LIFETIME, TimerEvent{ TIMER_OBSTACLE_EXPIRED, 0, entity });
+    registry.add(entity, obstacle);
+    return entity;
+}
+
+Entity World::spawnObstacle(float x, float y, ObstacleType type) {
+    // 只在生成时按类型分派一次
+    switch (type) {
+    case SPIKE: return spawnObstacle<SPIKE>(x, y);
+    case FIREBALL: return spawnObstacle<FIREBALL>(x, y);
+    case LASER: return spawnObstacle<LASER>(x, y);
+    case ROTATING_SAW: return spawnObstacle<ROTATING_SAW>(x, y);
+    case FALLING_ROCK: return spawnObstacle<FALLING_ROCK>(x, y);
+    case MOVING_WALL: return spawnObstacle<MOVING_WALL>(x, y);
+    }
+    return NULL_ENTITY;
+}
+
+Entity World::spawnCoin(float x, float y, int value) {
+    DormantCoin record = { y, time, x, value };
+    if (y > activeTop) return createCoin(record);
+
+    auto position = std::upper_bound(dormantCoins.begin(), dormantCoins.end(), y,
+        [](float y, const DormantCoin& other) { return y < other.y; });
+    dormantCoins.insert(position, record);
+    return NULL_ENTITY;
+}
+
+Entity World::createCoin(const DormantCoin& record) {
+    Entity entity = registry.create();
+    registry.add(entity, Transform{ record.x, record.y });
+    registry.add(entity, Scroll{});
+    registry.add(entity, Animation{ record.startTime, COIN_BOB_AMPLITUDE });
+    registry.add(entity, Magnet{ 200.0f, false });
+    registry.add(entity, CoinState{ record.value });
+    return entity;
+}
+
+void World::setActiveTop(float y) {
+    activeTop = y;
+
+    // 从最靠下的开始唤醒，同一帧醒来的按高度从下往上创建
+    while (!dormantPlatforms.empty() && dormantPlatforms.back().y > activeTop) {
+        createPlatform(dormantPlatforms.back());
+        dormantPlatforms.pop_back();
+    }
+    while (!dormantCoins.empty() && dormantCoins.back().y > activeTop) {
+        createCoin(dormantCoins.back());
+        dormantCoins.pop_back();
+    }
+}
+
+// ---- 系统 ----
+
+void World::scroll(float deltaY) {
+    tickScroll = deltaY;
+
+    // 休眠实体只有下移，列表很短，顺序累加；浮点舍入单调，升序保持不变
+    for (auto& record : dormantPlatforms) {
+        record.y += deltaY;
+        record.itemY += deltaY;
+    }
+    for (auto& record : dormantCoins) {
+        record.y += deltaY;
+    }
+
+    JobSystem& jobs = JobSystem::getInstance();
+    const auto& scrolls = registry.pool<Scroll>();
+    auto& transforms = registry.pool<Transform>();
+    Transform* transformData = transforms.data();
+    jobs.parallelFor(scrolls.size(), PARALLEL_GRAIN, [&scrolls, &transforms, transformData, deltaY](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            transformData[transforms.indexOf(scrolls.entityAt(i))].y += deltaY;
+        }
+    });
+
+    // 障碍物的生成高度在各自的组件中
+    forEachObstacleType([this, &jobs, deltaY](auto kind) {
+        typedef decltype(kind) Kind;
+        if (!Kind::Traits::SCROLLS) return;
+
+        auto* obstacleData = registry.pool<typename Kind::Component>().data();
+        jobs.parallelFor(registry.pool<typename Kind::Component>().size(), PARALLEL_GRAIN, [obstacleData, deltaY](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                obstacleData[i].y += deltaY;
+            }
+        });
+    });
+}
+
+void World::animate(float deltaTime) {
+    // 动画时间、旋转和浮动都按世界时间求值，这里只剩弹簧恢复
+    auto& platforms = registry.pool<PlatformState>();
+    for (size_t i = 0; i < platforms.size(); i++) {
+        PlatformState& state = platforms.at(i);
+        if (state.type != SPRING) continue;
+
+        if (state.springCompression > 0) {
+            state.springCompression -= deltaTime * 5.0f;
+            if (state.springCompression < 0) state.springCompression = 0;
+        }
+        state.springTriggered = false;
+    }
+}
+
+void World::move(float deltaTime) {
+    // 移动平台和障碍物的位置是经过时间的函数，在碰撞和绘制用到时求值，这里不遍历实体
+    time += deltaTime;
+    tickDeltaTime = deltaTime;
+}
+
+// 并行判定、再按dense顺序收集：销毁顺序与串行遍历相同，不随线程数变化
+template <typename T, typename Predicate>
+static void collectExpired(const ComponentPool<T>& pool, std::vector<std::uint8_t>& flags,
+    std::vector<Entity>& out, const Predicate& expired) {
+    // 只有一段时直接收集，不经过标记数组
+    if (pool.size() <= PARALLEL_GRAIN) {
+        for (size_t i = 0; i < pool.size(); i++) {
+            if (expired(i)) out.push_back(pool.entityAt(i));
+        }
+        return;
+    }
+
+    flags.resize(pool.size());
+    std::uint8_t* flagData = flags.data();
+    JobSystem::getInstance().parallelFor(pool.size(), PARALLEL_GRAIN, [&expired, flagData](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            flagData[i] = expired(i) ? 1 : 0;
+        }
+    });
+
+    for (size_t i = 0; i < pool.size(); i++) {
+        if (flagData[i]) out.push_back(pool.entityAt(i));
+    }
+}
+
+void World::expire(float cullY) {
+    // 只读遍历：寿命和重生由时间轮触发，这里不再修改组件，未变化的池在快照间继续共享
+    const Registry& view = registry;
+    const auto& transforms = view.pool<Transform>();
+
+    // 障碍物落出屏幕下方
+    const double now = time;
+    forEachObstacleType([this, &view, now](auto kind) {
+        typedef typename decltype(kind)::Traits Traits;
+        const auto& obstacles = view.pool<typename decltype(kind)::Component>();
+        collectExpired(obstacles, expireFlags, pendingDestroy, [&obstacles, now](size_t i) {
+            const auto& obstacle = obstacles.at(i);
+            return obstacle.y + Traits::offsetY(obstacle, (float)(now - obstacle.startTime)) > OBSTACLE_MAX_Y;
+        });
+    });
+
+    // 落到cullY以下的平台、金币移除
+    const auto& platforms = view.pool<PlatformState>();
+    collectExpired(platforms, expireFlags, pendingDestroy, [&transforms, &platforms, cullY](size_t i) {
+        return transforms.get(platforms.entityAt(i)).y > cullY;
+    });
+
+    const auto& coins = view.pool<CoinState>();
+    collectExpired(coins, expireFlags, pendingDestroy, [&transforms, &coins, cullY](size_t i) {
+        return transforms.get(coins.entityAt(i)).y > cullY;
+    });
+
+    destroyPending();
+}
+
+// ---- 碰撞 ----
+
+// 实体在世界时间at的位置：transform为组件中的位置，移动平台的x按往返求值
+Transform World::positionAt(Entity entity, const Transform& transform, double at) const {
+    Transform position = transform;
+    if (const PingPong* track = registry.tryGet<PingPong>(entity)) {
+        int direction;
+        position.x = pingPong(track->minX, track->maxX, track->startX, track->speed * (float)(at - track->startTime), direction);
+    }
+    return position;
+}
+
+// 实体在本帧开始时的位置：往返按上一帧的世界时间求值，再还原本帧scroll的下移
+Transform World::previousPosition(Entity entity, const Transform& transform) const {
+    Transform previous = positionAt(entity, transform, time - tickDeltaTime);
+    if (registry.has<Scroll>(entity)) {
+        previous.y -= tickScroll;
+    }
+    return previous;
+}
+
+Transform World::getPosition(Entity entity) const {
+    return positionAt(entity, registry.get<Transform>(entity), time);
+}
+
+float World::getVelocityX(Entity entity) const {
+    const PingPong* track = registry.tryGet<PingPong>(entity);
+    if (!track) return 0.0f;
+
+    int direction;
+    pingPong(track->minX, track->maxX, track->startX, track->speed * elapsedSince(track->startTime), direction);
+    return track->speed * direction;
+}
+
+// 一维扫掠：相对位置start + delta * t落在开区间(low, high)内的t区间与[enter, exit]求交
+static bool sweepAxis(float start, float delta, float low, float high, float& enter, float& exit) {
+    if (delta == 0.0f) {
+        return start > low && start < high;
+    }
+    float t0 = (low - start) / delta;
+    float t1 = (high - start) / delta;
+    if (t0 > t1) std::swap(t0, t1);
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    return enter < exit;
+}
+
+bool sweepBoxes(const SweptBox& a, const SweptBox& b, float& enter) {
+    // 在b的参照系中扫掠a：相对位置在(-a的尺寸, b的尺寸)内即为重叠
+    float startX = a.x0 - b.x0;
+    float startY = a.y0 - b.y0;
+    float deltaX = (a.x1 - b.x1) - startX;
+    float deltaY = (a.y1 - b.y1) - startY;
+
+    float exit = 1.0f;
+    enter = 0.0f;
+    if (!sweepAxis(startX, deltaX, -a.width, b.width, enter, exit)) return false;
+    if (!sweepAxis(startY, deltaY, -a.height, b.height, enter, exit)) return false;
+
+    // 帧初已重叠、帧内分开：落地吸附可能把玩家推进障碍物一点，这样的接触上一帧已经处理过
+    return enter > 0.0f || exit >= 1.0f;
+}
+
+// 各段分别记录每名玩家最早的接触，再按段序合并：时刻相同时dense顺序靠前的优先，与串行遍历结果相同
+template <typename Scan>
+void World::findFirstContacts(size_t entityCount, size_t count, Entity* hits, const Scan& scan) const {
+    // 调用方最多传入MAX_LOCAL_PLAYERS名玩家
+    Contact first[MAX_LOCAL_PLAYERS];
+    std::fill(first, first + count, Contact{ NULL_ENTITY, 2.0f });
+    mergeFirstContacts(entityCount, count, first, scan);
+    for (size_t p = 0; p < count; p++) {
+        hits[p] = first[p].entity;
+    }
+}
+
+template <typename Scan>
+void World::mergeFirstContacts(size_t entityCount, size_t count, Contact* first, const Scan& scan) const {
+    // 只有一段时直接在first上比较
+    if (entityCount <= PARALLEL_GRAIN) {
+        scan(0, entityCount, first);
+        return;
+    }
+
+    size_t rangeCount = (entityCount + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+    contactScratch.assign(rangeCount * count, Contact{ NULL_ENTITY, 2.0f });
+    Contact* ranges = contactScratch.data();
+
+    JobSystem::getInstance().parallelFor(entityCount, PARALLEL_GRAIN, [&scan, ranges, count](size_t begin, size_t end) {
+        scan(begin, end, ranges + begin / PARALLEL_GRAIN * count);
+    });
+
+    for (size_t p = 0; p < count; p++) {
+        for (size_t r = 0; r < rangeCount; r++) {
+            if (ranges[r * count + p].time < first[p].time) {
+                first[p] = ranges[r * count + p];
+            }
+        }
+    }
+}
+
+void World::findLandingPlatforms(const PlayerBox* players, size_t count, Entity* hits) const {
+    const auto& platforms = registry.pool<PlatformState>();
+    const auto& transforms = registry.pool<Transform>();
+    const auto& bounds = registry.pool<Bounds>();
+
+    const float scrollStep = tickScroll;
+    findFirstContacts(platforms.size(), count, hits,
+        [this, &platforms, &transforms, &bounds, players, count, scrollStep](size_t begin, size_t end, Contact* first) {
+        for (size_t i = begin; i < end; i++) {
+            const PlatformState& state = platforms.at(i);
+            // 跳过已破碎的平台的碰撞检测
+            if (state.broken) continue;
+
+            Entity entity = platforms.entityAt(i);
+            const Transform& transform = transforms.get(entity);
+            const float platformWidth = bounds.get(entity).width;
+
+            // 平台竖直方向只随世界下移（见spawnPlatform），帧初的顶面可以直接算出；
+            // 移动平台的水平位置按世界时间求值，只在竖直方向接触时才计算
+            const float previousTop = transform.y - scrollStep;
+            bool hasPrevious = false;
+            Transform previous, current;
+
+            // 对于弹簧平台放宽条件确保能够触发
+            float landingWindow = state.type == SPRING ? 20.0f : 15.0f;
+
+            for (size_t p = 0; p < count; p++) {
+                const PlayerBox& player = players[p];
+
+                // 玩家底边相对平台顶面的位置：帧初和帧末
+                float startDepth = player.prevY + player.height - previousTop;
+                float endDepth = player.y + player.height - transform.y;
+
+                // 帧末落在接触窗口内，或本帧从上方越过了顶面（高速下落时一帧可以越过整个窗口）
+                if (endDepth < 0.0f) continue;
+                bool crossed = startDepth <= 0.0f;
+                if (!crossed && endDepth > landingWindow) continue;
+
+                // 接触时刻：越过顶面的那一刻；帧初已在窗口内时为0
+                float contact = 0.0f;
+                if (crossed && endDepth > startDepth) {
+                    contact = -startDepth / (endDepth - startDepth);
+                }
+                if (contact >= first[p].time) continue;
+
+                // 接触时刻的水平重叠
+                if (!hasPrevious) {
+                    previous = previousPosition(entity, transform);
+                    current = positionAt(entity, transform, time);
+                    hasPrevious = true;
+                }
+                float playerLeft = player.prevX + (player.x - player.prevX) * contact;
+                float platformLeft = previous.x + (current.x - previous.x) * contact;
+                if (playerLeft + player.width > platformLeft && playerLeft < platformLeft + platformWidth) {
+                    first[p] = Contact{ entity, contact };
+                }
+            }
+        }
+    });
+}
+
+void World::findObstacleHits(const PlayerBox* players, size_t count, Entity* hits) const {
+    Contact first[MAX_LOCAL_PLAYERS];
+    std::fill(first, first + count, Contact{ NULL_ENTITY, 2.0f });
+
+    // 各类型的池依次扫描，每名玩家保留所有类型中最早的接触
+    const float scrollStep = tickScroll, deltaTime = tickDeltaTime;
+    const double now = time;
+    forEachObstacleType([this, players, count, &first, scrollStep, deltaTime, now](auto kind) {
+        const auto& obstacles = registry.pool<typename decltype(kind)::Component>();
+        mergeFirstContacts(obstacles.size(), count, first,
+            [&obstacles, players, count, scrollStep, deltaTime, now](size_t begin, size_t end, Contact* first) {
+            for (size_t i = begin; i < end; i++) {
+                const auto& obstacle = obstacles.at(i);
+                const SweptBox obstacleBox = sweptObstacle(obstacle, (float)(now - obstacle.startTime), scrollStep, deltaTime);
+
+                for (size_t p = 0; p < count; p++) {
+                    const PlayerBox& player = players[p];
+
+                    SweptBox box = { player.prevX, player.prevY, player.x, player.y, player.width, player.height };
+                    float enter;
+                    if (!sweepBoxes(box, obstacleBox, enter)) continue;
+
+                    if (enter < first[p].time) {
+                        first[p] = Contact{ obstacles.entityAt(i), enter };
+                    }
+                }
+            }
+        });
+    });
+
+    for (size_t p = 0; p < count; p++) {
+        hits[p] = first[p].entity;
+    }
+}
+
+// ---- 金币窄相位 ----
+// 金币按块读入按分量存放的数组，长度补齐到4的倍数；补齐的分量参与计算但结果不使用
+
+static const size_t COIN_BLOCK = 64;
+
+// 磁铁：与目标的距离平方在半径内（且不重合）的金币以speeds的速度朝目标移动，attracted记下被吸引的金币
+static void attractCoins(float* xs, float* ys, const float* speeds, std::uint8_t* attracted, size_t lanes,
+    float targetX, float targetY, float radiusSquared, float deltaTime) {
+#if WORLD_COIN_SSE
+    const __m128 tx = _mm_set1_ps(targetX), ty = _mm_set1_ps(targetY);
+    const __m128 r2 = _mm_set1_ps(radiusSquared), dt = _mm_set1_ps(deltaTime), zero = _mm_setzero_ps();
+    for (size_t k = 0; k < lanes; k += 4) {
+        __m128 x = _mm_loadu_ps(xs + k), y = _mm_loadu_ps(ys + k);
+        __m128 dx = _mm_sub_ps(tx, x), dy = _mm_sub_ps(ty, y);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 inside = _mm_and_ps(_mm_cmplt_ps(d2, r2), _mm_cmpgt_ps(d2, zero));
+        // 每枚只开方、除法各一次：step = speed * dt / distance，位移为dx * step
+        __m128 step = _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(speeds + k), dt), _mm_sqrt_ps(d2));
+        // 范围外的分量与0相加，位置不变（其中除以0得到的值被掩码清掉）
+        step = _mm_and_ps(inside, step);
+        _mm_storeu_ps(xs + k, _mm_add_ps(x, _mm_mul_ps(dx, step)));
+        _mm_storeu_ps(ys + k, _mm_add_ps(y, _mm_mul_ps(dy, step)));
+
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            attracted[k + lane] |= (std::uint8_t)((mask >> lane) & 1);
+        }
+    }
+#else
+    for (size_t k = 0; k < lanes; k++) {
+        float dx = targetX - xs[k];
+        float dy = targetY - ys[k];
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared < radiusSquared && distanceSquared > 0.0f) {
+            float step = speeds[k] * deltaTime / sqrt(distanceSquared);
+            xs[k] += dx * step;
+            ys[k] += dy * step;
+            attracted[k] = 1;
+        }
+    }
+#endif
+}
+
+// 拾取的粗筛：金币中心到矩形[left, right] x [top, bottom]的距离平方小于radiusSquared的写1
+static void markNearCoins(const float* xs, const float* ys, std::uint8_t* candidates, size_t lanes,
+    float left, float right, float top, float bottom, float radiusSquared) {
+#if WORLD_COIN_SSE
+    const __m128 l = _mm_set1_ps(left), r = _mm_set1_ps(right), t = _mm_set1_ps(top), b = _mm_set1_ps(bottom);
+    const __m128 r2 = _mm_set1_ps(radiusSquared);
+    for (size_t k = 0; k < lanes; k += 4) {
+        __m128 x = _mm_loadu_ps(xs + k), y = _mm_loadu_ps(ys + k);
+        __m128 dx = _mm_sub_ps(x, _mm_max_ps(l, _mm_min_ps(x, r)));
+        __m128 dy = _mm_sub_ps(y, _mm_max_ps(t, _mm_min_ps(y, b)));
+        int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(_mm_mul_ps(dx, dx), r2), _mm_cmplt_ps(_mm_mul_ps(dy, dy), r2)));
+        for (int lane = 0; lane < 4; lane++) {
+            candidates[k + lane] = (std::uint8_t)((mask >> lane) & 1);
+        }
+    }
+#else
+    for (size_t k = 0; k < lanes; k++) {
+        float dx = xs[k] - std::max(left, std::min(xs[k], right));
+        float dy = ys[k] - std::max(top, std::min(ys[k], bottom));
+        candidates[k] = dx * dx < radiusSquared && dy * dy < radiusSquared ? 1 : 0;
+    }
+#endif
+}
+
+void World::collectCoins(const CoinCollector* collectors, size_t count, float deltaTime, std::vector<CoinPickup>& out) {
+    static_assert(MAX_LOCAL_PLAYERS <= 8, "pickup masks hold one bit per collector");
+    out.clear();
+    const Registry& view = registry;
+    const auto& coins = view.pool<CoinState>();
+    if (count == 0 || coins.size() == 0) return;
+
+    // 没有磁铁的帧只读：不把位置和磁铁组件池标为已修改，回滚快照可以继续共享
+    bool magnetic = false;
+    for (size_t c = 0; c < count; c++) {
+        if (collectors[c].magnetRadius > 0.0f) magnetic = true;
+    }
+    const auto& transforms = view.pool<Transform>();
+    const auto& magnets = view.pool<Magnet>();
+    const auto& animations = view.pool<Animation>();
+    const Transform* transformRead = transforms.data();
+    Transform* transformData = magnetic ? registry.pool<Transform>().data() : nullptr;
+    Magnet* magnetData = magnetic ? registry.pool<Magnet>().data() : nullptr;
+
+    pickupMasks.resize(coins.size());
+    std::uint8_t* maskData = pickupMasks.data();
+    const double now = time;
+
+    JobSystem::getInstance().parallelFor(coins.size(), PARALLEL_GRAIN,
+        [&coins, &transforms, &magnets, &animations, transformRead, transformData, magnetData, maskData,
+         collectors, count, deltaTime, now](size_t begin, size_t end) {
+        const float coinRadius = 12.0f;
+        const float coinRadiusSquared = coinRadius * coinRadius;
+
+        std::uint32_t slots[COIN_BLOCK], magnetSlots[COIN_BLOCK];
+        float xs[COIN_BLOCK], ys[COIN_BLOCK], speeds[COIN_BLOCK];
+        std::uint8_t attracted[COIN_BLOCK], candidates[COIN_BLOCK];
+
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += COIN_BLOCK) {
+            const size_t n = std::min(COIN_BLOCK, end - blockBegin);
+            const size_t lanes = (n + 3) & ~(size_t)3;
+            for (size_t k = 0; k < n; k++) {
+                Entity entity = coins.entityAt(blockBegin + k);
+                slots[k] = transforms.indexOf(entity);
+                xs[k] = transformRead[slots[k]].x;
+                ys[k] = transformRead[slots[k]].y;
+                if (magnetData) {
+                    magnetSlots[k] = magnets.indexOf(entity);
+                    speeds[k] = magnetData[magnetSlots[k]].speed;
+                }
+            }
+            for (size_t k = n; k < lanes; k++) {
+                xs[k] = ys[k] = speeds[k] = 0.0f;
+            }
+
+            if (magnetData) {
+                std::fill(attracted, attracted + lanes, (std::uint8_t)0);
+                for (size_t c = 0; c < count; c++) {
+                    const CoinCollector& collector = collectors[c];
+                    if (collector.magnetRadius <= 0.0f) continue;
+                    attractCoins(xs, ys, speeds, attracted, lanes,
+                        collector.x + collector.width / 2, collector.y + collector.height / 2,
+                        collector.magnetRadius * collector.magnetRadius, deltaTime);
+                }
+                // 整块写回：没被吸引的位置加的是0，写回原值；被吸引的金币约一半且随机分布，按条件写回时分支难以预测
+                for (size_t k = 0; k < n; k++) {
+                    transformData[slots[k]].x = xs[k];
+                    transformData[slots[k]].y = ys[k];
+                    Magnet& magnet = magnetData[magnetSlots[k]];
+                    magnet.attracted = magnet.attracted || attracted[k] != 0;
+                }
+            }
+
+            // 拾取：圆形与矩形。先与上下各放宽浮动幅度的矩形比较，碰得到的才计算浮动
+            std::fill(maskData + blockBegin, maskData + blockBegin + n, (std::uint8_t)0);
+            for (size_t c = 0; c < count; c++) {
+                const CoinCollector& collector = collectors[c];
+                const float left = collector.x;
+                const float right = collector.x + collector.width;
+                markNearCoins(xs, ys, candidates, lanes, left, right,
+                    collector.y - COIN_BOB_AMPLITUDE, collector.y + collector.height + COIN_BOB_AMPLITUDE, coinRadiusSquared);
+
+                for (size_t k = 0; k < n; k++) {
+                    if (!candidates[k]) continue;
+
+                    const Animation& animation = animations.get(coins.entityAt(blockBegin + k));
+                    float centerY = ys[k] + bobOffset(animation, (float)(now - animation.startTime));
+                    float dx = xs[k] - std::max(left, std::min(xs[k], right));
+                    float dy = centerY - std::max(collector.y, std::min(centerY, collector.y + collector.height));
+                    if (dx * dx + dy * dy < coinRadiusSquared) {
+                        maskData[blockBegin + k] |= (std::uint8_t)(1u << c);
+                    }
+                }
+            }
+        }
+    });
+
+    // 按dense顺序收集，结果不随线程数变化
+    for (size_t i = 0; i < coins.size(); i++) {
+        std::uint8_t mask = maskData[i];
+        if (mask == 0) continue;
+
+        size_t collector = 0;
+        while (!((mask >> collector) & 1u)) collector++;
+        out.push_back(CoinPickup{ coins.entityAt(i), collector });
+    }
+}
+
+void World::landOnPlatform(Entity platform, int player, float& playerVY) {
+    PlatformState* state = registry.tryGet<PlatformState>(platform);
+    if (!state || state->broken) return;
+
+    // 处理不同类型平台的特殊效果
+    switch (state->type) {
+    case BREAKABLE:
+        state->hitCount++;
+        if (state->hitCount >= 1) {  // 踩一次就破
+            state->broken = true;
+            state->respawnTimer = timers->schedule(PLATFORM_RESPAWN_TIME, TimerEvent{ TIMER_PLATFORM_RESPAWN, 0, platform });
+            if (events) events->push(EVENT_PLATFORM_BROKE, player);
+        }
+        break;
+
+    case SPRING:
+        // 1. 玩家向下移动时始终触发
+        // 2. 轻微向上移动或静止时，如果弹簧本帧未被触发过，也可以触发
+        if (playerVY > 0 || (playerVY >= -50.0f && !state->springTriggered)) {
+            playerVY = -500.0f;  // 弹簧力度
+            state->springCompression = 1.0f;
+            state->springTriggered = true;
+            if (events) events->push(EVENT_SPRING_BOUNCE, player);
+
+            // 增加动画计时器来创建视觉反馈
+            registry.get<Animation>(platform).startTime -= 0.5;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool World::getObstacleInfo(Entity entity, ObstacleType& type, int& damage) const {
+    bool found = false;
+    forEachObstacleType([this, entity, &type, &damage, &found](auto kind) {
+        typedef decltype(kind) Kind;
+        if (registry.has<typename Kind::Component>(entity)) {
+            type = Kind::type;
+            damage = Kind::Traits::DAMAGE;
+            found = true;
+        }
+    });
+    return found;
+}
+
+void World::collectObstacles(float minY, float maxY, std::vector<ObstacleView>& out) const {
+    forEachObstacleType([this, minY, maxY, &out](auto kind) {
+        typedef typename decltype(kind)::Traits Traits;
+        const auto& obstacles = registry.pool<typename decltype(kind)::Component>();
+        for (size_t i = 0; i < obstacles.size(); i++) {
+            const auto& obstacle = obstacles.at(i);
+            const float age = elapsedSince(obstacle.startTime);
+            const float y = obstacle.y + Traits::offsetY(obstacle, age);
+            if (y < minY || y > maxY) continue;
+
+            ObstacleView view = { Traits::positionX(obstacle, age), y, Traits::WIDTH, Traits::HEIGHT, 0.0f, 0.0f, 0.0f, Traits::SCROLLS };
+            Traits::velocity(obstacle, age, view.vx, view.vy, view.gravity);
+            out.push_back(view);
+        }
+    });
+}
+
+size_t World::getObstacleCount() const {
+    size_t count = 0;
+    forEachObstacleType([this, &count](auto kind) {
+        count += registry.pool<typename decltype(kind)::Component>().size();
+    });
+    return count;
+}
+
+bool World::takePlatformItem(Entity platform, ItemState& item) {
+    PlatformState* state = registry.tryGet<PlatformState>(platform);
+    if (!state) return false;
+
+    const ItemState* itemState = registry.tryGet<ItemState>(state->item);
+    if (!itemState) return false;
+
+    item = *itemState;
+    registry.destroy(state->item);
+    state->item = NULL_ENTITY;
+    return true;
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include "Ecs.h"
+#include "Components.h"
+#include "Platform.h"
+#include "GameEvents.h"
+#include <vector>
+
+// 玩家碰撞框：prevX/prevY为本帧移动前的位置，平台和障碍物按整帧的扫掠检测，高速下也不会穿过
+struct PlayerBox {
+    float x, y;
+    float width, height;
+    float prevX, prevY;
+};
+
+// 一帧内从(x0, y0)线性移动到(x1, y1)的碰撞框
+struct SweptBox {
+    float x0, y0;
+    float x1, y1;
+    float width, height;
+};
+
+// 扫掠AABB：帧内开始重叠或帧末仍重叠时返回true，enter为首次接触的时刻（0~1）
+// 帧初已重叠、帧内分开的不算：帧初位置属于上一帧
+bool sweepBoxes(const SweptBox& a, const SweptBox& b, float& enter);
+
+// 障碍物的位置、尺寸和运动参数（AI规划用），y(t) = y + vy * t + gravity * t^2 / 2，scrolls时再加上世界下移
+struct ObstacleView {
+    float x, y, width, height;
+    float vx, vy, gravity;
+    bool scrolls;
+};
+
+// 收集金币的玩家：碰撞框和磁铁半径（没有磁铁时为0），磁铁以碰撞框中心为目标
+struct CoinCollector {
+    float x, y, width, height;
+    float magnetRadius;
+};
+
+// 本帧拾取的金币：collector为CoinCollector数组中的下标
+struct CoinPickup {
+    Entity coin;
+    size_t collector;
+};
+
+// 休眠的平台（连同道具）和金币：生成在活动区上方时只记下创建实体所需的参数，进入活动区时再创建。
+// 休眠期间只随世界下移，与活动实体同样逐帧累加，醒来时的位置与一直存在时逐位相同
+struct DormantPlatform {
+    float y, itemY;
+    double startTime;           // 原定的生成时间，醒来后往返和动画的相位与立即生成时相同
+    float x, width, height;
+    PlatformType type;
+    bool moving;
+    PingPong track;
+    bool hasItem;
+    float itemX;
+    ItemState item;
+};
+
+struct DormantCoin {
+    float y;
+    double startTime;
+    float x;
+    int value;
+};
+
+// 世界的回滚快照：实体、休眠实体和世界时间
+struct WorldSnapshot {
+    RegistrySnapshot registry;
+    std::vector<DormantPlatform> dormantPlatforms;
+    std::vector<DormantCoin> dormantCoins;
+    double time = 0.0;
+    float activeTop = 0.0f;
+};
+
+// 世界中的平台、障碍物、金币和道具：实体与组件存放在Registry中，
+// 各系统按组件遍历连续内存；新增一种实体只需组合已有组件，必要时再加一个系统
+class World {
+private:
+    Registry registry;
+    std::vector<Entity> pendingDestroy;     // 遍历中标记销毁，遍历结束后统一处理
+    TimerWheel* timers;                     // 障碍物寿命和破碎平台重生登记在游戏时钟的时间轮上
+    GameEventBuffer* events;
+    double time;                            // 世界时间：move累计的游戏层时间，往返、旋转等运动按它求值
+    float tickScroll;                       // 本帧scroll的下移量和move的时间步长，用于还原实体在本帧开始时的位置
+    float tickDeltaTime;
+
+    // 活动区：activeTop以上生成的平台和金币先休眠，不进入组件池，各系统的开销只取决于活动区内的实体。
+    // 休眠列表按高度升序排列，末尾的最靠下、最先醒来
+    float activeTop;
+    std::vector<DormantPlatform> dormantPlatforms;
+    std::vector<DormantCoin> dormantCoins;
+
+    // 并行系统的暂存：过期判定标记、各段的最早接触（碰撞查询是const，暂存只作缓冲）
+    struct Contact {
+        Entity entity;
+        float time;
+    };
+    std::vector<std::uint8_t> expireFlags;
+    std::vector<std::uint8_t> pickupMasks;      // 每枚金币碰到的收集者，按下标取位
+    mutable std::vector<Contact> contactScratch;
+
+    void destroyPending();
+    Transform positionAt(Entity entity, const Transform& transform, double at) const;
+    Transform previousPosition(Entity entity, const Transform& transform) const;
+    float elapsedSince(double startTime) const { return (float)(time - startTime); }
+
+    // 把实体按段分给任务池扫描，scan(begin, end, first)为count名玩家各写入本段最早的接触
+    template <typename Scan>
+    void findFirstContacts(size_t entityCount, size_t count, Entity* hits, const Scan& scan) const;
+    // 同上，结果与first中已有的接触合并（时刻相同时保留已有的），用于依次扫描多个组件池
+    template <typename Scan>
+    void mergeFirstContacts(size_t entityCount, size_t count, Contact* first, const Scan& scan) const;
+
+    template <ObstacleType Type>
+    Entity spawnObstacle(float x, float y);
+
+    Entity createPlatform(const DormantPlatform& record);
+    Entity createCoin(const DormantCoin& record);
+
+public:
+    static constexpr float PLATFORM_RESPAWN_TIME = 3.0f;   // 破碎平台重生前的时间
+    static const size_t ENTITY_CAPACITY = 1024;             // 预留容量：同时存在的实体数在此之内时组件池不再扩容
+    static constexpr float OBSTACLE_MAX_Y = 1000.0f;        // 障碍物越过此高度（落出屏幕下方）即移除
+    static constexpr float LASER_TRACK_WIDTH = 1200.0f;     // 激光往返的范围：窗口宽度
+
+    World();
+
+    // 绑定时间轮，生成障碍物和踩碎平台前必须绑定
+    void bindTimers(TimerWheel* wheel) { timers = wheel; }
+    // 绑定事件缓冲：平台破碎、弹簧弹起追加到这里；未绑定时不记录
+    void bindEvents(GameEventBuffer* buffer) { events = buffer; }
+
+    Registry& getRegistry() { return registry; }
+    const Registry& getRegistry() const { return registry; }
+
+    void clear();
+
+    // 保存/恢复所有实体、休眠实体和世界时间（回滚快照），未变化的组件池与base共享；待销毁列表在每个系统结束时已清空，不需要保存
+    void saveState(WorldSnapshot& out, const WorldSnapshot* base = nullptr);
+    void restoreState(const WorldSnapshot& in);
+
+    double getTime() const { return time; }
+
+    // 活动区上沿：之后生成在它上方的平台和金币休眠（返回NULL_ENTITY），已休眠的进入活动区时创建。
+    // 每帧在拼接新分块之前更新，须在scroll之后；clear后为负无穷，全部立即生成
+    void setActiveTop(float y);
+
+    // 生成实体
+    Entity spawnPlatform(const Platform& platform, float offsetY = 0.0f);   // offsetY：整体下移（拼接分块）
+    Entity spawnObstacle(float x, float y, ObstacleType type);
+    Entity spawnCoin(float x, float y, int value);
+    void destroy(Entity entity);
+
+    // 系统
+    void scroll(float deltaY);                                                  // 所有Scroll实体和休眠实体下移
+    void animate(float deltaTime);                                              // 弹簧回弹
+    void move(float deltaTime);                                                 // 推进世界时间，往返、旋转、浮动和障碍物的运动随之改变
+    void expire(float cullY);                                                   // 剔除越过OBSTACLE_MAX_Y的障碍物和cullY以下的平台、金币
+    void onTimer(const TimerEvent& event);                                      // 时间轮触发：障碍物寿命到期、破碎平台重生
+
+    // 碰撞：为每名玩家写入本帧最先接触的实体（按接触时间排序），没有时为NULL_ENTITY
+    // 平台和障碍物用玩家与实体在本帧内的相对位移做扫掠检测，须在scroll和move之后调用
+    // 多名玩家一起查询，每个实体的组件只读取一次，再依次与各玩家比较
+    void findLandingPlatforms(const PlayerBox* players, size_t count, Entity* hits) const;
+    void findObstacleHits(const PlayerBox* players, size_t count, Entity* hits) const;
+
+    // 金币的磁铁吸附和拾取：一次遍历完成。金币按块读入局部的坐标数组，对各收集者先用距离平方筛出磁铁范围
+    // 和可能碰到的金币，只有范围内的才开方求方向、计算浮动；吸附后再判定拾取。
+    // 本帧碰到的金币全部按dense顺序写入out（不销毁），两名玩家同时碰到的归下标小的
+    void collectCoins(const CoinCollector* collectors, size_t count, float deltaTime, std::vector<CoinPickup>& out);
+
+    // 玩家落在平台上：触发易碎/弹簧效果，可能修改playerVY；player为事件中的玩家序号
+    void landOnPlatform(Entity platform, int player, float& playerVY);
+
+    // 取走平台上的道具，成功时写入item并返回true
+    bool takePlatformItem(Entity platform, ItemState& item);
+
+    // 平台、金币、道具的当前位置（移动平台按世界时间求值）和水平速度
+    Transform getPosition(Entity entity) const;
+    float getVelocityX(Entity entity) const;
+
+    // 障碍物的类型和伤害，entity不是障碍物时返回false
+    bool getObstacleInfo(Entity entity, ObstacleType& type, int& damage) const;
+
+    // 把y在[minY, maxY]内的障碍物追加到out
+    void collectObstacles(float minY, float maxY, std::vector<ObstacleView>& out) const;
+
+    // 渲染：只绘制y在(minY, maxY)内的实体，平台上的道具随平台一起绘制
+    void drawPlatforms(float offsetX, float offsetY, float minY, float maxY) const;
+    void drawObstacles(float offsetX, float offsetY, float minY, float maxY) const;
+    void drawCoins(float offsetX, float offsetY, float minY, float maxY) const;
+
+    // 统计
+    size_t getPlatformCount() const { return registry.pool<PlatformState>().size(); }
+    size_t getObstacleCount() const;
+    size_t getCoinCount() const { return registry.pool<CoinState>().size(); }
+    size_t getDormantCount() const { return dormantPlatforms.size() + dormantCoins.size(); }
+};
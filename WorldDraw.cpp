@@ -0,0 +1,715 @@
+#include "World.h"
+#include "WorldMotion.h"
+#include "DrawUtils.h"
+#include <cmath>
+
+// World的绘制部分：只读组件，依赖图形库，只在Windows上编译
+
+static void drawPlatform(const Transform& transform, const Bounds& bounds, const PlatformState& state,
+    float animationTimer, const PingPong* track, int moveDirection, float offsetX, float offsetY) {
+    if (state.broken) return;  // 不绘制已破碎的平台
+
+    const float x = transform.x, y = transform.y;
+    const float width = bounds.width, height = bounds.height;
+    const PlatformType type = state.type;
+    const int hitCount = state.hitCount;
+    const float springCompression = state.springCompression;
+
+    float drawX = x + offsetX;
+    float drawY = y + offsetY;
+
+    // 根据类型设置颜色和效果
+    COLORREF drawColor;
+
+    switch (type) {
+    case NORMAL:
+        // 普通平台 - 简洁的矩形
+        drawColor = Theme::PLATFORM_NORMAL;
+        setfillcolor(drawColor);
+        solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+        // 简单的顶部高光
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        line((int)drawX, (int)drawY, (int)(drawX + width), (int)drawY);
+        break;
+
+    case MOVING: {
+        // 移动平台 - 带有动态箭头指示器
+        float pulse = 0.8f + 0.2f * std::sin(animationTimer * 3.0f);
+        int r = GetRValue(Theme::PLATFORM_MOVING);
+        int g = GetGValue(Theme::PLATFORM_MOVING);
+        int b = GetBValue(Theme::PLATFORM_MOVING);
+        drawColor = RGB((int)(r * pulse), (int)(g * pulse), (int)(b * pulse));
+
+        // 绘制主体
+        setfillcolor(drawColor);
+        solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+        // 绘制移动轨迹线
+        if (track) {
+            setlinecolor(Theme::PLATFORM_MOVING_TRAIL);
+            setlinestyle(PS_SOLID, 1);
+            line((int)(track->minX + offsetX), (int)(drawY + height / 2),
+                (int)(track->maxX + offsetX), (int)(drawY + height / 2));
+        }
+
+        // 动态移动方向箭头
+        float arrowX = drawX + width / 2 + 15 * moveDirection;
+        float arrowY = drawY - 8;
+
+        setfillcolor(Theme::ACCENT);
+        // 绘制箭头
+        POINT arrow[3];
+        if (moveDirection > 0) {
+            arrow[0] = { (int)arrowX, (int)arrowY };
+            arrow[1] = { (int)(arrowX - 8), (int)(arrowY - 4) };
+            arrow[2] = { (int)(arrowX - 8), (int)(arrowY + 4) };
+        }
+        else {
+            arrow[0] = { (int)arrowX, (int)arrowY };
+            arrow[1] = { (int)(arrowX + 8), (int)(arrowY - 4) };
+            arrow[2] = { (int)(arrowX + 8), (int)(arrowY + 4) };
+        }
+        fillpolygon(arrow, 3);
+        break;
+    }
+
+    case BREAKABLE: {
+        // 易碎平台 - 带有裂纹效果
+        float flicker = 0.7f + 0.3f * std::sin(animationTimer * 6.0f);
+        int r = GetRValue(Theme::PLATFORM_BREAKABLE);
+        int g = GetGValue(Theme::PLATFORM_BREAKABLE);
+        int b = GetBValue(Theme::PLATFORM_BREAKABLE);
+        drawColor = RGB((int)(r * flicker), (int)(g * flicker), (int)(b * flicker));
+
+        setfillcolor(drawColor);
+        solidrectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+
+        // 绘制裂纹图案
+        setlinecolor(Theme::PLATFORM_BREAKABLE_WARNING);
+        setlinestyle(PS_SOLID, 1);
+
+        // 绘制几条裂纹线
+        for (int i = 1; i <= 3; i++) {
+            float crackX = drawX + width * i / 4;
+            line((int)crackX, (int)drawY, (int)crackX, (int)(drawY + height));
+        }
+
+        // 危险标识 - 小三角形
+        setfillcolor(Theme::WARNING);
+        POINT warning[3] = {
+            {(int)(drawX + width / 2), (int)(drawY - 8)},
+            {(int)(drawX + width / 2 - 6), (int)(drawY - 2)},
+            {(int)(drawX + width / 2 + 6), (int)(drawY - 2)}
+        };
+        fillpolygon(warning, 3);
+
+        // 计算破裂进度
+        float breakProgress = (float)hitCount / 1.0f; // 1次命中就破裂
+
+        // 如果快要破裂，添加警告效果
+        if (breakProgress > 0.5f) {
+            // 警告光晕效果可以在这里添加
+        }
+
+        // 感叹号
+        settextcolor(RGB(255, 255, 255));
+        settextstyle(12, 0, L"Arial");
+        outtextxy((int)(drawX + width / 2 - 3), (int)(drawY - 7), L"!");
+        break;
+    }
+
+    case SPRING: {
+        // 弹簧平台 - 根据压缩状态调整高度，添加弹簧视觉效果
+        float actualHeight = height * (1.0f - springCompression * 0.3f);
+        float actualY = drawY + (height - actualHeight);
+
+        drawColor = Theme::PLATFORM_SPRING;
+
+        // 绘制弹簧平台主体
+        setfillcolor(drawColor);
+        solidrectangle((int)drawX, (int)actualY, (int)(drawX + width), (int)(actualY + actualHeight));
+
+        // 绘制弹簧螺旋线纹理
+        setlinecolor(RGB(80, 120, 100));
+        setlinestyle(PS_SOLID, 2);
+
+        for (int i = 0; i < 4; i++) {
+            float lineY = actualY + actualHeight * (i + 1) / 5;
+            // 波浪线效果
+            for (int j = 0; j < width - 10; j += 5) {
+                float waveY = lineY + 2 * std::sin((j + animationTimer * 100) * 0.3f);
+                line((int)(drawX + j), (int)lineY, (int)(drawX + j + 5), (int)waveY);
+            }
+        }
+
+        // 弹簧标识 - 向上箭头
+        setfillcolor(Theme::PLATFORM_SPRING_ACTIVE);
+        POINT springArrow[3] = {
+            {(int)(drawX + width / 2), (int)(drawY - 12)},
+            {(int)(drawX + width / 2 - 8), (int)(drawY - 4)},
+            {(int)(drawX + width / 2 + 8), (int)(drawY - 4)}
+        };
+        fillpolygon(springArrow, 3);
+
+        // 双箭头效果
+        POINT springArrow2[3] = {
+            {(int)(drawX + width / 2), (int)(drawY - 18)},
+            {(int)(drawX + width / 2 - 6), (int)(drawY - 12)},
+            {(int)(drawX + width / 2 + 6), (int)(drawY - 12)}
+        };
+        fillpolygon(springArrow2, 3);
+
+        // 如果压缩了，添加弹簧激活效果
+        if (springCompression > 0.1f) {
+            // 可以在这里添加更多弹簧效果
+        }
+
+        return;
+    }
+    }
+
+    // 绘制边框高光（对于普通平台）
+    if (type == NORMAL) {
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 1);
+        rectangle((int)drawX, (int)drawY, (int)(drawX + width), (int)(drawY + height));
+    }
+}
+
+// 增强道具绘制效果
+static void drawItem(const Transform& transform, const ItemState& item, float animationTimer,
+    float offsetX, float offsetY) {
+    float itemX = transform.x + offsetX;
+    float itemY = transform.y + offsetY;
+
+    // 道具浮动动画
+    float bounce = std::sin(animationTimer * 4.0f) * 5.0f;
+    itemY += bounce;
+
+    // 旋转效果
+    float rotation = animationTimer * 2.0f;
+
+    switch (item.type) {
+    case DOUBLE_JUMP: {
+        // 二段跳道具 - 双层向上箭头
+        COLORREF doubleJumpColor = Theme::ITEM_DOUBLE_JUMP;
+
+        // 绘制主体 - 圆形
+        setfillcolor(doubleJumpColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(150, 255, 150));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制双层向上箭头
+        setfillcolor(RGB(255, 255, 255));
+
+        // 第一层箭头
+        POINT arrow1[3] = {
+            {(int)itemX, (int)(itemY - 6)},
+            {(int)(itemX - 4), (int)(itemY - 2)},
+            {(int)(itemX + 4), (int)(itemY - 2)}
+        };
+        fillpolygon(arrow1, 3);
+
+        // 第二层箭头
+        POINT arrow2[3] = {
+            {(int)itemX, (int)(itemY + 2)},
+            {(int)(itemX - 4), (int)(itemY + 6)},
+            {(int)(itemX + 4), (int)(itemY + 6)}
+        };
+        fillpolygon(arrow2, 3);
+
+        // 绘制连接线
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        line((int)itemX, (int)(itemY - 2), (int)itemX, (int)(itemY + 2));
+
+        // 绘制外边框
+        setlinecolor(RGB(50, 200, 50));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case SLOW_TIME: {
+        // 时间减缓道具 - 时钟图标
+        COLORREF slowTimeColor = Theme::ITEM_SLOW_TIME;
+
+        // 绘制主体 - 圆形
+        setfillcolor(slowTimeColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(150, 150, 255));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制时钟外圈
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        circle((int)itemX, (int)itemY, 6);
+
+        // 绘制时钟刻度
+        for (int i = 0; i < 12; i++) {
+            float angle = i * 3.14159f / 6;
+            float innerRadius = 4;
+            float outerRadius = 6;
+
+            float innerX = itemX + innerRadius * cos(angle);
+            float innerY = itemY + innerRadius * sin(angle);
+            float outerX = itemX + outerRadius * cos(angle);
+            float outerY = itemY + outerRadius * sin(angle);
+
+            setlinecolor(RGB(255, 255, 255));
+            setlinestyle(PS_SOLID, 1);
+            line((int)innerX, (int)innerY, (int)outerX, (int)outerY);
+        }
+
+        // 绘制时针和分针
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        // 时针
+        line((int)itemX, (int)itemY, (int)(itemX + 3), (int)(itemY - 2));
+        // 分针
+        line((int)itemX, (int)itemY, (int)(itemX + 2), (int)(itemY - 4));
+
+        // 绘制中心点
+        setfillcolor(RGB(255, 255, 255));
+        solidcircle((int)itemX, (int)itemY, 2);
+
+        // 绘制外边框
+        setlinecolor(RGB(50, 50, 200));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case MAGNETIC_FIELD: {
+        // 磁场道具 - 磁铁图标
+        COLORREF magneticColor = Theme::ITEM_MAGNETIC_FIELD;
+
+        // 绘制主体 - 圆形
+        setfillcolor(magneticColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(255, 150, 255));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制磁铁形状
+        setfillcolor(RGB(255, 255, 255));
+        solidrectangle((int)(itemX - 6), (int)(itemY - 6), (int)(itemX + 6), (int)(itemY + 6));
+
+        // 绘制磁铁的N和S极
+        setfillcolor(RGB(255, 0, 0));
+        solidrectangle((int)(itemX - 6), (int)(itemY - 6), (int)(itemX + 6), (int)itemY);
+
+        setfillcolor(RGB(0, 0, 255));
+        solidrectangle((int)(itemX - 6), (int)itemY, (int)(itemX + 6), (int)(itemY + 6));
+
+        // 绘制N和S标记
+        settextcolor(RGB(255, 255, 255));
+        settextstyle(10, 0, L"Arial");
+        outtextxy((int)(itemX - 3), (int)(itemY - 5), L"N");
+        outtextxy((int)(itemX - 3), (int)(itemY + 1), L"S");
+
+        // 绘制磁场线
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 1);
+        for (int i = 0; i < 4; i++) {
+            float angle = i * 3.14159f / 2;
+            float startX = itemX + 8 * cos(angle);
+            float startY = itemY + 8 * sin(angle);
+            float endX = itemX + 12 * cos(angle);
+            float endY = itemY + 12 * sin(angle);
+
+            line((int)startX, (int)startY, (int)endX, (int)endY);
+        }
+
+        // 绘制外边框
+        setlinecolor(RGB(200, 50, 200));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case FREEZE_OBSTACLES: {
+        // 冻结障碍物道具 - 雪花图标
+        COLORREF freezeColor = Theme::ITEM_FREEZE_OBSTACLES;
+
+        // 绘制主体 - 圆形
+        setfillcolor(freezeColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(150, 255, 255));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制雪花主轴
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+
+        // 垂直线
+        line((int)itemX, (int)(itemY - 6), (int)itemX, (int)(itemY + 6));
+        // 水平线
+        line((int)(itemX - 6), (int)itemY, (int)(itemX + 6), (int)itemY);
+        // 对角线1
+        line((int)(itemX - 4), (int)(itemY - 4), (int)(itemX + 4), (int)(itemY + 4));
+        // 对角线2
+        line((int)(itemX - 4), (int)(itemY + 4), (int)(itemX + 4), (int)(itemY - 4));
+
+        // 绘制雪花分支
+        setlinestyle(PS_SOLID, 1);
+        for (int i = 0; i < 8; i++) {
+            float angle = i * 3.14159f / 4;
+            float branchLength = 3;
+            float mainX = itemX + 4 * cos(angle);
+            float mainY = itemY + 4 * sin(angle);
+
+            // 左分支
+            float leftAngle = angle + 0.5f;
+            line((int)mainX, (int)mainY,
+                (int)(mainX + branchLength * cos(leftAngle)),
+                (int)(mainY + branchLength * sin(leftAngle)));
+
+            // 右分支
+            float rightAngle = angle - 0.5f;
+            line((int)mainX, (int)mainY,
+                (int)(mainX + branchLength * cos(rightAngle)),
+                (int)(mainY + branchLength * sin(rightAngle)));
+        }
+
+        // 绘制外边框
+        setlinecolor(RGB(50, 200, 200));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case HEALTH_BOOST: {
+        // 生命值恢复道具 - 红十字
+        COLORREF healthColor = RGB(255, 100, 100);
+
+        // 绘制主体 - 圆形
+        setfillcolor(healthColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(255, 150, 150));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制十字
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 3);
+        line((int)(itemX - 6), (int)itemY, (int)(itemX + 6), (int)itemY);
+        line((int)itemX, (int)(itemY - 6), (int)itemX, (int)(itemY + 6));
+
+        // 绘制外边框
+        setlinecolor(RGB(200, 50, 50));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case INVINCIBILITY: {
+        // 无敌道具 - 金色星星
+        COLORREF invincibilityColor = RGB(255, 215, 0);
+
+        // 绘制主体 - 八角星
+        setfillcolor(invincibilityColor);
+        POINT star[8];
+        for (int i = 0; i < 8; i++) {
+            float angle = i * 3.14159f / 4 + rotation;
+            float radius = (i % 2 == 0) ? 12 : 6;  // 交替长短
+            star[i].x = (int)(itemX + radius * cos(angle));
+            star[i].y = (int)(itemY + radius * sin(angle));
+        }
+        fillpolygon(star, 8);
+
+        // 绘制内部圆形
+        setfillcolor(RGB(255, 255, 150));
+        solidcircle((int)itemX, (int)itemY, 6);
+
+        // 绘制中心点
+        setfillcolor(RGB(255, 255, 255));
+        solidcircle((int)itemX, (int)itemY, 3);
+
+        // 绘制光晕效果（简化版，不调用可能不存在的函数）
+        setfillcolor(RGB(255, 240, 150));
+        solidcircle((int)itemX, (int)itemY, 18);
+        setfillcolor(invincibilityColor);
+        solidcircle((int)itemX, (int)itemY, 12);
+        break;
+    }
+
+    case COIN: {
+        // 金币绘制
+        // 绘制金币外层光晕
+        setfillcolor(RGB(255, 215, 0));
+        solidcircle((int)itemX, (int)itemY, 16);
+
+        // 绘制金币主体
+        setfillcolor(RGB(255, 223, 0));
+        solidcircle((int)itemX, (int)itemY, 12);
+
+        // 绘制金币内层
+        setfillcolor(RGB(255, 255, 100));
+        solidcircle((int)itemX, (int)itemY, 8);
+
+        // 绘制金币中心图案
+        setfillcolor(RGB(255, 215, 0));
+        solidrectangle((int)itemX - 4, (int)itemY - 4, (int)itemX + 4, (int)itemY + 4);
+
+        // 绘制十字纹理
+        setlinecolor(RGB(255, 255, 150));
+        setlinestyle(PS_SOLID, 2);
+        line((int)itemX - 6, (int)itemY, (int)itemX + 6, (int)itemY);
+        line((int)itemX, (int)itemY - 6, (int)itemX, (int)itemY + 6);
+
+        // 绘制边缘装饰
+        setlinecolor(RGB(200, 170, 0));
+        setlinestyle(PS_SOLID, 1);
+        circle((int)itemX, (int)itemY, 12);
+        circle((int)itemX, (int)itemY, 8);
+
+        break;
+    }
+
+    case SPEED_BOOST: {
+        COLORREF itemColor = Theme::ITEM_SPEED;
+
+        // 绘制主体 - 菱形
+        setfillcolor(itemColor);
+        POINT diamond[4] = {
+            {(int)itemX, (int)(itemY - 12)},      // 上
+            {(int)(itemX + 12), (int)itemY},      // 右
+            {(int)itemX, (int)(itemY + 12)},      // 下
+            {(int)(itemX - 12), (int)itemY}       // 左
+        };
+        fillpolygon(diamond, 4);
+
+        // 内部闪电符号
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        line((int)(itemX - 4), (int)(itemY - 6), (int)(itemX + 2), (int)(itemY - 2));
+        line((int)(itemX + 2), (int)(itemY - 2), (int)(itemX - 2), (int)(itemY + 2));
+        line((int)(itemX - 2), (int)(itemY + 2), (int)(itemX + 4), (int)(itemY + 6));
+        break;
+    }
+
+    case SHIELD: {
+        COLORREF itemColor = Theme::ITEM_SHIELD;
+
+        // 绘制主体 - 六边形盾牌
+        setfillcolor(itemColor);
+        POINT shield[6];
+        for (int i = 0; i < 6; i++) {
+            float angle = i * 3.14159f / 3 + rotation;
+            shield[i].x = (int)(itemX + 12 * cos(angle));
+            shield[i].y = (int)(itemY + 12 * sin(angle));
+        }
+        fillpolygon(shield, 6);
+
+        // 内部十字
+        setlinecolor(RGB(255, 255, 255));
+        setlinestyle(PS_SOLID, 2);
+        line((int)(itemX - 6), (int)itemY, (int)(itemX + 6), (int)itemY);
+        line((int)itemX, (int)(itemY - 6), (int)itemX, (int)(itemY + 6));
+        break;
+    }
+
+    default:
+        return;
+    }
+
+    // 移除闪烁效果代码
+    /* 原来的闪烁效果代码已被注释掉：
+    if (((int)(animationTimer * 2.0f)) % 2 == 0) {
+        setfillcolor(RGB(255, 255, 255));
+        solidcircle((int)itemX, (int)itemY, 16);
+    }
+    */
+
+    // 绘制边框
+    setlinecolor(RGB(255, 255, 255));
+    setlinestyle(PS_SOLID, 1);
+    circle((int)itemX, (int)itemY, 14);
+}
+
+static void drawRotatedRect(float centerX, float centerY, float width, float height, float angle, COLORREF color) {
+    // 将角度转换为弧度
+    float rad = angle * 3.14159f / 180.0f;
+
+    // 计算旋转后的四个顶点
+    float halfWidth = width / 2;
+    float halfHeight = height / 2;
+
+    POINT points[4];
+
+    // 原始四个顶点相对于中心点的位置
+    float vertices[4][2] = {
+        {-halfWidth, -halfHeight},  // 左上
+        {halfWidth, -halfHeight},   // 右上
+        {halfWidth, halfHeight},    // 右下
+        {-halfWidth, halfHeight}    // 左下
+    };
+
+    // 应用旋转变换
+    for (int i = 0; i < 4; i++) {
+        float x = vertices[i][0];
+        float y = vertices[i][1];
+
+        points[i].x = (LONG)(centerX + x * cos(rad) - y * sin(rad));
+        points[i].y = (LONG)(centerY + x * sin(rad) + y * cos(rad));
+    }
+
+    // 绘制旋转后的矩形
+    setfillcolor(color);
+    setlinecolor(color);
+    fillpolygon(points, 4);
+}
+
+void ObstacleTraits<SPIKE>::draw(const Obstacle<SPIKE>&, float, float drawX, float drawY) {
+    // 绘制尖刺
+    setfillcolor(RGB(150, 150, 150));
+    solidrectangle((int)drawX, (int)drawY, (int)(drawX + WIDTH), (int)(drawY + HEIGHT));
+    // 绘制尖刺顶部
+    setfillcolor(RGB(200, 50, 50));
+    POINT spikes[3] = {
+        {(int)(drawX + WIDTH / 2), (int)drawY},
+        {(int)drawX, (int)(drawY + HEIGHT / 3)},
+        {(int)(drawX + WIDTH), (int)(drawY + HEIGHT / 3)}
+    };
+    fillpolygon(spikes, 3);
+}
+
+void ObstacleTraits<FIREBALL>::draw(const Obstacle<FIREBALL>&, float, float drawX, float drawY) {
+    // 绘制火球
+    setfillcolor(RGB(255, 100, 0));
+    solidcircle((int)(drawX + WIDTH / 2), (int)(drawY + HEIGHT / 2), (int)(WIDTH / 2));
+    setfillcolor(RGB(255, 150, 0));
+    solidcircle((int)(drawX + WIDTH / 2), (int)(drawY + HEIGHT / 2), (int)(WIDTH / 3));
+}
+
+void ObstacleTraits<LASER>::draw(const Obstacle<LASER>&, float, float drawX, float drawY) {
+    // 绘制激光
+    setfillcolor(RGB(255, 0, 0));
+    solidrectangle((int)drawX, (int)drawY, (int)(drawX + WIDTH), (int)(drawY + HEIGHT));
+}
+
+void ObstacleTraits<ROTATING_SAW>::draw(const Obstacle<ROTATING_SAW>&, float age, float drawX, float drawY) {
+    // 绘制旋转锯
+    drawRotatedRect(drawX + WIDTH / 2, drawY + HEIGHT / 2, WIDTH, HEIGHT,
+        std::fmod(ROTATION_SPEED * age, 360.0f), RGB(180, 180, 180));
+}
+
+void ObstacleTraits<FALLING_ROCK>::draw(const Obstacle<FALLING_ROCK>&, float, float drawX, float drawY) {
+    // 绘制落石
+    setfillcolor(RGB(100, 80, 60));
+    solidcircle((int)(drawX + WIDTH / 2), (int)(drawY + HEIGHT / 2), (int)(WIDTH / 2));
+}
+
+void ObstacleTraits<MOVING_WALL>::draw(const Obstacle<MOVING_WALL>&, float, float drawX, float drawY) {
+    // 绘制移动墙壁
+    setfillcolor(RGB(120, 120, 120));
+    solidrectangle((int)drawX, (int)drawY, (int)(drawX + WIDTH), (int)(drawY + HEIGHT));
+}
+
+static void drawCoin(const Transform& transform, float bob, float offsetX, float offsetY) {
+    float drawX = transform.x + offsetX;
+    float drawY = transform.y + offsetY + bob;
+
+    // 绘制金币外层光晕
+    setfillcolor(RGB(255, 215, 0));
+    solidcircle((int)drawX, (int)drawY, 16);
+
+    // 绘制金币主体
+    setfillcolor(RGB(255, 223, 0));
+    solidcircle((int)drawX, (int)drawY, 12);
+
+    // 绘制金币内层
+    setfillcolor(RGB(255, 255, 100));
+    solidcircle((int)drawX, (int)drawY, 8);
+
+    // 绘制金币中心图案
+    setfillcolor(RGB(255, 215, 0));
+    solidrectangle((int)drawX - 4, (int)drawY - 4, (int)drawX + 4, (int)drawY + 4);
+
+    // 绘制十字纹理
+    setlinecolor(RGB(255, 255, 150));
+    setlinestyle(PS_SOLID, 2);
+    line((int)drawX - 6, (int)drawY, (int)drawX + 6, (int)drawY);
+    line((int)drawX, (int)drawY - 6, (int)drawX, (int)drawY + 6);
+
+    // 绘制边缘装饰
+    setlinecolor(RGB(200, 170, 0));
+    setlinestyle(PS_SOLID, 1);
+    circle((int)drawX, (int)drawY, 12);
+    circle((int)drawX, (int)drawY, 8);
+}
+
+
+void World::drawPlatforms(float offsetX, float offsetY, float minY, float maxY) const {
+    const auto& platforms = registry.pool<PlatformState>();
+    const auto& transforms = registry.pool<Transform>();
+    const auto& bounds = registry.pool<Bounds>();
+    const auto& animations = registry.pool<Animation>();
+    const auto& tracks = registry.pool<PingPong>();
+    const auto& items = registry.pool<ItemState>();
+
+    for (size_t i = 0; i < platforms.size(); i++) {
+        Entity entity = platforms.entityAt(i);
+        const PlatformState& state = platforms.at(i);
+        const Transform& transform = transforms.get(entity);
+        if (state.broken || transform.y <= minY || transform.y >= maxY) continue;
+
+        // 只有屏幕内的平台才求值往返位置
+        const PingPong* track = tracks.tryGet(entity);
+        Transform position = transform;
+        int moveDirection = 1;
+        if (track) {
+            position.x = pingPong(track->minX, track->maxX, track->startX,
+                track->speed * elapsedSince(track->startTime), moveDirection);
+        }
+        drawPlatform(position, bounds.get(entity), state, elapsedSince(animations.get(entity).startTime),
+            track, moveDirection, offsetX, offsetY);
+
+        // 绘制道具
+        if (const ItemState* item = items.tryGet(state.item)) {
+            drawItem(transforms.get(state.item), *item, elapsedSince(animations.get(state.item).startTime), offsetX, offsetY);
+        }
+    }
+}
+
+void World::drawObstacles(float offsetX, float offsetY, float minY, float maxY) const {
+    forEachObstacleType([this, offsetX, offsetY, minY, maxY](auto kind) {
+        typedef typename decltype(kind)::Traits Traits;
+        const auto& obstacles = registry.pool<typename decltype(kind)::Component>();
+        for (size_t i = 0; i < obstacles.size(); i++) {
+            const auto& obstacle = obstacles.at(i);
+            const float age = elapsedSince(obstacle.startTime);
+            const float y = obstacle.y + Traits::offsetY(obstacle, age);
+            if (y <= minY || y >= maxY) continue;
+
+            Traits::draw(obstacle, age, Traits::positionX(obstacle, age) + offsetX, y + offsetY);
+        }
+    });
+}
+
+void World::drawCoins(float offsetX, float offsetY, float minY, float maxY) const {
+    const auto& coins = registry.pool<CoinState>();
+    const auto& transforms = registry.pool<Transform>();
+    const auto& animations = registry.pool<Animation>();
+
+    for (size_t i = 0; i < coins.size(); i++) {
+        Entity entity = coins.entityAt(i);
+        const Transform& transform = transforms.get(entity);
+        if (transform.y <= minY || transform.y >= maxY) continue;
+
+        const Animation& animation = animations.get(entity);
+        drawCoin(transform, bobOffset(animation, elapsedSince(animation.startTime)), offsetX, offsetY);
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "World.h"
+#include "Random.h"
+#include <cmath>
+
+// World内部的运动规则，World.cpp（模拟）和WorldDraw.cpp（绘制）共用。
+// 都是按经过时间求值的闭式，不依赖图形库
+
+// ---- 往返运动 ----
+
+// 三角波：从start出发先向maxX方向移动distance后的位置，direction写入当前的移动方向（1或-1）
+inline float pingPong(float minX, float maxX, float start, float distance, int& direction) {
+    const float length = maxX - minX;
+    float phase = std::fmod(start - minX + distance, 2.0f * length);
+    if (phase < 0.0f) phase += 2.0f * length;
+
+    direction = phase < length ? 1 : -1;
+    return phase < length ? minX + phase : maxX - (phase - length);
+}
+
+// 金币上下浮动的偏移
+inline float bobOffset(const Animation& animation, float elapsed) {
+    return sin(elapsed * 3.0f) * animation.bobAmplitude;
+}
+
+// ---- 障碍物类型 ----
+
+// 各类障碍物的固定参数和运动规则：系统按类型分别实例化，遍历一个池时不再逐个判断类型。
+// 运动都是生成后经过时间age的闭式：positionX为当前的x，offsetY为相对（随世界下移的）生成高度的下落量
+// draw在WorldDraw.cpp中定义，无界面的构建不链接绘制代码
+template <ObstacleType Type>
+struct ObstacleTraits;
+
+// 默认：静止，随世界下移，寿命30秒
+struct StaticObstacle {
+    static constexpr bool SCROLLS = true;
+    static constexpr float LIFETIME = 30.0f;
+
+    template <typename T> static void init(T&) {}
+    template <typename T> static float positionX(const T& obstacle, float) { return obstacle.x; }
+    template <typename T> static float offsetY(const T&, float) { return 0.0f; }
+    template <typename T> static void velocity(const T&, float, float& vx, float& vy, float& gravity) {
+        vx = 0.0f;
+        vy = 0.0f;
+        gravity = 0.0f;
+    }
+};
+
+template <>
+struct ObstacleTraits<SPIKE> : StaticObstacle {
+    static constexpr float WIDTH = 20.0f, HEIGHT = 40.0f;
+    static constexpr int DAMAGE = 1;
+
+    static void draw(const Obstacle<SPIKE>& obstacle, float age, float drawX, float drawY);
+};
+
+template <>
+struct ObstacleTraits<FIREBALL> : StaticObstacle {
+    static constexpr float WIDTH = 30.0f, HEIGHT = 30.0f;
+    static constexpr int DAMAGE = 2;
+    static constexpr float LIFETIME = 10.0f;
+    static constexpr float FALL_SPEED = 200.0f;
+
+    static float offsetY(const Obstacle<FIREBALL>&, float age) { return FALL_SPEED * age; }
+    static void velocity(const Obstacle<FIREBALL>&, float, float& vx, float& vy, float& gravity) {
+        vx = 0.0f;
+        vy = FALL_SPEED;
+        gravity = 0.0f;
+    }
+    static void draw(const Obstacle<FIREBALL>& obstacle, float age, float drawX, float drawY);
+};
+
+template <>
+struct ObstacleTraits<LASER> : StaticObstacle {
+    static constexpr float WIDTH = 100.0f, HEIGHT = 8.0f;
+    static constexpr int DAMAGE = 3;
+    static constexpr float SPEED = 150.0f;
+
+    // 整个激光移出窗口一侧后折返
+    static float positionX(const Obstacle<LASER>& obstacle, float age) {
+        int direction;
+        return pingPong(-WIDTH, World::LASER_TRACK_WIDTH + WIDTH, obstacle.x, SPEED * age, direction);
+    }
+    static void velocity(const Obstacle<LASER>& obstacle, float age, float& vx, float& vy, float& gravity) {
+        int direction;
+        pingPong(-WIDTH, World::LASER_TRACK_WIDTH + WIDTH, obstacle.x, SPEED * age, direction);
+        vx = SPEED * direction;
+        vy = 0.0f;
+        gravity = 0.0f;
+    }
+    static void draw(const Obstacle<LASER>& obstacle, float age, float drawX, float drawY);
+};
+
+template <>
+struct ObstacleTraits<ROTATING_SAW> : StaticObstacle {
+    static constexpr float WIDTH = 40.0f, HEIGHT = 40.0f;
+    static constexpr int DAMAGE = 2;
+    static constexpr float ROTATION_SPEED = 360.0f;    // 每秒旋转角度，只影响绘制
+
+    static void draw(const Obstacle<ROTATING_SAW>& obstacle, float age, float drawX, float drawY);
+};
+
+template <>
+struct ObstacleTraits<FALLING_ROCK> : StaticObstacle {
+    static constexpr float WIDTH = 25.0f, HEIGHT = 25.0f;
+    static constexpr int DAMAGE = 1;
+    static constexpr float GRAVITY = 200.0f;
+
+    static void init(Obstacle<FALLING_ROCK>& obstacle) { obstacle.vy = 100.0f + Random::next() % 100; }  // 随机下降速度
+    static float offsetY(const Obstacle<FALLING_ROCK>& obstacle, float age) {
+        return (obstacle.vy + 0.5f * GRAVITY * age) * age;
+    }
+    static void velocity(const Obstacle<FALLING_ROCK>& obstacle, float age, float& vx, float& vy, float& gravity) {
+        vx = 0.0f;
+        vy = obstacle.vy + GRAVITY * age;
+        gravity = GRAVITY;
+    }
+    static void draw(const Obstacle<FALLING_ROCK>& obstacle, float age, float drawX, float drawY);
+};
+
+template <>
+struct ObstacleTraits<MOVING_WALL> : StaticObstacle {
+    static constexpr float WIDTH = 20.0f, HEIGHT = 100.0f;
+    static constexpr int DAMAGE = 1;
+    static constexpr bool SCROLLS = false;     // 保持在生成高度
+    static constexpr float SPEED = 80.0f;
+
+    static float positionX(const Obstacle<MOVING_WALL>& obstacle, float age) { return obstacle.x + SPEED * age; }
+    static void velocity(const Obstacle<MOVING_WALL>&, float, float& vx, float& vy, float& gravity) {
+        vx = SPEED;
+        vy = 0.0f;
+        gravity = 0.0f;
+    }
+    static void draw(const Obstacle<MOVING_WALL>& obstacle, float age, float drawX, float drawY);
+};
+
+template <ObstacleType Type>
+struct ObstacleKind {
+    static constexpr ObstacleType type = Type;
+    typedef Obstacle<Type> Component;
+    typedef ObstacleTraits<Type> Traits;
+};
+
+// 依次以每种类型调用visit(ObstacleKind<Type>())，visit一般是泛型lambda
+template <typename Visit>
+void forEachObstacleType(const Visit& visit) {
+    visit(ObstacleKind<SPIKE>());
+    visit(ObstacleKind<FIREBALL>());
+    visit(ObstacleKind<LASER>());
+    visit(ObstacleKind<ROTATING_SAW>());
+    visit(ObstacleKind<FALLING_ROCK>());
+    visit(ObstacleKind<MOVING_WALL>());
+}
@@ -0,0 +1,484 @@
+#include "Benchmark.h"
+#include "Game.h"
+#include "SnapshotRing.h"
+#include "MemoryStats.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+#ifdef _WIN32
+#include "DrawUtils.h"
+#endif
+
+// 固定步长：60Hz
+static const float BENCH_DT = 1.0f / 60.0f;
+static const unsigned int BENCH_SEED = 20240601;
+
+// 稳态帧：每局开始10秒之后。此前组件池、粒子列表、待销毁列表等的容量还在增长
+static const int STEADY_WARMUP_TICKS = 600;
+// 宏基准中稳态帧的分配统计，所有标签都计入（分块生成与拼接也从块池取用，不再例外），
+// --assert-no-alloc时有分配的帧即为失败
+struct SteadyAllocations {
+    long long frames = 0;
+    long long allocatingFrames = 0;
+    long long worstFrame = 0;
+    long long byTag[MEM_TAG_COUNT] = {};
+
+    void record(const MemoryFrame& frame) {
+        frames++;
+
+        long long count = frame.count();
+        if (count == 0) return;
+        allocatingFrames++;
+        worstFrame = std::max(worstFrame, count);
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            byTag[i] += frame.allocations[i];
+        }
+    }
+
+    void write(std::ostream& out) const {
+        out << "steady-state frames: " << frames << ", allocating: " << allocatingFrames
+            << ", worst frame: " << worstFrame << " allocations\n";
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            if (byTag[i] > 0) {
+                out << "  " << MemoryStats::tagName(static_cast<MemoryTag>(i)) << ": " << byTag[i] << "\n";
+            }
+        }
+    }
+};
+static SteadyAllocations steadyAllocations;
+
+// 构造一条由count个随机平台组成的竖直平台带
+static void fillPlatforms(Game& game, int count) {
+    World& world = game.getWorld();
+    world.clear();
+
+    PlatformGenerator& generator = game.getPlatformGenerator();
+    float y = WINDOW_HEIGHT - 40.0f;
+    for (int i = 0; i < count; i++) {
+        y -= 80 + rand() % 60;
+        world.spawnPlatform(generator.generateRandomPlatform(y, 0.5f));
+    }
+}
+
+// 在玩家周围随机散布count个金币
+static void fillCoins(Game& game, int count, float centerX, float centerY, float radius) {
+    World& world = game.getWorld();
+    world.clear();
+    for (int i = 0; i < count; i++) {
+        float dx = (rand() % 2001 - 1000) / 1000.0f * radius;
+        float dy = (rand() % 2001 - 1000) / 1000.0f * radius;
+        world.spawnCoin(centerX + dx, centerY + dy, 10);
+    }
+}
+
+static void registerMicroBenchmarks(BenchmarkRunner& runner, Game& game) {
+    // Game::checkCollisions —— 玩家不与任何平台接触，需要遍历全部平台
+    for (int count : { 64, 1024 }) {
+        runner.add("checkCollisions/miss/" + std::to_string(count), "micro",
+            [&game, count](long long iterations) {
+                fillPlatforms(game, count);
+                game.getPlayer().setPosition(-500.0f, 10000.0f);
+                for (long long i = 0; i < iterations; i++) {
+                    game.checkCollisions();
+                }
+                return iterations * count;
+            });
+    }
+
+    // World::animate + World::move —— 平台的动画、弹簧回弹和移动平台往返
+    runner.add("World::animate+move/1024", "micro", [&game](long long iterations) {
+        fillPlatforms(game, 1024);
+        World& world = game.getWorld();
+        for (long long i = 0; i < iterations; i++) {
+            world.animate(BENCH_DT);
+            world.move(BENCH_DT);
+        }
+        return iterations * (long long)world.getPlatformCount();
+        });
+
+    // Game::updateWorldMovement —— 世界速度计算，所有Scroll实体随世界下移
+    runner.add("Game::updateWorldMovement/1024", "micro", [&game](long long iterations) {
+        fillPlatforms(game, 1024);
+        for (long long i = 0; i < iterations; i++) {
+            game.updateWorldMovement(BENCH_DT);
+        }
+        return iterations * (long long)game.getWorld().getPlatformCount();
+        });
+
+    // World::collectCoins —— 磁铁吸附加拾取判定；正负交替的步长让金币在原位附近往返，避免全部收敛到玩家中心，
+    // 拾取的金币只报告不销毁
+    runner.add("World::collectCoins/1024", "micro", [&game](long long iterations) {
+        const float playerX = WINDOW_WIDTH / 2.0f;
+        const float playerY = WINDOW_HEIGHT / 2.0f;
+        fillCoins(game, 1024, playerX, playerY, 200.0f);
+        World& world = game.getWorld();
+        const CoinCollector collector = { playerX - 20.0f, playerY - 30.0f, 40.0f, 60.0f, 150.0f };
+        std::vector<CoinPickup> pickups;
+        pickups.reserve(World::ENTITY_CAPACITY);
+        for (long long i = 0; i < iterations; i++) {
+            float dt = (i & 1) ? -BENCH_DT : BENCH_DT;
+            world.collectCoins(&collector, 1, dt, pickups);
+        }
+        return iterations * (long long)world.getCoinCount();
+        });
+
+    // Player::updateParticles —— 每帧产生一次跳跃粒子，稳定在约500个粒子
+    runner.add("Player::updateParticles", "micro", [&game](long long iterations) {
+        Player& player = game.getPlayer();
+        player.reset();
+        long long processed = 0;
+        for (long long i = 0; i < iterations; i++) {
+            player.createJumpParticles();
+            processed += (long long)player.getParticleCount();
+            player.updateParticles(BENCH_DT);
+        }
+        return processed;
+        });
+
+    // 平台生成
+    runner.add("PlatformGenerator::generateRandomPlatform", "micro", [&game](long long iterations) {
+        PlatformGenerator& generator = game.getPlatformGenerator();
+        std::vector<Platform> generated;
+        generated.reserve(1024);
+        for (long long i = 0; i < iterations; i++) {
+            if (generated.size() == 1024) generated.clear();
+            generated.push_back(generator.generateRandomPlatform(-(float)(i % 1024) * 100.0f, 0.5f));
+        }
+        return iterations;
+        });
+}
+
+#ifdef _WIN32
+static void registerDrawBenchmarks(BenchmarkRunner& runner, IMAGE& canvas) {
+    // 所有绘制都写入离屏IMAGE（EasyX软件光栅化），不需要窗口；EasyX只有Windows版，其他平台不注册这一组
+    runner.add("DrawUtils::drawRoundedRect", "micro", [&canvas](long long iterations) {
+        SetWorkingImage(&canvas);
+        for (long long i = 0; i < iterations; i++) {
+            DrawUtils::drawRoundedRect((int)(i % 1000), 200, 150, 40, 8, Theme::PRIMARY, Theme::BORDER);
+        }
+        SetWorkingImage();
+        return iterations;
+        });
+
+    runner.add("DrawUtils::drawSoftShadowRect", "micro", [&canvas](long long iterations) {
+        SetWorkingImage(&canvas);
+        for (long long i = 0; i < iterations; i++) {
+            DrawUtils::drawSoftShadowRect((int)(i % 1000), 300, 200, 50, 10, Theme::PRIMARY, 3);
+        }
+        SetWorkingImage();
+        return iterations;
+        });
+
+    runner.add("DrawUtils::drawGlowCircle", "micro", [&canvas](long long iterations) {
+        SetWorkingImage(&canvas);
+        for (long long i = 0; i < iterations; i++) {
+            DrawUtils::drawGlowCircle((int)(i % 1000), 400, 30, Theme::SHIELD_GLOW, 0.5f);
+        }
+        SetWorkingImage();
+        return iterations;
+        });
+
+    runner.add("DrawUtils::drawParticle", "micro", [&canvas](long long iterations) {
+        SetWorkingImage(&canvas);
+        for (long long i = 0; i < iterations; i++) {
+            DrawUtils::drawParticle((float)(i % 1000), 500.0f, 3.0f, Theme::PARTICLE_JUMP, 0.8f);
+        }
+        SetWorkingImage();
+        return iterations;
+        });
+
+    runner.add("DrawUtils::drawSparkle", "micro", [&canvas](long long iterations) {
+        SetWorkingImage(&canvas);
+        for (long long i = 0; i < iterations; i++) {
+            DrawUtils::drawSparkle((float)(i % 1000), 600.0f, 6.0f, Theme::ITEM_SHIELD_PARTICLE, (float)i);
+        }
+        SetWorkingImage();
+        return iterations;
+        });
+}
+#endif
+
+// 宏基准：以固定步长模拟minutes分钟的游戏，玩家按简单脚本跳跃和左右移动，死亡后立即重开
+// 每帧结束时取出本帧的分配，每局开始STEADY_WARMUP_TICKS帧之后计入稳态统计
+static void registerMacroBenchmarks(BenchmarkRunner& runner, Game& game, int minutes) {
+    runner.add("simulate/" + std::to_string(minutes) + "min", "macro", [&game, minutes](long long iterations) {
+        long long ticks = (long long)minutes * 60 * 60;
+        long long processed = 0;
+
+        for (long long run = 0; run < iterations; run++) {
+            game.startHeadlessRun();
+            MemoryStats::endFrame();
+            int runTicks = 0;
+            for (long long tick = 0; tick < ticks; tick++) {
+                Player& player = game.getPlayer();
+                if (tick % 30 == 0) {
+                    player.jump();
+                }
+                if ((tick / 120) % 2 == 0) {
+                    player.moveRight();
+                }
+                else {
+                    player.moveLeft();
+                }
+
+                game.updateGame(BENCH_DT);
+                processed++;
+
+                MemoryFrame frame = MemoryStats::endFrame();
+                if (++runTicks > STEADY_WARMUP_TICKS) {
+                    steadyAllocations.record(frame);
+                }
+
+                if (game.getState() == GAME_OVER) {
+                    game.startHeadlessRun();
+                    MemoryStats::endFrame();
+                    runTicks = 0;
+                }
+            }
+        }
+        return processed;
+        }, 1);
+
+    // 持续上升：玩家每帧以每秒300像素的速度向上穿过平台，镜头跟随，每两三秒拼接一个分块，稳态帧覆盖分块的生成与拼接
+    runner.add("simulate/climb/" + std::to_string(minutes) + "min", "macro", [&game, minutes](long long iterations) {
+        long long ticks = (long long)minutes * 60 * 60;
+        long long processed = 0;
+
+        for (long long run = 0; run < iterations; run++) {
+            game.startHeadlessRun();
+            MemoryStats::endFrame();
+            int runTicks = 0;
+            for (long long tick = 0; tick < ticks; tick++) {
+                Player& player = game.getPlayer();
+                player.setVY(-300.0f);
+
+                game.updateGame(BENCH_DT);
+                processed++;
+
+                MemoryFrame frame = MemoryStats::endFrame();
+                if (++runTicks > STEADY_WARMUP_TICKS) {
+                    steadyAllocations.record(frame);
+                }
+
+                if (game.getState() == GAME_OVER) {
+                    game.startHeadlessRun();
+                    MemoryStats::endFrame();
+                    runTicks = 0;
+                }
+            }
+        }
+        return processed;
+        }, 1);
+
+    // 实体多于PARALLEL_GRAIN的场景：1024个平台和1024个金币，每帧经过并行的滚动、过期判定、碰撞查询、金币磁吸和粒子更新。
+    // 滚动和磁吸的步长正负交替，实体留在原位附近；预热之后的帧同样计入稳态统计，覆盖parallelFor分给任务池的路径
+    runner.add("simulate/crowd/1024", "macro", [&game](long long iterations) {
+        const int frames = 3000;
+        const float playerX = WINDOW_WIDTH / 2.0f;
+        const float playerY = WINDOW_HEIGHT / 2.0f;
+        const CoinCollector collector = { playerX - 20.0f, playerY - 30.0f, 40.0f, 60.0f, 150.0f };
+        std::vector<CoinPickup> pickups;
+        pickups.reserve(World::ENTITY_CAPACITY);
+        long long processed = 0;
+
+        for (long long run = 0; run < iterations; run++) {
+            game.startHeadlessRun();
+            fillPlatforms(game, 1024);
+            World& world = game.getWorld();
+            for (int i = 0; i < 1024; i++) {
+                float dx = (rand() % 2001 - 1000) / 1000.0f * 200.0f;
+                float dy = (rand() % 2001 - 1000) / 1000.0f * 200.0f;
+                world.spawnCoin(playerX + dx, playerY + dy, 10);
+            }
+            Player& player = game.getPlayer();
+            player.setPosition(-500.0f, 10000.0f);
+            MemoryStats::endFrame();
+
+            for (int frame = 0; frame < frames; frame++) {
+                float dt = (frame & 1) ? -BENCH_DT : BENCH_DT;
+                world.scroll(dt * 100.0f);
+                world.expire(1e9f);
+                game.checkCollisions();
+                world.collectCoins(&collector, 1, dt, pickups);
+                player.createJumpParticles();
+                player.updateParticles(BENCH_DT);
+                processed += (long long)(world.getPlatformCount() + world.getCoinCount());
+
+                MemoryFrame memory = MemoryStats::endFrame();
+                if (frame >= STEADY_WARMUP_TICKS) {
+                    steadyAllocations.record(memory);
+                }
+            }
+        }
+        return processed;
+        }, 1);
+}
+
+// 联机对局先模拟10秒，让世界中有足够的平台、障碍物和金币
+static void startNetGame(Game& game) {
+    game.startNetRun(2, 0, BENCH_SEED);
+    for (int tick = 0; tick < 600; tick++) {
+        game.updateGame(BENCH_DT);
+    }
+}
+
+// 快照与回滚：tick与tick+save之差为每帧保存一个快照的开销；
+// rollback/8frames与NetSession相同，逐帧存入10帧的环形缓冲，恢复8帧前的快照后重算，一次操作须远小于一帧的16ms
+static void registerNetplayBenchmarks(BenchmarkRunner& runner, Game& game) {
+    static SnapshotRing ring(10);
+
+    runner.add("snapshot/tick", "micro", [&game](long long iterations) {
+        startNetGame(game);
+        for (long long i = 0; i < iterations; i++) {
+            if (game.getState() != PLAYING) {
+                game.startNetRun(2, 0, BENCH_SEED);
+            }
+            game.updateGame(BENCH_DT);
+        }
+        return iterations;
+        });
+
+    runner.add("snapshot/tick+save", "micro", [&game](long long iterations) {
+        startNetGame(game);
+        ring.clear();
+        for (long long i = 0; i < iterations; i++) {
+            if (game.getState() != PLAYING) {
+                game.startNetRun(2, 0, BENCH_SEED);
+            }
+            ring.save(game, (std::uint32_t)i);
+            game.updateGame(BENCH_DT);
+        }
+        return iterations;
+        });
+
+    runner.add("snapshot/restore", "micro", [&game](long long iterations) {
+        startNetGame(game);
+        ring.clear();
+        for (std::uint32_t tick = 0; tick < 9; tick++) {
+            ring.save(game, tick);
+            game.updateGame(BENCH_DT);
+        }
+        // 交替恢复相隔8帧的两个快照，每次都要复制变化过的组件池
+        for (long long i = 0; i < iterations; i++) {
+            ring.load(game, (i & 1) ? 8 : 0);
+        }
+        return iterations;
+        });
+
+    runner.add("rollback/8frames", "macro", [&game](long long iterations) {
+        const std::uint32_t frames = 8;
+        std::uint32_t tick = 0;
+
+        startNetGame(game);
+        ring.clear();
+        for (long long i = 0; i < iterations; i++) {
+            if (game.getState() != PLAYING) {
+                game.startNetRun(2, 0, BENCH_SEED);
+                ring.clear();
+            }
+
+            std::uint32_t from = tick;
+            for (std::uint32_t frame = 0; frame < frames; frame++) {
+                ring.save(game, tick++);
+                game.updateGame(BENCH_DT);
+            }
+
+            // 远端输入与预测不同：恢复后重算，重算过程中照常保存快照
+            ring.load(game, from);
+            for (std::uint32_t t = from; t < tick; t++) {
+                if (t != from) {
+                    ring.save(game, t);
+                }
+                game.getPlayer(1).jump();
+                game.updateGame(BENCH_DT);
+            }
+        }
+        return iterations;
+        });
+}
+
+static void printUsage() {
+    std::cerr << "usage: jumping_bench [--filter <substr>] [--out <file.json>] [--tag <commit>]\n"
+        << "                     [--minutes <n>] [--min-time <seconds>] [--threads <n>] [--assert-no-alloc]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string outPath;
+    std::string tag = "local";
+    int minutes = 5;
+    double minTime = 0.2;
+    bool assertNoAlloc = false;     // 宏基准的稳态帧有分配时返回非零
+    int threads = 0;                // 参与并行系统的线程数（含主线程），0为硬件线程数
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue) filter = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) outPath = argv[++i];
+        else if (strcmp(argv[i], "--tag") == 0 && hasValue) tag = argv[++i];
+        else if (strcmp(argv[i], "--minutes") == 0 && hasValue) minutes = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue) minTime = atof(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--assert-no-alloc") == 0) assertNoAlloc = true;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // 硬件计数器只统计主线程，--threads 1时并行系统的全部分段都在主线程执行
+    if (threads > 0) {
+        JobSystem::setWorkerCount(threads - 1);
+    }
+
+    Game game(true, BENCH_SEED);
+    Game netGame(true, BENCH_SEED);
+
+    BenchmarkRunner runner(minTime);
+    registerMicroBenchmarks(runner, game);
+#ifdef _WIN32
+    IMAGE canvas(WINDOW_WIDTH, WINDOW_HEIGHT);
+    registerDrawBenchmarks(runner, canvas);
+#endif
+    registerMacroBenchmarks(runner, game, minutes);
+    registerNetplayBenchmarks(runner, netGame);
+
+    std::cerr << "hardware counters:";
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if ((runner.getAvailableCounters() >> e) & 1u) {
+            std::cerr << " " << PerfCounters::eventName(static_cast<PerfEvent>(e));
+        }
+    }
+    std::cerr << (runner.getAvailableCounters() == 0 ? " unavailable\n" : "\n");
+
+    runner.run(filter);
+
+    // 人类可读的表格输出到stderr，JSON输出到文件或stdout
+    runner.writeTable(std::cerr);
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        runner.writeJson(out, tag);
+    }
+    else {
+        runner.writeJson(std::cout, tag);
+    }
+
+    if (steadyAllocations.frames > 0) {
+        steadyAllocations.write(std::cerr);
+        int timerGrows = 0;
+        for (int layer = 0; layer < TIME_LAYER_COUNT; layer++) {
+            timerGrows += game.getClock().getTimers((TimeLayer)layer).getGrowCount();
+        }
+        std::cerr << "timer wheel grows: " << timerGrows << ", chunk pool grows: " << ChunkPool::getInstance().getGrowCount() << "\n";
+    }
+    if (assertNoAlloc) {
+        MemoryStats::writeReport(std::cerr);
+        if (steadyAllocations.frames == 0 || steadyAllocations.allocatingFrames > 0) {
+            std::cerr << "FAILED: steady-state frames allocated (or no simulate benchmark ran)\n";
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "Benchmark.h"
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+
+BenchmarkRunner::BenchmarkRunner(double minSeconds)
+    : minSeconds(minSeconds) {
+}
+
+void BenchmarkRunner::add(const std::string& name, const std::string& group, BenchmarkFunc func,
+    long long fixedIterations) {
+    entries.push_back({ name, group, func, fixedIterations });
+}
+
+BenchmarkResult BenchmarkRunner::measure(const Entry& entry) {
+    long long iterations = entry.fixedIterations > 0 ? entry.fixedIterations : 1;
+    long long items = 0;
+    double seconds = 0.0;
+    PerfSample sample;
+
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        counters.start();
+        items = entry.func(iterations);
+        sample = counters.stop();
+        auto end = std::chrono::steady_clock::now();
+        seconds = std::chrono::duration<double>(end - start).count();
+
+        // 宏基准只运行一次；微基准扩展次数直到达到最短测量时间
+        if (entry.fixedIterations > 0 || seconds >= minSeconds) {
+            break;
+        }
+
+        // 按已测耗时估算所需次数，每轮最多扩大10倍
+        double scale = seconds > 0.0 ? (minSeconds * 1.2) / seconds : 10.0;
+        scale = std::max(2.0, std::min(scale, 10.0));
+        iterations = (long long)(iterations * scale);
+    }
+
+    BenchmarkResult result;
+    result.name = entry.name;
+    result.group = entry.group;
+    result.iterations = iterations;
+    result.itemsProcessed = items;
+    result.totalSeconds = seconds;
+    result.nsPerIteration = seconds * 1e9 / iterations;
+    result.itemsPerSecond = seconds > 0.0 ? items / seconds : 0.0;
+    result.counters = sample;
+    return result;
+}
+
+void BenchmarkRunner::run(const std::string& filter) {
+    results.clear();
+    for (const auto& entry : entries) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(measure(entry));
+    }
+}
+
+void BenchmarkRunner::writeJson(std::ostream& out, const std::string& tag) const {
+    out << "{\n  \"tag\": \"" << tag << "\",\n  \"benchmarks\": [\n";
+    out << std::setprecision(6) << std::fixed;
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"group\": \"" << r.group
+            << "\", \"iterations\": " << r.iterations
+            << ", \"items\": " << r.itemsProcessed
+            << ", \"seconds\": " << r.totalSeconds
+            << ", \"ns_per_iter\": " << r.nsPerIteration
+            << ", \"items_per_sec\": " << r.itemsPerSecond;
+
+        // 硬件计数按处理的实体数平均，不可用的计数器不输出
+        if (r.counters.available != 0 && r.itemsProcessed > 0) {
+            out << ", \"counters\": {";
+            const char* separator = "";
+            for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+                PerfEvent event = static_cast<PerfEvent>(e);
+                if (!r.counters.has(event)) continue;
+                out << separator << "\"" << PerfCounters::eventName(event) << "_per_item\": "
+                    << (double)r.counters.values[e] / r.itemsProcessed;
+                separator = ", ";
+            }
+            if (r.counters.has(PERF_CYCLES) && r.counters.has(PERF_INSTRUCTIONS) && r.counters.values[PERF_CYCLES] > 0) {
+                out << separator << "\"ipc\": " << (double)r.counters.values[PERF_INSTRUCTIONS] / r.counters.values[PERF_CYCLES];
+            }
+            out << "}";
+        }
+        out << "}";
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// 每个实体的计数，计数器不可用时输出"-"
+static void writeCounterColumn(std::ostream& out, const BenchmarkResult& r, PerfEvent event, int width) {
+    out << std::setw(width);
+    if (r.counters.has(event) && r.itemsProcessed > 0) {
+        out << std::setprecision(2) << std::fixed << (double)r.counters.values[event] / r.itemsProcessed;
+    }
+    else {
+        out << "-";
+    }
+}
+
+void BenchmarkRunner::writeTable(std::ostream& out) const {
+    bool showCounters = counters.getAvailable() != 0;
+
+    out << std::left << std::setw(40) << "benchmark"
+        << std::right << std::setw(14) << "iterations"
+        << std::setw(16) << "ns/iter"
+        << std::setw(18) << "items/s";
+    if (showCounters) {
+        out << std::setw(12) << "cyc/item" << std::setw(8) << "IPC" << std::setw(12) << "L1D/item"
+            << std::setw(12) << "LLC/item" << std::setw(12) << "brmis/item";
+    }
+    out << "\n";
+
+    for (const auto& r : results) {
+        out << std::left << std::setw(40) << r.name
+            << std::right << std::setw(14) << r.iterations
+            << std::setw(16) << std::setprecision(1) << std::fixed << r.nsPerIteration
+            << std::setw(18) << std::setprecision(0) << r.itemsPerSecond;
+        if (showCounters) {
+            writeCounterColumn(out, r, PERF_CYCLES, 12);
+            out << std::setw(8);
+            if (r.counters.has(PERF_CYCLES) && r.counters.has(PERF_INSTRUCTIONS) && r.counters.values[PERF_CYCLES] > 0) {
+                out << std::setprecision(2) << (double)r.counters.values[PERF_INSTRUCTIONS] / r.counters.values[PERF_CYCLES];
+            }
+            else {
+                out << "-";
+            }
+            writeCounterColumn(out, r, PERF_L1D_MISSES, 12);
+            writeCounterColumn(out, r, PERF_LLC_MISSES, 12);
+            writeCounterColumn(out, r, PERF_BRANCH_MISSES, 12);
+        }
+        out << "\n";
+    }
+}
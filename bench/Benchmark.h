@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include "PerfCounters.h"
+
+// 单个基准测试的结果
+struct BenchmarkResult {
+    std::string name;
+    std::string group;          // micro: 单个函数 / macro: 整局模拟
+    long long iterations;       // 执行次数
+    long long itemsProcessed;   // 处理的实体数量（平台、金币、粒子、帧等）
+    double totalSeconds;        // 总耗时
+    double nsPerIteration;      // 每次执行耗时（纳秒）
+    double itemsPerSecond;      // 吞吐量
+    PerfSample counters;        // 最后一轮测量的硬件计数，除以itemsProcessed即每个实体的开销
+};
+
+// 基准测试函数：执行iterations次操作，返回处理的实体总数
+using BenchmarkFunc = std::function<long long(long long iterations)>;
+
+// 基准测试运行器
+class BenchmarkRunner {
+private:
+    struct Entry {
+        std::string name;
+        std::string group;
+        BenchmarkFunc func;
+        long long fixedIterations;  // 大于0时不自动扩展次数（用于宏基准）
+    };
+
+    std::vector<Entry> entries;
+    std::vector<BenchmarkResult> results;
+    double minSeconds;          // 每个微基准的最短测量时间
+    PerfCounters counters;
+
+    BenchmarkResult measure(const Entry& entry);
+
+public:
+    explicit BenchmarkRunner(double minSeconds = 0.2);
+
+    void add(const std::string& name, const std::string& group, BenchmarkFunc func,
+        long long fixedIterations = 0);
+
+    // 运行名称中包含filter的基准测试（filter为空时全部运行）
+    void run(const std::string& filter);
+
+    // 输出结果
+    void writeJson(std::ostream& out, const std::string& tag) const;
+    void writeTable(std::ostream& out) const;
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+    unsigned int getAvailableCounters() const { return counters.getAvailable(); }
+};
@@ -0,0 +1,121 @@
+#include "PerfCounters.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace {
+#if defined(__linux__)
+    struct EventConfig {
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    // 与PerfEvent顺序一致
+    const EventConfig EVENT_CONFIGS[PERF_EVENT_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    };
+
+    // 只统计本线程的用户态：perf_event_paranoid为2时也能打开
+    int openEvent(const EventConfig& event) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+}
+
+PerfCounters::PerfCounters() : available(0), startCycles(0) {
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        descriptors[i] = -1;
+    }
+
+#if defined(_WIN32)
+    available = 1u << PERF_CYCLES;
+#elif defined(__linux__)
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        descriptors[i] = openEvent(EVENT_CONFIGS[i]);
+        if (descriptors[i] >= 0) available |= 1u << i;
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (descriptors[i] >= 0) close(descriptors[i]);
+    }
+#endif
+}
+
+const char* PerfCounters::eventName(PerfEvent event) {
+    switch (event) {
+    case PERF_CYCLES: return "cycles";
+    case PERF_INSTRUCTIONS: return "instructions";
+    case PERF_L1D_MISSES: return "l1d_misses";
+    case PERF_LLC_MISSES: return "llc_misses";
+    case PERF_BRANCH_MISSES: return "branch_misses";
+    default: return "?";
+    }
+}
+
+void PerfCounters::start() {
+#if defined(_WIN32)
+    ULONG64 cycles = 0;
+    QueryThreadCycleTime(GetCurrentThread(), &cycles);
+    startCycles = cycles;
+#elif defined(__linux__)
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (descriptors[i] < 0) continue;
+        ioctl(descriptors[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+
+#if defined(_WIN32)
+    ULONG64 cycles = 0;
+    QueryThreadCycleTime(GetCurrentThread(), &cycles);
+    sample.values[PERF_CYCLES] = cycles - startCycles;
+    sample.available = available;
+#elif defined(__linux__)
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (descriptors[i] >= 0) ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (descriptors[i] < 0) continue;
+
+        // value, time_enabled, time_running
+        std::uint64_t data[3];
+        if (read(descriptors[i], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0) {
+            continue;   // 打开了但没有排上计数（硬件计数器被占满），本次不输出
+        }
+        double scale = data[2] < data[1] ? (double)data[1] / data[2] : 1.0;
+        sample.values[i] = (std::uint64_t)(data[0] * scale);
+        sample.available |= 1u << i;
+    }
+#endif
+
+    return sample;
+}
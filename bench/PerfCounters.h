@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+// 硬件性能计数器
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,        // L1数据缓存读缺失
+    PERF_LLC_MISSES,        // 末级缓存缺失
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+// 一段代码期间各计数器的增量，available按PerfEvent取位，不可用的计数器值为0
+struct PerfSample {
+    std::uint64_t values[PERF_EVENT_COUNT];
+    unsigned int available;
+
+    PerfSample() : available(0) {
+        for (int i = 0; i < PERF_EVENT_COUNT; i++) values[i] = 0;
+    }
+
+    bool has(PerfEvent event) const { return (available >> event) & 1u; }
+};
+
+// 读取调用线程的硬件计数器：Linux用perf_event_open，Windows只有QueryThreadCycleTime的周期数。
+// 容器、虚拟机中没有权限或硬件不支持的计数器打不开时跳过，基准照常运行，结果中不输出这一项。
+// 只统计调用线程：任务池工作线程上执行的分段不计入，需要完整计数时用--threads 1
+class PerfCounters {
+private:
+    int descriptors[PERF_EVENT_COUNT];      // Linux的计数器文件描述符，打不开时为-1
+    unsigned int available;
+    std::uint64_t startCycles;              // Windows：start时的线程周期数
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    static const char* eventName(PerfEvent event);
+
+    unsigned int getAvailable() const { return available; }
+
+    // 清零并开始计数；stop停止计数并返回这段时间的增量（多路复用时按实际计数时间的比例换算）
+    void start();
+    PerfSample stop();
+};
@@ -0,0 +1,217 @@
+#include "BatchRunner.h"
+#include "SimPolicy.h"
+#include "JobSystem.h"
+#include <iomanip>
+
+static const char* obstacleTypeName(ObstacleType type) {
+    switch (type) {
+    case SPIKE: return "SPIKE";
+    case FIREBALL: return "FIREBALL";
+    case LASER: return "LASER";
+    case ROTATING_SAW: return "ROTATING_SAW";
+    case FALLING_ROCK: return "FALLING_ROCK";
+    case MOVING_WALL: return "MOVING_WALL";
+    }
+    return "UNKNOWN";
+}
+
+static const char* itemTypeName(int type) {
+    static const char* names[] = {
+        "NONE", "SPEED_BOOST", "SHIELD", "DOUBLE_JUMP", "SLOW_TIME", "MAGNETIC_FIELD",
+        "HEALTH_BOOST", "FREEZE_OBSTACLES", "COIN", "INVINCIBILITY"
+    };
+    return names[type];
+}
+
+static std::string deathCauseKey(const RunStats& stats) {
+    switch (stats.deathCause) {
+    case DEATH_FELL: return "fell";
+    case DEATH_OBSTACLE: return std::string("obstacle:") + obstacleTypeName(stats.killerObstacle);
+    case DEATH_TIMEOUT: return "timeout";
+    default: return "none";
+    }
+}
+
+Distribution Distribution::fromSamples(std::vector<double> samples) {
+    Distribution d;
+    if (samples.empty()) return d;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+
+    auto percentile = [&samples](double p) {
+        size_t index = (size_t)(p * (samples.size() - 1) + 0.5);
+        return samples[index];
+    };
+
+    d.mean = sum / samples.size();
+    d.min = samples.front();
+    d.p10 = percentile(0.10);
+    d.p50 = percentile(0.50);
+    d.p90 = percentile(0.90);
+    d.max = samples.back();
+    return d;
+}
+
+BatchRunner::BatchRunner(const BatchConfig& config)
+    : config(config) {
+}
+
+RunStats BatchRunner::simulateRun(const GameTuning& tuning, unsigned int seed,
+    const std::string& policyName, float maxSeconds, float deltaTime) {
+    Game game(true, seed);
+    game.setTuning(tuning);
+    game.startHeadlessRun();
+
+    std::unique_ptr<SimPolicy> policy = createSimPolicy(policyName);
+
+    while (game.getState() == PLAYING && game.getGameTime() < maxSeconds) {
+        if (policy) {
+            policy->act(game, deltaTime);
+        }
+        game.updateGame(deltaTime);
+    }
+
+    RunStats stats = game.getRunStats();
+    if (game.getState() == PLAYING) {
+        stats.deathCause = DEATH_TIMEOUT;
+    }
+    return stats;
+}
+
+std::vector<PointSummary> BatchRunner::run(const std::vector<SweepPoint>& points) const {
+    const size_t runsPerPoint = (size_t)std::max(1, config.runsPerPoint);
+    const size_t totalJobs = points.size() * runsPerPoint;
+    const float deltaTime = 1.0f / config.tickRate;
+
+    std::vector<RunStats> results(totalJobs);
+
+    // 所有Game共享AudioManager单例：先在主线程中创建并关闭音频，工作线程只读
+    AudioManager::getInstance().setAudioEnabled(false);
+
+    // 每局一个任务，由共享的任务池分给各个工作线程；主线程等待时也执行本批次的任务
+    JobSystem& jobs = JobSystem::getInstance();
+    JobCounter pending;
+    for (size_t job = 0; job < totalJobs; job++) {
+        jobs.run(pending, [&, job]() {
+            size_t pointIndex = job / runsPerPoint;
+            size_t runIndex = job % runsPerPoint;
+
+            // 各参数点使用相同的种子序列，便于对比参数差异
+            unsigned int seed = config.baseSeed + (unsigned int)runIndex * 7919u + 1u;
+            results[job] = simulateRun(points[pointIndex].tuning, seed, config.policy,
+                config.maxSeconds, deltaTime);
+        });
+    }
+    jobs.wait(pending);
+
+    std::vector<PointSummary> summaries;
+    for (size_t p = 0; p < points.size(); p++) {
+        std::vector<RunStats> pointRuns(results.begin() + p * runsPerPoint,
+            results.begin() + (p + 1) * runsPerPoint);
+        summaries.push_back(summarize(points[p].label, pointRuns));
+    }
+    return summaries;
+}
+
+PointSummary BatchRunner::summarize(const std::string& label, const std::vector<RunStats>& runs) {
+    PointSummary summary;
+    summary.label = label;
+    summary.runs = (int)runs.size();
+
+    std::vector<double> heights, survival, scores, coins, items;
+    for (const auto& stats : runs) {
+        heights.push_back((double)stats.maxHeight);
+        survival.push_back(stats.survivalTime);
+        scores.push_back((double)stats.score);
+        coins.push_back(stats.coins);
+        items.push_back(stats.itemsCollected);
+
+        size_t bucket = (size_t)(stats.maxHeight / HEIGHT_BUCKET);
+        if (bucket >= summary.heightHistogram.size()) {
+            summary.heightHistogram.resize(bucket + 1, 0);
+        }
+        summary.heightHistogram[bucket]++;
+
+        summary.deathCauses[deathCauseKey(stats)]++;
+
+        for (int i = 0; i <= INVINCIBILITY; i++) {
+            summary.itemUsage[i] += stats.itemUsage[i];
+        }
+    }
+
+    summary.height = Distribution::fromSamples(heights);
+    summary.survivalTime = Distribution::fromSamples(survival);
+    summary.score = Distribution::fromSamples(scores);
+    summary.coins = Distribution::fromSamples(coins);
+    summary.itemsCollected = Distribution::fromSamples(items);
+    return summary;
+}
+
+static void writeDistribution(std::ostream& out, const char* name, const Distribution& d) {
+    out << "\"" << name << "\": {\"mean\": " << d.mean << ", \"min\": " << d.min
+        << ", \"p10\": " << d.p10 << ", \"p50\": " << d.p50
+        << ", \"p90\": " << d.p90 << ", \"max\": " << d.max << "}";
+}
+
+void BatchRunner::writeJson(std::ostream& out, const BatchConfig& config,
+    const std::vector<PointSummary>& summaries) {
+    out << std::setprecision(3) << std::fixed;
+    out << "{\n  \"policy\": \"" << config.policy << "\", \"runs_per_point\": " << config.runsPerPoint
+        << ", \"base_seed\": " << config.baseSeed << ", \"max_seconds\": " << config.maxSeconds
+        << ",\n  \"points\": [\n";
+
+    for (size_t p = 0; p < summaries.size(); p++) {
+        const auto& s = summaries[p];
+        out << "    {\"label\": \"" << s.label << "\", \"runs\": " << s.runs << ",\n     ";
+        writeDistribution(out, "height", s.height);
+        out << ",\n     ";
+        writeDistribution(out, "survival_time", s.survivalTime);
+        out << ",\n     ";
+        writeDistribution(out, "score", s.score);
+        out << ",\n     ";
+        writeDistribution(out, "coins", s.coins);
+        out << ",\n     ";
+        writeDistribution(out, "items_collected", s.itemsCollected);
+
+        out << ",\n     \"height_bucket\": " << HEIGHT_BUCKET << ", \"height_histogram\": [";
+        for (size_t i = 0; i < s.heightHistogram.size(); i++) {
+            out << (i ? ", " : "") << s.heightHistogram[i];
+        }
+
+        out << "],\n     \"death_causes\": {";
+        bool first = true;
+        for (const auto& cause : s.deathCauses) {
+            out << (first ? "" : ", ") << "\"" << cause.first << "\": " << cause.second;
+            first = false;
+        }
+
+        out << "},\n     \"item_usage\": {";
+        for (int i = SPEED_BOOST; i <= INVINCIBILITY; i++) {
+            out << (i > SPEED_BOOST ? ", " : "") << "\"" << itemTypeName(i) << "\": " << s.itemUsage[i];
+        }
+        out << "}}" << (p + 1 < summaries.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+void BatchRunner::writeTable(std::ostream& out, const std::vector<PointSummary>& summaries) {
+    out << std::left << std::setw(48) << "point"
+        << std::right << std::setw(8) << "runs"
+        << std::setw(12) << "height p50"
+        << std::setw(12) << "height p90"
+        << std::setw(12) << "time p50"
+        << std::setw(10) << "coins" << "\n";
+
+    for (const auto& s : summaries) {
+        out << std::left << std::setw(48) << s.label
+            << std::right << std::setw(8) << s.runs
+            << std::setprecision(0) << std::fixed
+            << std::setw(12) << s.height.p50
+            << std::setw(12) << s.height.p90
+            << std::setprecision(1)
+            << std::setw(12) << s.survivalTime.p50
+            << std::setw(10) << s.coins.mean << "\n";
+    }
+}
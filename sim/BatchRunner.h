@@ -0,0 +1,66 @@
+#pragma once
+#include "Game.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+// 参数网格中的一个点
+struct SweepPoint {
+    std::string label;      // 例如 "baseWorldSpeed=20,obstacleMinSpawnInterval=1"
+    GameTuning tuning;
+};
+
+// 批量模拟配置
+struct BatchConfig {
+    int runsPerPoint = 1000;
+    int threads = 0;                // 任务池的线程数（含调用线程），0 表示使用全部硬件线程
+    unsigned int baseSeed = 1;
+    float maxSeconds = 600.0f;      // 单局模拟时长上限
+    float tickRate = 60.0f;         // 固定步长频率
+    std::string policy = "greedy";
+};
+
+// 数值分布摘要
+struct Distribution {
+    double mean = 0, min = 0, p10 = 0, p50 = 0, p90 = 0, max = 0;
+
+    static Distribution fromSamples(std::vector<double> samples);
+};
+
+// 单个参数点的汇总结果
+struct PointSummary {
+    std::string label;
+    int runs = 0;
+    Distribution height;
+    Distribution survivalTime;
+    Distribution score;
+    Distribution coins;
+    Distribution itemsCollected;
+    std::vector<int> heightHistogram;           // 每HEIGHT_BUCKET像素一个桶
+    std::map<std::string, int> deathCauses;     // fell / timeout / obstacle:FIREBALL ...
+    long long itemUsage[INVINCIBILITY + 1] = {};
+};
+
+// 在所有核心上并行运行带种子的无窗口对局，并按参数点汇总
+class BatchRunner {
+private:
+    BatchConfig config;
+
+public:
+    static const int HEIGHT_BUCKET = 250;
+
+    explicit BatchRunner(const BatchConfig& config);
+
+    std::vector<PointSummary> run(const std::vector<SweepPoint>& points) const;
+
+    // 运行单局：同一种子下结果可复现（随机数状态按线程独立，见Random.h）
+    static RunStats simulateRun(const GameTuning& tuning, unsigned int seed,
+        const std::string& policy, float maxSeconds, float deltaTime);
+
+    static PointSummary summarize(const std::string& label, const std::vector<RunStats>& runs);
+
+    static void writeJson(std::ostream& out, const BatchConfig& config,
+        const std::vector<PointSummary>& summaries);
+    static void writeTable(std::ostream& out, const std::vector<PointSummary>& summaries);
+};
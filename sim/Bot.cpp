@@ -0,0 +1,214 @@
+#include "Bot.h"
+#include "Game.h"
+#include <cmath>
+#include <algorithm>
+
+Bot::Bot(int playerIndex)
+    : playerIndex(playerIndex), plan{ 0, 0, false, false }, planTick(REPLAN_TICKS), airJumpDone(false),
+    wasOnGround(false), plansEvaluated(0) {
+}
+
+void Bot::snapshot(Game& game) {
+    const World& world = game.getWorld();
+    const Registry& registry = world.getRegistry();
+    const Player& player = game.getPlayer(playerIndex);
+    float killZone = game.getKillZone(playerIndex);
+
+    // 只关心一次跳跃能到达的高度范围内的平台
+    platforms.clear();
+    const auto& platformStates = registry.pool<PlatformState>();
+    for (size_t i = 0; i < platformStates.size(); i++) {
+        const PlatformState& state = platformStates.at(i);
+        if (state.broken) continue;
+
+        Entity entity = platformStates.entityAt(i);
+        const Transform& transform = registry.get<Transform>(entity);
+        if (transform.y < player.getY() - 400.0f || transform.y > killZone) continue;
+
+        platforms.push_back({ world.getPosition(entity).x, transform.y, registry.get<Bounds>(entity).width,
+            world.getVelocityX(entity), (int)state.type, registry.valid(state.item) });
+    }
+
+    obstacles.clear();
+    world.collectObstacles(player.getY() - 600.0f, player.getY() + 400.0f, obstacles);
+}
+
+// 按障碍物各自的速度外推t秒后的位置
+static void obstaclePositionAt(const ObstacleView& obstacle, float t, float worldSpeed, float& outX, float& outY) {
+    outX = obstacle.x + obstacle.vx * t;
+    outY = obstacle.y + obstacle.vy * t + 0.5f * obstacle.gravity * t * t;
+    if (obstacle.scrolls) outY += worldSpeed * t;
+}
+
+float Bot::evaluate(const Game& game, const Plan& candidate, float deltaTime) const {
+    const Player& player = game.getPlayer(playerIndex);
+
+    // 时间减缓作用于整个游戏层：玩家物理、世界下移和障碍物运动都用缩放后的步长
+    const float dt = deltaTime * game.getGameplayTimeScale();
+    const float moveSpeed = Player::MOVE_SPEED * player.getSpeedMultiplier();
+    const float worldSpeed = game.getWorldSpeed();
+    const float killZone = game.getKillZone(playerIndex);
+    const float width = player.getWidth();
+    const float height = player.getHeight();
+    const bool vulnerable = player.canTakeDamage() && !player.hasObstaclesFrozen();
+    const int maxJumps = player.getMaxJumps();
+
+    float x = player.getX(), y = player.getY();
+    float vx = player.getVX(), vy = player.getVY();
+    bool onGround = player.isOnGround();
+    int jumpsLeft = onGround ? maxJumps : maxJumps - player.getJumpCount();
+    bool airJumpUsed = false;
+    const float startY = y;
+
+    // 起跳前脚下的平台：落回原处不算进展
+    int startPlatform = -1;
+    for (size_t i = 0; i < platforms.size(); i++) {
+        const PlatformInfo& platform = platforms[i];
+        if (x + width > platform.x && x < platform.x + platform.width &&
+            std::abs(y + height - platform.y) <= 15.0f) {
+            startPlatform = (int)i;
+            break;
+        }
+    }
+
+    for (int tick = 0; tick < HORIZON_TICKS; tick++) {
+        float time = (tick + 1) * dt;
+
+        // 输入
+        int direction = tick < candidate.releaseTick ? candidate.direction : 0;
+        vx += direction * moveSpeed;
+
+        bool jump = (tick == 0 && candidate.jumpNow) ||
+            (candidate.airJump && !airJumpUsed && tick > 0 && !onGround && vy >= 0);
+        if (jump && (onGround || jumpsLeft > 0)) {
+            jumpsLeft = onGround ? maxJumps - 1 : jumpsLeft - 1;
+            if (!onGround) airJumpUsed = true;
+            vy = Player::JUMP_SPEED;
+            onGround = false;
+        }
+
+        // 物理
+        if (!onGround) {
+            vy = std::min(vy + Player::GRAVITY * dt, Player::MAX_FALL_SPEED);
+        }
+        else if (vy > 0) {
+            vy = 0;
+        }
+        vx *= Player::FRICTION;
+        const float prevX = x, prevY = y;
+        const float prevBottom = y + height;
+        x = std::max(0.0f, std::min(x + vx * dt, WINDOW_WIDTH - width));
+        y += vy * dt;
+
+        if (y > killZone) {
+            return -5000.0f;
+        }
+
+        // 障碍物按各自速度外推，与游戏一样按整帧扫掠
+        if (vulnerable) {
+            const SweptBox box = { prevX, prevY, x, y, width, height };
+            for (const auto& obstacle : obstacles) {
+                float ox0, oy0, ox1, oy1;
+                obstaclePositionAt(obstacle, time - dt, worldSpeed, ox0, oy0);
+                obstaclePositionAt(obstacle, time, worldSpeed, ox1, oy1);
+
+                float enter;
+                if (sweepBoxes(box, SweptBox{ ox0, oy0, ox1, oy1, obstacle.width, obstacle.height }, enter)) {
+                    // 越早撞上越糟
+                    return -1000.0f - (HORIZON_TICKS - tick) * 10.0f;
+                }
+            }
+        }
+
+        // 落地（只在下落或静止时计入，上升途中穿过平台会继续上升）
+        onGround = false;
+        if (vy < 0) continue;
+
+        for (size_t i = 0; i < platforms.size(); i++) {
+            const PlatformInfo& platform = platforms[i];
+            float px = platform.x + platform.vx * time;
+            float py = platform.y + worldSpeed * time;
+            float landingWindow = platform.type == SPRING ? 20.0f : 15.0f;
+            float bottom = y + height;
+
+            // 与游戏的扫掠检测一致：本帧从上方越过顶面也算落地
+            bool crossed = prevBottom <= py - worldSpeed * dt;
+            if (x + width > px && x < px + platform.width && bottom >= py && (crossed || bottom <= py + landingWindow)) {
+                float score = startY - (py - height);
+                if ((int)i == startPlatform) score -= 20.0f;
+                if (platform.type == SPRING) score += 30.0f;
+                if (platform.type == BREAKABLE) score -= 25.0f;
+                if (platform.hasItem) score += 15.0f;
+
+                // 落点离平台中心越近越稳；太靠近死亡线的平台很快会带着玩家下沉
+                score -= std::abs(x + width / 2 - (px + platform.width / 2)) * 0.1f;
+                if (py + worldSpeed * 2.0f > killZone - 50.0f) score -= 200.0f;
+
+                return score - tick * 0.5f;
+            }
+        }
+    }
+
+    // 预测期内没有落地：按高度变化估计，并视为有风险
+    return (startY - y) * 0.5f - 150.0f;
+}
+
+void Bot::replan(const Game& game, float deltaTime) {
+    bool canJump = game.getPlayer(playerIndex).canJump();
+
+    static const int directions[] = { 0, -1, 1 };
+    static const int releaseTicks[] = { HORIZON_TICKS, 30, 15, 6 };
+
+    Plan best = { 0, 0, false, false };
+    float bestScore = -1e9f;
+    for (int direction : directions) {
+        for (int releaseTick : releaseTicks) {
+            if (direction == 0 && releaseTick != HORIZON_TICKS) continue;
+            for (int jumpNow = 0; jumpNow <= (canJump ? 1 : 0); jumpNow++) {
+                for (int airJump = 0; airJump <= 1; airJump++) {
+                    Plan candidate = { direction, releaseTick, jumpNow != 0, airJump != 0 };
+                    float score = evaluate(game, candidate, deltaTime);
+                    plansEvaluated++;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = candidate;
+                    }
+                }
+            }
+        }
+    }
+
+    plan = best;
+    planTick = 0;
+    airJumpDone = false;
+}
+
+InputFrame Bot::think(Game& game, float deltaTime) {
+    Player& player = game.getPlayer(playerIndex);
+    bool onGround = player.isOnGround();
+
+    // 定期重新规划；着地或离地时立即重新规划
+    if (planTick >= REPLAN_TICKS || onGround != wasOnGround) {
+        snapshot(game);
+        replan(game, deltaTime);
+    }
+    wasOnGround = onGround;
+
+    InputFrame frame;
+    frame.time = game.getGameTime();
+
+    int direction = planTick < plan.releaseTick ? plan.direction : 0;
+    if (direction < 0) frame.held |= 1u << KEY_LEFT;
+    if (direction > 0) frame.held |= 1u << KEY_RIGHT;
+
+    bool airJumpNow = plan.airJump && !airJumpDone && planTick > 0 && !onGround && player.getVY() >= 0;
+    if ((planTick == 0 && plan.jumpNow) || airJumpNow) {
+        frame.held |= 1u << KEY_SPACE;
+        frame.pressed |= 1u << KEY_SPACE;
+        frame.pressTime[KEY_SPACE] = frame.time;
+        if (airJumpNow) airJumpDone = true;
+    }
+
+    planTick++;
+    return frame;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Input.h"
+#include "World.h"
+#include <vector>
+
+class Game;
+
+// 自动玩家：每个tick读取玩家、平台和障碍物，输出一帧输入（与键盘走同一条InputFrame路径）
+// 规划方式是对少量候选动作做前向模拟：按Player的物理常量逐帧推演玩家轨迹，
+// 平台和障碍物按各自速度和世界下移速度外推，选择落点最高且途中不碰障碍物的方案
+// 每个实例只持有自己的状态，可以在多个线程的无窗口对局中同时运行
+class Bot {
+private:
+    static const int HORIZON_TICKS = 75;        // 前向模拟的最大帧数
+    static const int REPLAN_TICKS = 4;          // 每隔几帧重新规划一次
+
+    // 候选方案：先朝direction移动releaseTick帧再松开，可选立即起跳和在最高点补跳
+    struct Plan {
+        int direction;
+        int releaseTick;
+        bool jumpNow;
+        bool airJump;
+    };
+
+    // 规划时使用的世界快照（只保留玩家附近的实体）
+    struct PlatformInfo {
+        float x, y, width;
+        float vx;
+        int type;
+        bool hasItem;
+    };
+
+    int playerIndex;        // 控制的玩家（多人局中的下标）
+    Plan plan;
+    int planTick;
+    bool airJumpDone;
+    bool wasOnGround;
+    int plansEvaluated;
+
+    std::vector<PlatformInfo> platforms;
+    std::vector<ObstacleView> obstacles;       // 由World::collectObstacles填入，容量在对局间复用
+
+    void snapshot(Game& game);
+    float evaluate(const Game& game, const Plan& candidate, float deltaTime) const;
+    void replan(const Game& game, float deltaTime);
+
+public:
+    explicit Bot(int playerIndex = 0);
+
+    InputFrame think(Game& game, float deltaTime);
+
+    int getPlansEvaluated() const { return plansEvaluated; }
+};
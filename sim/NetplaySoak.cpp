@@ -0,0 +1,141 @@
+#include "NetplaySoak.h"
+#include "Bot.h"
+#include "Game.h"
+#include "NetTransport.h"
+#include <thread>
+#include <chrono>
+#include <string>
+#include <iomanip>
+
+namespace {
+    // 本端结束后等待其余各端输入到齐的最长时间
+    const double DRAIN_TIMEOUT_SECONDS = 5.0;
+
+    void runPeer(const NetplayConfig& config, int index, NetTransport& transport, NetplayPeerResult& result) {
+        Game game(true, config.seed);
+        game.startNetRun(config.players, index, config.seed);
+
+        // 每端的网络条件独立抖动
+        LatencyInjector link(transport, config.latencyMs, config.jitterMs, config.lossRate,
+            config.seed * 31u + (unsigned int)index + 1u);
+        NetSession session(game, link, config.players, index, config.inputDelay);
+        Bot bot(index);
+
+        const std::uint32_t endTick = (std::uint32_t)(config.seconds / NET_TICK_SECONDS + 0.5f);
+        const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(NET_TICK_SECONDS));
+
+        // 按60Hz实时推进，与真实对局一样受网络延迟约束
+        auto nextTick = std::chrono::steady_clock::now();
+        while (session.getCurrentTick() < endTick) {
+            InputFrame frame;
+            if (game.getState() == PLAYING && game.isPlayerAlive(index)) {
+                frame = bot.think(game, NET_TICK_SECONDS);
+            }
+            session.advance(frame);
+
+            nextTick += tickDuration;
+            std::this_thread::sleep_until(nextTick);
+        }
+
+        auto drainStart = std::chrono::steady_clock::now();
+        while (session.getConfirmedTick() < endTick) {
+            session.poll();
+            if (std::chrono::steady_clock::now() - drainStart > std::chrono::duration<double>(DRAIN_TIMEOUT_SECONDS)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // 继续收发一会儿，让对端也能拿到本端最后的输入和摘要
+        for (int i = 0; i < 100; i++) {
+            session.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+
+        result.stats = session.getStats();
+        result.finalTick = endTick - 1;
+        result.hasChecksum = session.getChecksum(result.finalTick, result.finalChecksum);
+        result.alive = game.isPlayerAlive(index);
+    }
+}
+
+NetplayResult NetplaySoak::run(const NetplayConfig& config) {
+    NetplayResult result;
+    result.peers.resize(config.players);
+
+    // 所有Game共享AudioManager单例：先在主线程中创建并关闭音频
+    AudioManager::getInstance().setAudioEnabled(false);
+
+    LoopbackHub hub(config.players);
+    std::vector<std::unique_ptr<NetTransport>> transports;
+    for (int i = 0; i < config.players; i++) {
+        if (config.udp) {
+            std::vector<std::string> peers;
+            for (int j = 0; j < config.players; j++) {
+                if (j != i) {
+                    peers.push_back("127.0.0.1:" + std::to_string(config.basePort + j));
+                }
+            }
+            std::unique_ptr<UdpTransport> udp(new UdpTransport());
+            if (!udp->open((std::uint16_t)(config.basePort + i), peers)) {
+                return result;
+            }
+            transports.push_back(std::move(udp));
+        }
+        else {
+            transports.push_back(hub.connect(i));
+        }
+    }
+
+    // 随机数状态按线程独立，每端必须在自己的线程里模拟
+    std::vector<std::thread> threads;
+    for (int i = 0; i < config.players; i++) {
+        threads.emplace_back(runPeer, std::cref(config), i, std::ref(*transports[i]), std::ref(result.peers[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    result.converged = true;
+    for (const auto& peer : result.peers) {
+        result.desyncs += peer.stats.desyncs;
+        if (!peer.hasChecksum || peer.finalChecksum != result.peers[0].finalChecksum) {
+            result.converged = false;
+        }
+    }
+    return result;
+}
+
+void NetplaySoak::writeReport(std::ostream& out, const NetplayConfig& config, const NetplayResult& result) {
+    out << config.players << " peer(s) over " << (config.udp ? "udp" : "loopback") << ", "
+        << config.seconds << " s, delay " << config.inputDelay << " tick(s), latency "
+        << config.latencyMs << "+-" << config.jitterMs << " ms, loss " << config.lossRate * 100.0f << "%\n";
+    if (result.peers.empty() || (config.udp && result.peers[0].stats.ticks == 0)) {
+        out << "failed to open transport\n";
+        return;
+    }
+
+    out << std::left << std::setw(6) << "peer" << std::right
+        << std::setw(8) << "ticks" << std::setw(8) << "stalls" << std::setw(10) << "rollbacks"
+        << std::setw(8) << "resim" << std::setw(9) << "maxDepth" << std::setw(10) << "maxMs"
+        << std::setw(10) << "avgMs" << std::setw(9) << "checked" << std::setw(8) << "desync"
+        << std::setw(12) << "checksum" << "\n";
+
+    for (size_t i = 0; i < result.peers.size(); i++) {
+        const NetplayPeerResult& peer = result.peers[i];
+        const NetStats& stats = peer.stats;
+        double averageMs = stats.rollbacks > 0 ? stats.totalResimMs / stats.rollbacks : 0.0;
+        out << std::left << std::setw(6) << i << std::right
+            << std::setw(8) << stats.ticks << std::setw(8) << stats.stalls << std::setw(10) << stats.rollbacks
+            << std::setw(8) << stats.resimulatedFrames << std::setw(9) << stats.maxRollbackFrames
+            << std::fixed << std::setprecision(3)
+            << std::setw(10) << stats.maxResimMs << std::setw(10) << averageMs
+            << std::setw(9) << stats.checksumsCompared << std::setw(8) << stats.desyncs
+            << std::setw(4) << "" << std::hex << std::setw(8) << std::setfill('0') << peer.finalChecksum
+            << std::dec << std::setfill(' ') << (peer.hasChecksum ? "" : "?") << "\n";
+    }
+
+    out << (result.converged && result.desyncs == 0 ? "in sync" : "DESYNC")
+        << " at tick " << result.peers[0].finalTick << "\n";
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "NetSession.h"
+#include <ostream>
+#include <vector>
+
+// 联机浸泡测试配置：每个端一个线程，各自运行无窗口的Game、Bot和NetSession
+struct NetplayConfig {
+    int players = 2;
+    unsigned int seed = 1;
+    float seconds = 30.0f;          // 模拟时长（按60Hz实时推进）
+    int inputDelay = 2;
+    int latencyMs = 0;              // 单向延迟
+    int jitterMs = 0;
+    float lossRate = 0.0f;
+    bool udp = false;               // false：进程内回环；true：本机UDP
+    int basePort = 47100;           // 第i端绑定basePort + i
+};
+
+// 单个端的结果
+struct NetplayPeerResult {
+    NetStats stats;
+    std::uint32_t finalTick = 0;        // 最后一个比较摘要的帧
+    std::uint32_t finalChecksum = 0;
+    bool hasChecksum = false;
+    bool alive = false;                 // 结束时本端玩家是否存活
+};
+
+struct NetplayResult {
+    std::vector<NetplayPeerResult> peers;
+    bool converged = false;             // 各端最后一帧的摘要一致
+    long long desyncs = 0;
+};
+
+// 用Bot操控每一端，在延迟、抖动和丢包下运行完整的回滚联机，检查各端状态始终一致
+class NetplaySoak {
+public:
+    static NetplayResult run(const NetplayConfig& config);
+    static void writeReport(std::ostream& out, const NetplayConfig& config, const NetplayResult& result);
+};
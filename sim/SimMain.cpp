@@ -0,0 +1,192 @@
+#include "BatchRunner.h"
+#include "SimPolicy.h"
+#include "NetplaySoak.h"
+#include "JobSystem.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+static std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, separator)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+// 设置单个平衡性参数；平台类型概率写作 "70/85/95"
+static bool setTuningParam(GameTuning& tuning, const std::string& key, const std::string& value) {
+    if (key == "platformTypesEasy" || key == "platformTypesMedium" || key == "platformTypesHard") {
+        int tier = key == "platformTypesEasy" ? 0 : (key == "platformTypesMedium" ? 1 : 2);
+        std::vector<std::string> parts = split(value, '/');
+        if (parts.size() != 3) return false;
+        for (int i = 0; i < 3; i++) {
+            tuning.platformTypeThresholds[tier][i] = atoi(parts[i].c_str());
+        }
+        return true;
+    }
+
+    float number = (float)atof(value.c_str());
+    if (key == "obstacleInitialSpawnRate") tuning.obstacleInitialSpawnRate = number;
+    else if (key == "obstacleMaxSpawnInterval") tuning.obstacleMaxSpawnInterval = number;
+    else if (key == "obstacleMinSpawnInterval") tuning.obstacleMinSpawnInterval = number;
+    else if (key == "obstacleSpawnIntervalDrop") tuning.obstacleSpawnIntervalDrop = number;
+    else if (key == "baseWorldSpeed") tuning.baseWorldSpeed = number;
+    else if (key == "worldSpeedTimeGrowth") tuning.worldSpeedTimeGrowth = number;
+    else if (key == "worldSpeedScoreGrowth") tuning.worldSpeedScoreGrowth = number;
+    else if (key == "maxWorldSpeed") tuning.maxWorldSpeed = number;
+    else return false;
+    return true;
+}
+
+// 将 "k1=a,b;k2=c,d" 展开为参数网格的笛卡尔积
+static bool buildSweepPoints(const std::string& grid, std::vector<SweepPoint>& points) {
+    points.clear();
+    points.push_back({ "", GameTuning() });
+
+    for (const auto& axis : split(grid, ';')) {
+        size_t eq = axis.find('=');
+        if (eq == std::string::npos) return false;
+
+        std::string key = axis.substr(0, eq);
+        std::vector<std::string> values = split(axis.substr(eq + 1), ',');
+        if (values.empty()) return false;
+
+        std::vector<SweepPoint> expanded;
+        for (const auto& point : points) {
+            for (const auto& value : values) {
+                SweepPoint next = point;
+                if (!setTuningParam(next.tuning, key, value)) return false;
+                next.label += (next.label.empty() ? "" : ",") + key + "=" + value;
+                expanded.push_back(next);
+            }
+        }
+        points.swap(expanded);
+    }
+
+    if (points.size() == 1 && points[0].label.empty()) {
+        points[0].label = "default";
+    }
+    return true;
+}
+
+static void printUsage() {
+    std::cerr << "usage: jumping_sim [--runs <n>] [--threads <n>] [--seed <n>] [--max-minutes <m>]\n"
+        << "                   [--tick-rate <hz>] [--policy greedy|scripted|bot] [--out <file.json>]\n"
+        << "                   [--grid \"key=v1,v2;key2=v3,v4\"]\n"
+        << "       jumping_sim --netplay [--players <n>] [--seed <n>] [--seconds <s>] [--delay <ticks>]\n"
+        << "                   [--latency <ms>] [--jitter <ms>] [--loss <0..1>] [--udp [--port <base>]]\n"
+        << "grid keys: obstacleInitialSpawnRate obstacleMaxSpawnInterval obstacleMinSpawnInterval\n"
+        << "           obstacleSpawnIntervalDrop baseWorldSpeed worldSpeedTimeGrowth\n"
+        << "           worldSpeedScoreGrowth maxWorldSpeed\n"
+        << "           platformTypesEasy/Medium/Hard (value: normal/moving/breakable cumulative %, e.g. 70/85/95)\n";
+}
+
+// 联机浸泡测试：各端由Bot操控，检查回滚后各端状态一致
+static int runNetplay(int argc, char* argv[]) {
+    NetplayConfig config;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--netplay") == 0) continue;
+        else if (strcmp(argv[i], "--players") == 0 && hasValue) config.players = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) config.seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seconds") == 0 && hasValue) config.seconds = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--delay") == 0 && hasValue) config.inputDelay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--latency") == 0 && hasValue) config.latencyMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && hasValue) config.jitterMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--loss") == 0 && hasValue) config.lossRate = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--udp") == 0) config.udp = true;
+        else if (strcmp(argv[i], "--port") == 0 && hasValue) config.basePort = atoi(argv[++i]);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (config.players < 2 || config.players > MAX_LOCAL_PLAYERS || config.seconds <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    NetplayResult result = NetplaySoak::run(config);
+    NetplaySoak::writeReport(std::cerr, config, result);
+    return result.converged && result.desyncs == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--netplay") == 0) {
+            return runNetplay(argc, argv);
+        }
+    }
+
+    BatchConfig config;
+    std::string grid;
+    std::string outPath;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--runs") == 0 && hasValue) config.runsPerPoint = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) config.baseSeed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-minutes") == 0 && hasValue) config.maxSeconds = (float)atof(argv[++i]) * 60.0f;
+        else if (strcmp(argv[i], "--tick-rate") == 0 && hasValue) config.tickRate = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--policy") == 0 && hasValue) config.policy = argv[++i];
+        else if (strcmp(argv[i], "--grid") == 0 && hasValue) grid = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && hasValue) outPath = argv[++i];
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!createSimPolicy(config.policy) || config.tickRate <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<SweepPoint> points;
+    if (!buildSweepPoints(grid, points)) {
+        std::cerr << "invalid --grid: " << grid << "\n";
+        printUsage();
+        return 1;
+    }
+
+    // 批量模拟在共享任务池中执行：调用线程也参与，工作线程数比--threads少一个
+    if (config.threads > 0) {
+        JobSystem::setWorkerCount(config.threads - 1);
+    }
+
+    std::cerr << points.size() << " point(s) x " << config.runsPerPoint << " run(s), policy "
+        << config.policy << "\n";
+
+    auto start = std::chrono::steady_clock::now();
+    BatchRunner runner(config);
+    std::vector<PointSummary> summaries = runner.run(points);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BatchRunner::writeTable(std::cerr, summaries);
+    std::cerr << std::setprecision(2) << "finished in " << seconds << " s\n";
+
+    // 长时间浸泡测试时关心模拟了多少游戏时间
+    double simulatedSeconds = 0;
+    for (const auto& summary : summaries) {
+        simulatedSeconds += summary.survivalTime.mean * summary.runs;
+    }
+    std::cerr << std::fixed << std::setprecision(1) << "simulated " << simulatedSeconds / 3600.0
+        << " h of gameplay (" << (seconds > 0 ? simulatedSeconds / seconds : 0.0) << "x realtime)\n";
+
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        BatchRunner::writeJson(out, config, summaries);
+    }
+    else {
+        BatchRunner::writeJson(std::cout, config, summaries);
+    }
+    return 0;
+}
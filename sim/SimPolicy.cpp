@@ -0,0 +1,104 @@
+#include "SimPolicy.h"
+#include "Game.h"
+
+void ScriptedPolicy::act(Game& game, float deltaTime) {
+    Player& player = game.getPlayer();
+    timer += deltaTime;
+
+    // 每0.5秒跳一次，每2秒换一次方向
+    if (player.isOnGround() && fmod(timer, 0.5f) < deltaTime) {
+        player.jump();
+    }
+    if (fmod(timer, 4.0f) < 2.0f) {
+        player.moveRight();
+    }
+    else {
+        player.moveLeft();
+    }
+}
+
+void GreedyPolicy::act(Game& game, float deltaTime) {
+    Player& player = game.getPlayer();
+    if (jumpCooldown > 0) {
+        jumpCooldown -= deltaTime;
+    }
+
+    float playerCenterX = player.getX() + player.getWidth() / 2;
+    float playerBottom = player.getY() + player.getHeight();
+
+    // 选择玩家脚下上方、跳跃包络内水平距离最近的平台
+    float maxRise = JumpEnvelope::forPlayer(player).getSafeRise();
+    const World& world = game.getWorld();
+    const Registry& registry = world.getRegistry();
+    const auto& platforms = registry.pool<PlatformState>();
+    bool hasTarget = false;
+    Transform target;
+    float targetWidth = 0.0f;
+    float bestCost = 1e9f;
+    for (size_t i = 0; i < platforms.size(); i++) {
+        if (platforms.at(i).broken) continue;
+
+        Entity entity = platforms.entityAt(i);
+        const Transform transform = world.getPosition(entity);
+        float width = registry.get<Bounds>(entity).width;
+
+        float rise = playerBottom - transform.y;
+        if (rise < 20.0f || rise > maxRise) continue;
+
+        float centerX = transform.x + width / 2;
+        float cost = std::abs(centerX - playerCenterX) - rise * 0.5f;
+        if (cost < bestCost) {
+            bestCost = cost;
+            hasTarget = true;
+            target = transform;
+            targetWidth = width;
+        }
+    }
+
+    if (!hasTarget) {
+        // 没有目标时原地起跳，等待新平台进入范围
+        if (player.isOnGround() && jumpCooldown <= 0) {
+            player.jump();
+            jumpCooldown = 0.3f;
+        }
+        return;
+    }
+
+    float targetCenterX = target.x + targetWidth / 2;
+    float dx = targetCenterX - playerCenterX;
+    if (dx > 10.0f) {
+        player.moveRight();
+    }
+    else if (dx < -10.0f) {
+        player.moveLeft();
+    }
+
+    bool aligned = std::abs(dx) < targetWidth / 2 + 60.0f;
+    if (player.isOnGround() && aligned && jumpCooldown <= 0) {
+        player.jump();
+        jumpCooldown = 0.2f;
+    }
+    else if (!player.isOnGround() && player.getVY() > 0 &&
+        playerBottom > target.y + 10.0f && jumpCooldown <= 0) {
+        // 下落且已低于目标平台：使用剩余的空中跳跃
+        player.jump();
+        jumpCooldown = 0.3f;
+    }
+}
+
+void BotPolicy::act(Game& game, float deltaTime) {
+    game.injectInput(bot.think(game, deltaTime));
+}
+
+std::unique_ptr<SimPolicy> createSimPolicy(const std::string& name) {
+    if (name == "scripted") {
+        return std::make_unique<ScriptedPolicy>();
+    }
+    if (name == "greedy") {
+        return std::make_unique<GreedyPolicy>();
+    }
+    if (name == "bot") {
+        return std::make_unique<BotPolicy>();
+    }
+    return nullptr;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Bot.h"
+#include <memory>
+#include <string>
+
+class Game;
+
+// 无窗口模拟中代替键盘输入的玩家策略，每个tick在Game::updateGame之前调用
+class SimPolicy {
+public:
+    virtual ~SimPolicy() = default;
+    virtual void act(Game& game, float deltaTime) = 0;
+};
+
+// 固定脚本：定时跳跃，左右往返移动
+class ScriptedPolicy : public SimPolicy {
+private:
+    float timer;
+
+public:
+    ScriptedPolicy() : timer(0.0f) {}
+    void act(Game& game, float deltaTime) override;
+};
+
+// 贪心策略：选择上方可达范围内最近的平台，移动对齐后起跳，下落时用二段跳补救
+class GreedyPolicy : public SimPolicy {
+private:
+    float jumpCooldown;
+
+public:
+    GreedyPolicy() : jumpCooldown(0.0f) {}
+    void act(Game& game, float deltaTime) override;
+};
+
+// 自动玩家：前向模拟规划跳跃并躲避障碍物，通过InputFrame注入输入（与键盘输入走同一条路径）
+class BotPolicy : public SimPolicy {
+private:
+    Bot bot;
+
+public:
+    void act(Game& game, float deltaTime) override;
+};
+
+// 按名称创建策略（scripted / greedy / bot），未知名称返回nullptr
+std::unique_ptr<SimPolicy> createSimPolicy(const std::string& name);